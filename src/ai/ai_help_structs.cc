@@ -27,6 +27,7 @@
 #include "base/time_string.h"
 #include "logic/ai_dna_handler.h"
 #include "logic/map.h"
+#include "logic/mapregion.h"
 #include "logic/player.h"
 
 namespace AI {
@@ -472,6 +473,36 @@ int8_t Neuron::get_result_safe(int32_t pos, const bool absolute) {
 	return results[pos];
 }
 
+// The same as get_result_safe(), for 'count' inputs at once
+void Neuron::get_results_safe(const int32_t* positions,
+                              const size_t count,
+                              int8_t* out,
+                              const bool absolute) const {
+	constexpr int32_t kMaxPosition = kNeuronMaxPosition;
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = results[std::max(0, std::min(kMaxPosition, positions[i]))];
+	}
+	if (absolute) {
+		for (size_t i = 0; i < count; ++i) {
+			out[i] = static_cast<int8_t>(std::abs(out[i]));
+		}
+	}
+}
+
+void NeuronBatch::reset(const size_t size) {
+	inputs_.resize(size);
+	results_.resize(size);
+	sums_.assign(size, 0);
+}
+
+void NeuronBatch::add(const Neuron& neuron, const bool absolute, const int32_t divisor) {
+	assert(divisor != 0);
+	neuron.get_results_safe(inputs_.data(), inputs_.size(), results_.data(), absolute);
+	for (size_t i = 0; i < sums_.size(); ++i) {
+		sums_[i] += results_[i] / divisor;
+	}
+}
+
 // Setting the type of curve
 void Neuron::set_type(uint8_t new_type) {
 	assert(new_type < neuron_curves.size());
@@ -961,6 +992,167 @@ bool BlockedFields::is_blocked(Widelands::Coords coords) {
 	return (blocked_fields_.count(coords.hash()) != 0);
 }
 
+std::atomic<uint64_t> FieldFeatureGrid::lookups_{0U};
+std::atomic<uint64_t> FieldFeatureGrid::searches_{0U};
+std::atomic<uint64_t> FieldFeatureGrid::node_updates_{0U};
+
+void FieldFeatureGrid::init(const Widelands::Map& map) {
+	tiles_per_row_ = (map.get_width() + kTileSize - 1) / kTileSize;
+	const int16_t tile_rows = (map.get_height() + kTileSize - 1) / kTileSize;
+	counts_.resize(map.max_index());
+	known_per_tile_.resize(tiles_per_row_ * tile_rows);
+	forget_all();
+}
+
+void FieldFeatureGrid::update_hostility(const Widelands::EditorGameBase& egbase,
+                                        const Widelands::Player& player) {
+	bool changed = false;
+	for (Widelands::PlayerNumber pn = 1; pn <= egbase.map().get_nrplayers(); ++pn) {
+		if (const Widelands::Player* other_player = egbase.get_player(pn)) {
+			const bool hostile = player.is_hostile(*other_player);
+			changed |= hostile_[pn] != hostile;
+			hostile_[pn] = hostile;
+		}
+	}
+	if (changed) {
+		forget_all();
+	}
+}
+
+FieldFeatureGrid::Counts FieldFeatureGrid::get(const Widelands::Map& map,
+                                               const Widelands::FCoords& fc) {
+	lookups_.fetch_add(1U, std::memory_order_relaxed);
+	Counts& counts = counts_[map.get_index(fc)];
+	if (counts.unowned_land != kUnknown) {
+		return counts;
+	}
+
+	searches_.fetch_add(1U, std::memory_order_relaxed);
+	counts = Counts{0U, 0U};
+	Widelands::MapRegion<Widelands::Area<Widelands::FCoords>> mr(
+	   map, Widelands::Area<Widelands::FCoords>(fc, kRadius));
+	do {
+		if ((mr.location().field->maxcaps() & Widelands::MOVECAPS_WALK) == 0) {
+			continue;
+		}
+		switch (land_of(mr.location().field->get_owned_by())) {
+		case Land::kUnowned:
+			++counts.unowned_land;
+			break;
+		case Land::kEnemy:
+			++counts.enemy_owned_land;
+			break;
+		case Land::kOther:
+			break;
+		}
+	} while (mr.advance(map));
+	++known_per_tile_[tile_of(fc)];
+	++known_count_;
+	return counts;
+}
+
+void FieldFeatureGrid::field_possession_changed(const Widelands::Map& map,
+                                                const Widelands::NoteFieldPossession& note) {
+	if (known_count_ == 0U) {
+		return;
+	}
+	// A field that changes hands is lost by the old owner before the new one gains it, and a field
+	// that becomes neutral is only lost
+	const Land land = land_of(note.player->player_number());
+	if (note.ownership == Widelands::NoteFieldPossession::Ownership::LOST) {
+		change_land(map, note.fc, land, Land::kUnowned);
+	} else {
+		change_land(map, note.fc, Land::kUnowned, land);
+	}
+}
+
+FieldFeatureGrid::Statistics FieldFeatureGrid::statistics() {
+	return {lookups_.load(), searches_.load(), node_updates_.load()};
+}
+
+void FieldFeatureGrid::reset_statistics() {
+	lookups_ = 0U;
+	searches_ = 0U;
+	node_updates_ = 0U;
+}
+
+FieldFeatureGrid::Land FieldFeatureGrid::land_of(Widelands::PlayerNumber const owner) const {
+	if (owner == Widelands::neutral()) {
+		return Land::kUnowned;
+	}
+	return hostile_[owner] ? Land::kEnemy : Land::kOther;
+}
+
+uint32_t FieldFeatureGrid::tile_of(const Widelands::Coords& c) const {
+	return (c.y / kTileSize) * tiles_per_row_ + c.x / kTileSize;
+}
+
+bool FieldFeatureGrid::any_known_near(const Widelands::Map& map,
+                                      const Widelands::Coords& c) const {
+	// Collects the tile columns or rows that the wrapped range of +/- kRadius nodes touches
+	constexpr uint8_t kMaxTiles = 2 * kRadius / kTileSize + 3;
+	const auto tiles_along = [](int16_t const center, int16_t const size, int16_t* tiles) {
+		const int32_t length = std::min<int32_t>(2 * kRadius + 1, size);
+		const int32_t first = ((center - kRadius) % size + size) % size;
+		uint8_t nr_tiles = 0U;
+		for (int32_t i = 0; i < length; ++i) {
+			const int16_t tile = ((first + i) % size) / kTileSize;
+			if (nr_tiles == 0U || tiles[nr_tiles - 1] != tile) {
+				assert(nr_tiles < kMaxTiles);
+				tiles[nr_tiles++] = tile;
+			}
+		}
+		return nr_tiles;
+	};
+
+	int16_t columns[kMaxTiles];
+	int16_t rows[kMaxTiles];
+	const uint8_t nr_columns = tiles_along(c.x, map.get_width(), columns);
+	const uint8_t nr_rows = tiles_along(c.y, map.get_height(), rows);
+	for (uint8_t row = 0U; row < nr_rows; ++row) {
+		for (uint8_t column = 0U; column < nr_columns; ++column) {
+			if (known_per_tile_[rows[row] * tiles_per_row_ + columns[column]] != 0U) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void FieldFeatureGrid::change_land(const Widelands::Map& map,
+                                   const Widelands::FCoords& fc,
+                                   Land const from,
+                                   Land const to) {
+	if (from == to || (fc.field->maxcaps() & Widelands::MOVECAPS_WALK) == 0 ||
+	    !any_known_near(map, fc)) {
+		return;
+	}
+	const int16_t unowned_delta =
+	   static_cast<int16_t>(to == Land::kUnowned) - static_cast<int16_t>(from == Land::kUnowned);
+	const int16_t enemy_delta =
+	   static_cast<int16_t>(to == Land::kEnemy) - static_cast<int16_t>(from == Land::kEnemy);
+
+	// The area is symmetric, so these are all nodes whose area contains the changed one
+	uint64_t updates = 0U;
+	Widelands::MapRegion<Widelands::Area<Widelands::FCoords>> mr(
+	   map, Widelands::Area<Widelands::FCoords>(fc, kRadius));
+	do {
+		Counts& counts = counts_[map.get_index(mr.location())];
+		if (counts.unowned_land != kUnknown) {
+			counts.unowned_land = counts.unowned_land + unowned_delta;
+			counts.enemy_owned_land = counts.enemy_owned_land + enemy_delta;
+			++updates;
+		}
+	} while (mr.advance(map));
+	node_updates_.fetch_add(updates, std::memory_order_relaxed);
+}
+
+void FieldFeatureGrid::forget_all() {
+	std::fill(counts_.begin(), counts_.end(), Counts{kUnknown, 0U});
+	std::fill(known_per_tile_.begin(), known_per_tile_.end(), 0U);
+	known_count_ = 0U;
+}
+
 PlayersStrengths::PlayersStrengths() : update_time(0) {
 }
 
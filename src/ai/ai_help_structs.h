@@ -19,12 +19,14 @@
 #ifndef WL_AI_AI_HELP_STRUCTS_H
 #define WL_AI_AI_HELP_STRUCTS_H
 
+#include <atomic>
 #include <bitset>
 
 #include "ai/ai_hints.h"
 #include "economy/flag.h"
 #include "economy/road.h"
 #include "logic/ai_dna_handler.h"
+#include "logic/cookie_priority_queue.h"
 #include "logic/game.h"
 #include "logic/map.h"
 #include "logic/map_objects/checkstep.h"
@@ -694,6 +696,7 @@ struct Neuron {
 	}
 	int8_t get_result(size_t);
 	int8_t get_result_safe(int32_t, bool = false);
+	void get_results_safe(const int32_t* positions, size_t count, int8_t* out, bool = false) const;
 	void set_type(uint8_t);
 	[[nodiscard]] uint8_t get_type() const {
 		return type;
@@ -725,6 +728,30 @@ private:
 	uint16_t id;
 };
 
+// Evaluates neurons for many inputs at once, e.g. for all candidate fields of a decision. Inputs,
+// results and sums are kept in packed arrays, so every neuron is evaluated in one tight loop
+// instead of one call per field.
+struct NeuronBatch {
+	// Prepares the batch for 'size' inputs and clears the sums
+	void reset(size_t size);
+	[[nodiscard]] size_t size() const {
+		return sums_.size();
+	}
+	void set_input(size_t i, int32_t input) {
+		inputs_[i] = input;
+	}
+	// Adds the neuron's result for every input, divided by 'divisor', to the sums
+	void add(const Neuron&, bool absolute = false, int32_t divisor = 1);
+	[[nodiscard]] int32_t sum(size_t i) const {
+		return sums_[i];
+	}
+
+private:
+	std::vector<int32_t> inputs_;
+	std::vector<int8_t> results_;
+	std::vector<int32_t> sums_;
+};
+
 struct ExpansionType {
 	ExpansionType();
 
@@ -807,10 +834,23 @@ struct MilitarySiteSizeObserver {
 
 // this represents a scheduler task
 struct SchedulerTask {
+	// Orders the task queue by due time, ties are broken by the ID to keep the order well defined
+	struct DueEarlier {
+		bool operator()(const SchedulerTask& a, const SchedulerTask& b, Widelands::WareWorker) const {
+			return a.due_time < b.due_time || (a.due_time == b.due_time && a.id < b.id);
+		}
+	};
+	using Queue = CookiePriorityQueue<SchedulerTask, DueEarlier>;
+
 	SchedulerTask(const Time& time, SchedulerTaskId t, uint8_t p, const char* d);
 
 	bool operator<(const SchedulerTask& other) const;
 
+	// The type is meaningless here, the task queue has no ware/worker distinction
+	CookiePriorityQueueBase<SchedulerTask>::Cookie& cookie(Widelands::WareWorker /* type */) {
+		return cookie_;
+	}
+
 	Time due_time;
 	SchedulerTaskId id;
 	// used to sort jobs when AI has to perform more jobs at once
@@ -820,6 +860,9 @@ struct SchedulerTask {
 	uint32_t call_count;
 	double total_exec_time_ms;
 	double max_exec_time_ms;
+
+private:
+	CookiePriorityQueueBase<SchedulerTask>::Cookie cookie_;
 };
 
 // List of blocked fields with block time, with some accompanying functions
@@ -834,6 +877,62 @@ private:
 	std::map<uint32_t, Time> blocked_fields_;
 };
 
+// Count of unowned and of enemy owned walkable nodes within kRadius of a node. The counts of a
+// node are searched for when it is looked up first, afterwards they are kept up to date from
+// NoteFieldPossession, so revisiting a buildable field is a plain lookup.
+// Walkability is taken from the terrain only (maxcaps), as immovables do not send notes.
+struct FieldFeatureGrid {
+	static constexpr uint16_t kRadius = 16;
+
+	struct Counts {
+		uint16_t unowned_land;
+		uint16_t enemy_owned_land;
+	};
+
+	// Counters over all grids, for benchmarks
+	struct Statistics {
+		uint64_t lookups;
+		uint64_t searches;
+		uint64_t node_updates;
+	};
+
+	// Sizes the grid for the map and forgets all counts
+	void init(const Widelands::Map& map);
+	// Forgets all counts if the hostility of 'player' towards any other player changed. Teams can
+	// change at any time, so this is checked before each lookup.
+	void update_hostility(const Widelands::EditorGameBase& egbase, const Widelands::Player& player);
+	// Returns the counts for the node, searching its area if they are not known yet
+	Counts get(const Widelands::Map& map, const Widelands::FCoords& fc);
+	// Must see the notes for all players' fields
+	void field_possession_changed(const Widelands::Map& map,
+	                              const Widelands::NoteFieldPossession& note);
+
+	static Statistics statistics();
+	static void reset_statistics();
+
+private:
+	enum class Land : uint8_t { kUnowned, kEnemy, kOther };
+	static constexpr uint16_t kUnknown = std::numeric_limits<uint16_t>::max();
+	static constexpr int16_t kTileSize = 8;
+
+	[[nodiscard]] Land land_of(Widelands::PlayerNumber owner) const;
+	[[nodiscard]] uint32_t tile_of(const Widelands::Coords& c) const;
+	[[nodiscard]] bool any_known_near(const Widelands::Map& map, const Widelands::Coords& c) const;
+	void change_land(const Widelands::Map& map, const Widelands::FCoords& fc, Land from, Land to);
+	void forget_all();
+
+	std::vector<Counts> counts_;
+	// Number of nodes with known counts per tile, updates skip areas without any
+	std::vector<uint16_t> known_per_tile_;
+	uint32_t known_count_{0U};
+	int16_t tiles_per_row_{0};
+	std::bitset<kMaxPlayers + 1> hostile_;
+
+	static std::atomic<uint64_t> lookups_;
+	static std::atomic<uint64_t> searches_;
+	static std::atomic<uint64_t> node_updates_;
+};
+
 // This is a struct that stores strength of players, info on teams and provides some outputs from
 // these data
 struct PlayersStrengths {
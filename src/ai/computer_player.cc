@@ -18,7 +18,13 @@
 
 #include "ai/computer_player.h"
 
+#include <exception>
+
 #include "ai/defaultai.h"
+#include "base/parallel_for.h"
+#include "logic/game.h"
+#include "logic/pathfield.h"
+#include "logic/playercommand.h"
 
 namespace AI {
 
@@ -26,6 +32,49 @@ ComputerPlayer::ComputerPlayer(Widelands::Game& g, Widelands::PlayerNumber const
    : game_(g), player_number_(pid) {
 }
 
+void ComputerPlayer::think_all(const std::vector<ComputerPlayer*>& ais, bool const concurrently) {
+	std::vector<ComputerPlayer*> concurrent_ais;
+	for (ComputerPlayer* ai : ais) {
+		if (concurrently && ai->can_think_concurrently()) {
+			if (!ai->rng_seeded_) {
+				ai->rng_.seed(RNG::static_rand());
+				ai->rng_seeded_ = true;
+			}
+			concurrent_ais.push_back(ai);
+		} else {
+			ai->think();
+		}
+	}
+	if (concurrent_ais.empty()) {
+		return;
+	}
+
+	Widelands::Game& game = concurrent_ais.front()->game();
+	const uint32_t nrfields = game.map().max_index();
+	std::vector<std::vector<Widelands::PlayerCommand*>> commands(concurrent_ais.size());
+	try {
+		parallel_for(concurrent_ais.size(), [&concurrent_ais, &commands, nrfields](size_t i) {
+			Widelands::Game::ScopedCommandCollector collector(commands[i]);
+			RNG::ScopedStaticRNG rng(concurrent_ais[i]->rng_);
+			Widelands::PathfieldManager::ScopedThreadPathfields pathfields(nrfields);
+			concurrent_ais[i]->think();
+		});
+	} catch (const std::exception&) {
+		for (const std::vector<Widelands::PlayerCommand*>& list : commands) {
+			for (Widelands::PlayerCommand* pc : list) {
+				delete pc;
+			}
+		}
+		throw;
+	}
+
+	for (const std::vector<Widelands::PlayerCommand*>& list : commands) {
+		for (Widelands::PlayerCommand* pc : list) {
+			game.send_player_command(pc);
+		}
+	}
+}
+
 struct EmptyAI : ComputerPlayer {
 	EmptyAI(Widelands::Game& g, const Widelands::PlayerNumber pid) : ComputerPlayer(g, pid) {
 	}
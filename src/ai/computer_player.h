@@ -20,8 +20,10 @@
 #define WL_AI_COMPUTER_PLAYER_H
 
 #include <cassert>
+#include <vector>
 
 #include "base/macros.h"
+#include "base/random.h"
 #include "base/string.h"
 #include "logic/widelands.h"
 
@@ -51,6 +53,22 @@ struct ComputerPlayer {
 
 	virtual void think() = 0;
 
+	/// Whether think() may run on another thread, at the same time as other AIs.
+	/// It must then only read the game state and change it through player commands.
+	[[nodiscard]] virtual bool can_think_concurrently() const {
+		return false;
+	}
+
+	/**
+	 * Lets all the given AIs think. With \p concurrently, the AIs that can think
+	 * concurrently do so on the threads of parallel_for() while the game logic
+	 * waits. Each of them draws from its own random number generator, and its
+	 * player commands are held back and sent afterwards in the order of \p ais,
+	 * so that the commands do not depend on how the threads were scheduled.
+	 * The other AIs think one after another before that.
+	 */
+	static void think_all(const std::vector<ComputerPlayer*>& ais, bool concurrently);
+
 	[[nodiscard]] Widelands::Game& game() const {
 		return game_;
 	}
@@ -100,6 +118,10 @@ private:
 	Widelands::Game& game_;
 	Widelands::PlayerNumber const player_number_;
 
+	// Replaces the static random number generator while thinking concurrently
+	RNG rng_;
+	bool rng_seeded_{false};
+
 	DISALLOW_COPY_AND_ASSIGN(ComputerPlayer);
 };
 }  // namespace AI
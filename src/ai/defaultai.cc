@@ -26,6 +26,7 @@
 #include "ai/ai_hints.h"
 #include "base/log.h"
 #include "base/macros.h"
+#include "base/simulation_profiler.h"
 #include "base/time_string.h"
 #include "base/wexception.h"
 #include "economy/flag.h"
@@ -82,6 +83,7 @@ DefaultAI::DefaultAI(Widelands::Game& ggame, Widelands::PlayerNumber const pid,
 	// Subscribe to NoteFieldPossession.
 	field_possession_subscriber_ = Notifications::subscribe<Widelands::NoteFieldPossession>(
 	   [this](const Widelands::NoteFieldPossession& note) {
+		   field_features.field_possession_changed(game().map(), note);
 		   if (note.player != player_) {
 			   return;
 		   }
@@ -220,6 +222,17 @@ DefaultAI::~DefaultAI() {
 	}
 }
 
+/**
+ * The initialization subscribes to notes, and picking a starting position,
+ * adjusting the game speed and writing the DNA files of the training mode
+ * have effects beyond player commands. AIs that might do any of these think
+ * on the logic thread.
+ */
+bool DefaultAI::can_think_concurrently() const {
+	return tribe_ != nullptr && !player_->is_picking_custom_starting_position() &&
+	       !game().is_auto_speed() && !game().is_ai_training_mode();
+}
+
 /**
  * Main loop of computer player_ "defaultAI"
  *
@@ -254,9 +267,7 @@ void DefaultAI::think() {
 
 	SchedulerTaskId due_task = SchedulerTaskId::kUnset;
 
-	sort_task_pool();
-
-	const int32_t delay_time = gametime.get() - taskPool.front()->due_time.get();
+	const int32_t delay_time = gametime.get() - task_queue_.top()->due_time.get();
 
 	/// This portion of code keeps the speed of game to ensure AI tasks
 	// being on time, this is used for training of AI
@@ -312,16 +323,15 @@ void DefaultAI::think() {
 
 	// Pool of tasks to be executed this run. In ideal situation it will consist of one task only.
 	current_task_queue.clear();
-	// Here we push SchedulerTask members into the temporary queue, providing that a task is due now
-	// and
-	// the limit (jobs_to_run_count) is not exceeded
-	for (uint8_t i = 0; i < jobs_to_run_count; ++i) {
-		if (taskPool[i]->due_time <= gametime) {
-			current_task_queue.push_back(taskPool[i]);
-			sort_task_pool();
-		} else {
-			break;
-		}
+	// Here we take the earliest tasks off the queue, providing that a task is due now and the limit
+	// (jobs_to_run_count) is not exceeded. They are put back right away, their jobs reschedule them.
+	while (current_task_queue.size() < jobs_to_run_count &&
+	       task_queue_.top()->due_time <= gametime) {
+		current_task_queue.push_back(task_queue_.top());
+		task_queue_.pop(current_task_queue.back());
+	}
+	for (SchedulerTask* task : current_task_queue) {
+		task_queue_.push(task);
 	}
 	assert(!current_task_queue.empty() && current_task_queue.size() <= jobs_to_run_count);
 
@@ -332,10 +342,11 @@ void DefaultAI::think() {
 	}
 
 	// Ordering temporary queue so that higher priority (lower number) is on the beginning
-	std::sort(current_task_queue.begin(), current_task_queue.end());
+	std::sort(current_task_queue.begin(), current_task_queue.end(),
+	          [](const SchedulerTask* a, const SchedulerTask* b) { return *a < *b; });
 
 	// Performing tasks from temporary queue one by one
-	for (const auto& task : current_task_queue) {
+	for (SchedulerTask* task : current_task_queue) {
 
 		due_task = task->id;
 
@@ -344,6 +355,11 @@ void DefaultAI::think() {
 		if (kCollectPerfData) {
 			time_point = std::chrono::high_resolution_clock::now();
 		}
+		const bool profile_task = SimulationProfiler::is_enabled();
+		std::chrono::steady_clock::time_point task_start;
+		if (profile_task) {
+			task_start = std::chrono::steady_clock::now();
+		}
 
 		// Now AI runs a job selected above to be performed in this turn
 		// (only one but some of them needs to run check_economies() to
@@ -561,6 +577,13 @@ void DefaultAI::think() {
 				task->max_exec_time_ms = exec_time;
 			}
 		}
+		if (profile_task) {
+			static_assert(static_cast<unsigned>(SchedulerTaskId::kUnset) <
+			                 SimulationProfiler::kNumberOfAiTaskTypes,
+			              "Too many AI tasks for the profiler");
+			SimulationProfiler::add_ai_task(
+			   static_cast<uint8_t>(due_task), SimulationProfiler::elapsed_since(task_start));
+		}
 	}
 }
 
@@ -1160,6 +1183,9 @@ void DefaultAI::late_initialization() {
 		      Time((10 + RNG::static_rand(10)) * 60 * 1000)),
 		   SchedulerTaskId::kDiplomacy, 7, "diplomacy actions"));
 	}
+	for (const auto& task : taskPool) {
+		task_queue_.push(task.get());
+	}
 
 	const Widelands::Map& map = game().map();
 
@@ -1184,6 +1210,8 @@ void DefaultAI::late_initialization() {
 		}
 	}
 
+	field_features.init(map);
+
 	// here we scan entire map for owned unused fields and own buildings
 	std::set<Widelands::OPtr<Widelands::PlayerImmovable>> found_immovables;
 	for (int16_t y = 0; y < map.get_height(); ++y) {
@@ -1549,7 +1577,7 @@ void DefaultAI::update_buildable_field(BuildableField& field) {
 
 	constexpr uint16_t kProductionArea = 6;
 	constexpr uint16_t kBuildableSpotsCheckArea = 10;
-	constexpr uint16_t kEnemyCheckArea = 16;
+	constexpr uint16_t kEnemyCheckArea = FieldFeatureGrid::kRadius;
 	const uint16_t ms_enemy_check_area =
 	   kEnemyCheckArea + std::abs(management_data.get_military_number_at(75)) / 10;
 	constexpr uint16_t kDistantResourcesArea = 20;
@@ -1564,13 +1592,21 @@ void DefaultAI::update_buildable_field(BuildableField& field) {
 		}
 	}
 
-	field.unowned_land_nearby = map.find_fields(
-	   game(), Widelands::Area<Widelands::FCoords>(field.coords, actual_enemy_check_area), nullptr,
-	   find_unowned_walkable);
+	if (field.is_militarysite) {
+		field.unowned_land_nearby = map.find_fields(
+		   game(), Widelands::Area<Widelands::FCoords>(field.coords, actual_enemy_check_area),
+		   nullptr, find_unowned_walkable);
 
-	field.enemy_owned_land_nearby = map.find_fields(
-	   game(), Widelands::Area<Widelands::FCoords>(field.coords, actual_enemy_check_area), nullptr,
-	   find_enemy_owned_walkable);
+		field.enemy_owned_land_nearby = map.find_fields(
+		   game(), Widelands::Area<Widelands::FCoords>(field.coords, actual_enemy_check_area),
+		   nullptr, find_enemy_owned_walkable);
+	} else {
+		// The usual area is kept up to date from the ownership notes
+		field_features.update_hostility(game(), *player_);
+		const FieldFeatureGrid::Counts land = field_features.get(map, field.coords);
+		field.unowned_land_nearby = land.unowned_land;
+		field.enemy_owned_land_nearby = land.enemy_owned_land;
+	}
 
 	field.nearest_buildable_spot_nearby = std::numeric_limits<uint16_t>::max();
 	field.unowned_buildable_spots_nearby = 0;
@@ -1621,7 +1657,7 @@ void DefaultAI::update_buildable_field(BuildableField& field) {
 	                    find_unowned_walkable) > 0);
 
 	// are we going to count resources now?
-	static bool resource_count_now = false;
+	thread_local bool resource_count_now = false;
 	resource_count_now = false;
 	// Testing in first 10 seconds or if last testing was more then 60 sec ago
 	if (field.last_resources_check_time < Time(10000) ||
@@ -1753,7 +1789,7 @@ void DefaultAI::update_buildable_field(BuildableField& field) {
 	if (field.water_nearby > 0 &&
 	    (field.fish_nearby == kUncalculated || (resource_count_now && gametime.get() % 10 == 0))) {
 		Widelands::CheckStepWalkOn fisher_cstep(Widelands::MOVECAPS_WALK, true);
-		static std::vector<Widelands::Coords> fish_fields_list;  // pity this contains duplicates
+		thread_local std::vector<Widelands::Coords> fish_fields_list;  // pity this contains duplicates
 		fish_fields_list.clear();
 		map.find_reachable_fields(
 		   game(), Widelands::Area<Widelands::FCoords>(field.coords, kProductionArea),
@@ -1761,7 +1797,7 @@ void DefaultAI::update_buildable_field(BuildableField& field) {
 		   Widelands::FindNodeResource(descriptions.resource_index("resource_fish")));
 
 		// This is "list" of unique fields in fish_fields_list we got above
-		static std::set<Widelands::Coords> counted_fields;
+		thread_local std::set<Widelands::Coords> counted_fields;
 		counted_fields.clear();
 		field.fish_nearby = 0;
 		for (auto fish_coords : fish_fields_list) {
@@ -1848,7 +1884,7 @@ void DefaultAI::update_buildable_field(BuildableField& field) {
 
 	// collect information about productionsites nearby
 	// We are interested in unconnected immovables
-	static bool any_imm_not_connected_to_wh = false;
+	thread_local bool any_imm_not_connected_to_wh = false;
 	any_imm_not_connected_to_wh = false;
 
 	// immovables can occupy more then one field so we need a safeguard for duplicates
@@ -2222,7 +2258,7 @@ void DefaultAI::update_buildable_field(BuildableField& field) {
 
 	// is new site allowed at all here?
 	field.defense_msite_allowed = false;
-	static int16_t multiplicator = 10;
+	thread_local int16_t multiplicator = 10;
 	multiplicator = 10;
 	if (soldier_status_ == SoldiersStatus::kBadShortage) {
 		multiplicator = 4;
@@ -2445,20 +2481,39 @@ bool DefaultAI::construct_building(const Time& gametime) {
 	// Calculating needness of individual types of buidings (bo.new_building)
 	pre_calculating_needness_of_buildings(gametime);
 
-	static uint32_t consumers_nearby_count = 0;
+	thread_local uint32_t consumers_nearby_count = 0;
 	consumers_nearby_count = 0;
 
-	static uint16_t concurent_ms_in_constr_no_enemy = 1;
+	thread_local uint16_t concurent_ms_in_constr_no_enemy = 1;
 	concurent_ms_in_constr_no_enemy = 1;
-	static uint16_t concurent_ms_in_constr_enemy_nearby = 2;
+	thread_local uint16_t concurent_ms_in_constr_enemy_nearby = 2;
 	concurent_ms_in_constr_enemy_nearby = 2;
 
 	BuildingObserver* best_building = nullptr;
 	int32_t proposed_priority = 0;
 	Widelands::Coords proposed_coords;
 
+	// The neurons that only depend on the field are evaluated for all fields at once
+	// Some buildings needs to consider distance from nearest warehouse
+	// It is non-negative value, and should be deducted from prio for some productionsites
+	thread_local NeuronBatch wh_distance_malus_batch;
+	thread_local NeuronBatch military_score_batch;
+	wh_distance_malus_batch.reset(buildable_fields.size());
+	military_score_batch.reset(buildable_fields.size());
+	for (size_t i = 0; i < buildable_fields.size(); ++i) {
+		wh_distance_malus_batch.set_input(i, buildable_fields[i]->average_flag_dist_to_wh);
+		military_score_batch.set_input(i, buildable_fields[i]->military_score_ / 20);
+	}
+	wh_distance_malus_batch.add(management_data.neuron_pool[35], kAbsValue);
+	military_score_batch.add(management_data.neuron_pool[44], false, 5);
+	for (size_t i = 0; i < buildable_fields.size(); ++i) {
+		wh_distance_malus_batch.set_input(i, buildable_fields[i]->average_flag_dist_to_wh / 3);
+	}
+	wh_distance_malus_batch.add(management_data.neuron_pool[42], kAbsValue);
+
 	// first scan all buildable fields for regular buildings
-	for (BuildableField* const bf : buildable_fields) {
+	for (size_t field_index = 0; field_index < buildable_fields.size(); ++field_index) {
+		BuildableField* const bf = buildable_fields[field_index];
 		if (bf->field_info_expiration < gametime) {
 			continue;
 		}
@@ -2471,12 +2526,7 @@ bool DefaultAI::construct_building(const Time& gametime) {
 		assert(player_);
 		int32_t const maxsize = player_->get_buildcaps(bf->coords) & Widelands::BUILDCAPS_SIZEMASK;
 
-		// Some buildings needs to consider distance from nearest warehouse
-		// It is non-negative value, and should be deducted from prio for some productionsites
-		const int32_t wh_distance_malus =
-		   management_data.neuron_pool[35].get_result_safe(bf->average_flag_dist_to_wh, kAbsValue) +
-		   management_data.neuron_pool[42].get_result_safe(
-		      bf->average_flag_dist_to_wh / 3, kAbsValue);
+		const int32_t wh_distance_malus = wh_distance_malus_batch.sum(field_index);
 		verb_log_dbg_time(gametime, "[AI %u] wh distance malus: %3d [dist to wh: %3d]\n",
 		                  player_number(), wh_distance_malus, bf->average_flag_dist_to_wh);
 
@@ -2539,7 +2589,7 @@ bool DefaultAI::construct_building(const Time& gametime) {
 
 			if (bo.type == BuildingObserver::Type::kProductionsite) {
 
-				prio += management_data.neuron_pool[44].get_result_safe(bf->military_score_ / 20) / 5;
+				prio += military_score_batch.sum(field_index);
 
 				// Some productionsites strictly require supporting sites nearby
 				uint8_t number_of_supporters_nearby = 0;
@@ -5149,7 +5199,8 @@ BuildingNecessity DefaultAI::check_building_necessity(BuildingObserver& bo,
 	const bool map_allows_seafaring = game().map().allows_seafaring();
 	bo.primary_priority = 0;
 
-	static BasicEconomyBuildingStatus site_needed_for_economy = BasicEconomyBuildingStatus::kNone;
+	thread_local BasicEconomyBuildingStatus site_needed_for_economy =
+	   BasicEconomyBuildingStatus::kNone;
 	site_needed_for_economy = BasicEconomyBuildingStatus::kNone;
 	if (gametime > Time(2 * 60 * 1000) && gametime < Time(120 * 60 * 1000) &&
 	    !basic_economy_established) {
@@ -5407,7 +5458,7 @@ BuildingNecessity DefaultAI::check_building_necessity(BuildingObserver& bo,
 				return BuildingNecessity::kForbidden;
 			}
 
-			static int16_t inputs[kFNeuronBitSize] = {0};
+			thread_local int16_t inputs[kFNeuronBitSize] = {0};
 			// Resetting values as the variable is static
 			std::fill(std::begin(inputs), std::end(inputs), 0);
 			inputs[0] = (bo.max_needed_preciousness == 0) ? -1 : 0;
@@ -5527,9 +5578,9 @@ BuildingNecessity DefaultAI::check_building_necessity(BuildingObserver& bo,
 			}
 
 			// genetic algorithm to decide whether new rangers are needed
-			static int16_t tmp_target = 2;
+			thread_local int16_t tmp_target = 2;
 			tmp_target = 2;
-			static int16_t inputs[2 * kFNeuronBitSize] = {0};
+			thread_local int16_t inputs[2 * kFNeuronBitSize] = {0};
 			// Resetting values as the variable is static
 			std::fill(std::begin(inputs), std::end(inputs), 0);
 
@@ -5780,7 +5831,7 @@ BuildingNecessity DefaultAI::check_building_necessity(BuildingObserver& bo,
 				return BuildingNecessity::kForbidden;
 			}
 
-			static int16_t inputs[kFNeuronBitSize] = {0};
+			thread_local int16_t inputs[kFNeuronBitSize] = {0};
 			// Resetting values as the variable is static
 			std::fill(std::begin(inputs), std::end(inputs), 0);
 			inputs[0] = (gametime < Time(15 * 60 * 1000)) ? -2 : 0;
@@ -5848,7 +5899,7 @@ BuildingNecessity DefaultAI::check_building_necessity(BuildingObserver& bo,
 			const int32_t stocked_wood_level = calculate_stocklevel(tribe_->safe_ware_index("log")) -
 			                                   productionsites.size() * 2 - numof_psites_in_constr +
 			                                   management_data.get_military_number_at(187) / 5;
-			static int16_t inputs[4 * kFNeuronBitSize] = {0};
+			thread_local int16_t inputs[4 * kFNeuronBitSize] = {0};
 			// Resetting values as the variable is static
 			std::fill(std::begin(inputs), std::end(inputs), 0);
 			inputs[0] = (bo.total_count() <= 1) ?
@@ -7360,7 +7411,13 @@ void DefaultAI::set_taskpool_task_time(const Time& gametime, const SchedulerTask
 
 	for (auto& item : taskPool) {
 		if (item->id == task) {
+			const bool earlier = gametime < item->due_time;
 			item->due_time = gametime;
+			if (earlier) {
+				task_queue_.decrease_key(item.get());
+			} else {
+				task_queue_.increase_key(item.get());
+			}
 			return;
 		}
 	}
@@ -7378,17 +7435,6 @@ const Time& DefaultAI::get_taskpool_task_time(const SchedulerTaskId task) {
 	throw wexception("AI internal error: nonexistent task.");
 }
 
-// This performs one "iteration" of sorting based on due_time
-// We by design do not need full sorting...
-void DefaultAI::sort_task_pool() {
-	assert(taskPool.size() >= 2);
-	for (int8_t i = taskPool.size() - 1; i > 0; --i) {
-		if (taskPool[i - 1]->due_time > taskPool[i]->due_time) {
-			std::iter_swap(taskPool.begin() + i - 1, taskPool.begin() + i);
-		}
-	}
-}
-
 // following two functions count mines of the same type (same output,
 // all levels)
 uint32_t DefaultAI::mines_in_constr() const {
@@ -7698,7 +7744,7 @@ void DefaultAI::calculate_target_m_score(const Time& gametime) {
 	// the proportion depends on size of economy
 	// this proportion defines how dense the buildings will be
 	// it is degressive (allows high density on the beginning)
-	static int32_t needed_spots = 0;
+	thread_local int32_t needed_spots = 0;
 	if (productionsites.size() < 50) {
 		needed_spots = productionsites.size();
 	} else if (productionsites.size() < 100) {
@@ -7711,7 +7757,7 @@ void DefaultAI::calculate_target_m_score(const Time& gametime) {
 	const bool has_enough_space = (spots_ > needed_spots);
 
 	// Genetic algorithm is used here
-	static bool inputs[2 * kFNeuronBitSize] = {false};
+	thread_local bool inputs[2 * kFNeuronBitSize] = {false};
 	// Resetting values as the variable is static
 	std::fill(std::begin(inputs), std::end(inputs), false);
 	inputs[0] = (pow(msites_in_constr(), 2) > militarysites.size() + 2);
@@ -7806,9 +7852,9 @@ void DefaultAI::calculate_target_m_score(const Time& gametime) {
 	inputs[57] = (mine_fields_stat.has_critical_ore_fields());
 	inputs[58] = (!mine_fields_stat.has_critical_ore_fields());
 
-	static int16_t needs_boost_economy_score = management_data.get_military_number_at(61) / 5;
+	thread_local int16_t needs_boost_economy_score = management_data.get_military_number_at(61) / 5;
 	needs_boost_economy_score = management_data.get_military_number_at(61) / 5;
-	static int16_t increase_score_limit_score = 0;
+	thread_local int16_t increase_score_limit_score = 0;
 	increase_score_limit_score = 0;
 
 	for (uint8_t i = 0; i < kFNeuronBitSize; ++i) {
@@ -75,6 +75,7 @@ struct DefaultAI : ComputerPlayer {
 	DefaultAI(Widelands::Game&, Widelands::PlayerNumber, AiType);
 	~DefaultAI() override;
 	void think() override;
+	[[nodiscard]] bool can_think_concurrently() const override;
 
 	enum class WalkSearch : uint8_t { kAnyPlayer, kOtherPlayers, kEnemy };
 	enum class WoodPolicy : uint8_t { kDismantleRangers, kStopRangers, kAllowRangers };
@@ -222,7 +223,6 @@ private:
 	BuildingNecessity
 	check_building_necessity(BuildingObserver& bo, PerfEvaluation purpose, const Time&);
 	BuildingNecessity check_warehouse_necessity(BuildingObserver&, const Time& gametime);
-	void sort_task_pool();
 	void set_taskpool_task_time(const Time&, SchedulerTaskId);
 	const Time& get_taskpool_task_time(SchedulerTaskId);
 	std::chrono::high_resolution_clock::time_point time_point;
@@ -342,6 +342,7 @@ private:
 	std::deque<Widelands::FCoords> unusable_fields;
 	std::deque<BuildableField*> buildable_fields;
 	BlockedFields blocked_fields;
+	FieldFeatureGrid field_features;
 	std::unordered_set<uint32_t> ports_vicinity;
 	std::unordered_set<uint32_t> ports_shipyard_region;
 	PlayersStrengths player_statistics;
@@ -362,7 +363,9 @@ private:
 	// This is a vector that is filled up on initiatlization
 	// and no items are added/removed afterwards
 	std::vector<std::shared_ptr<SchedulerTask>> taskPool;
-	std::vector<std::shared_ptr<SchedulerTask>> current_task_queue;
+	// All tasks of taskPool, ordered by due time. Must be destroyed before them.
+	SchedulerTask::Queue task_queue_{Widelands::wwWORKER};
+	std::vector<SchedulerTask*> current_task_queue;
 	std::map<uint32_t, EnemySiteObserver> enemy_sites;
 	std::set<uint32_t> enemy_warehouses;
 	// it will map mined material to observer
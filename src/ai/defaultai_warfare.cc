@@ -60,7 +60,7 @@ bool DefaultAI::check_enemy_sites(const Time& gametime) {
 		Widelands::FCoords f = map.get_fcoords(ms->get_position());
 
 		// get list of immovable around this our military site
-		static std::vector<Widelands::ImmovableFound> immovables;
+		thread_local std::vector<Widelands::ImmovableFound> immovables;
 		immovables.clear();
 		immovables.reserve(40);
 		map.find_immovables(
@@ -101,7 +101,7 @@ bool DefaultAI::check_enemy_sites(const Time& gametime) {
 	uint8_t best_score = 0;
 	uint32_t count = 0;
 	// sites that were either conquered or destroyed
-	static std::vector<uint32_t> disappeared_sites;
+	thread_local std::vector<uint32_t> disappeared_sites;
 	disappeared_sites.clear();
 	disappeared_sites.reserve(6);
 
@@ -268,10 +268,10 @@ bool DefaultAI::check_enemy_sites(const Time& gametime) {
 					                   player_statistics.get_old60_player_land(pn);
 				}
 
-				static std::vector<Widelands::ImmovableFound> immovables;
+				thread_local std::vector<Widelands::ImmovableFound> immovables;
 				immovables.reserve(50);
 				immovables.clear();
-				static std::set<uint32_t> unique_serials;
+				thread_local std::set<uint32_t> unique_serials;
 				unique_serials.clear();
 				// find militarysites near our target (radius 10) to check enemies power in region
 				map.find_immovables(game(),
@@ -311,7 +311,7 @@ bool DefaultAI::check_enemy_sites(const Time& gametime) {
 				observer.second.enemy_military_presence_in_region = enemy_military_presence_in_region_;
 				observer.second.enemy_military_sites_in_region = enemy_military_sites_in_region_;
 
-				static int16_t inputs[4 * kFNeuronBitSize] = {0};
+				thread_local int16_t inputs[4 * kFNeuronBitSize] = {0};
 				// Resetting values as the variable is static
 				std::fill(std::begin(inputs), std::end(inputs), 0);
 				inputs[0] =
@@ -1215,7 +1215,7 @@ BuildingNecessity DefaultAI::check_building_necessity(BuildingObserver& bo, cons
 	                                   productionsites.size() * 2 - numof_psites_in_constr +
 	                                   management_data.get_military_number_at(90) / 5;
 
-	static int32_t inputs[4 * kFNeuronBitSize] = {0};
+	thread_local int32_t inputs[4 * kFNeuronBitSize] = {0};
 	// Resetting values as the variable is static
 	std::fill(std::begin(inputs), std::end(inputs), 0);
 	inputs[0] = (msites_total < 1) ? 1 : 0;
@@ -217,4 +217,30 @@ TESTCASE(flag_has_candidate) {
 	check_equal(fc.has_candidate(3), false);
 }
 
+TESTCASE(scheduler_task_queue_order) {
+	AI::SchedulerTask roads(Time(3000), AI::SchedulerTaskId::kRoadCheck, 2, "roads check");
+	AI::SchedulerTask mines(Time(1000), AI::SchedulerTaskId::kCheckMines, 5, "check mines");
+	AI::SchedulerTask stats(Time(2000), AI::SchedulerTaskId::kUpdateStats, 6, "update stats");
+	AI::SchedulerTask::Queue queue(Widelands::wwWORKER);
+	queue.push(&roads);
+	queue.push(&mines);
+	queue.push(&stats);
+	check_equal(queue.top(), &mines);
+
+	// A job reschedules its task
+	mines.due_time = Time(5000);
+	queue.increase_key(&mines);
+	check_equal(queue.top(), &stats);
+
+	// Equal due times are ordered by ID
+	roads.due_time = Time(2000);
+	queue.decrease_key(&roads);
+	check_equal(queue.top(), &roads);
+	queue.pop(&roads);
+	check_equal(queue.top(), &stats);
+	queue.pop(&stats);
+	check_equal(queue.top(), &mines);
+	check_equal(queue.size(), 1U);
+}
+
 TESTSUITE_END()
@@ -43,6 +43,25 @@ TESTCASE(neuron_updated_weight) {
 	check_equal(n1.get_result_safe(100), 50);
 }
 
+// AI::NeuronBatch adds up the results of several neurons for many inputs at once
+TESTCASE(neuron_batch) {
+	AI::Neuron n1 = AI::Neuron(-50, 0, 0);
+	AI::Neuron n2 = AI::Neuron(30, 1, 1);
+	const std::vector<int32_t> inputs = {-5, 0, 7, 10, 20, 100};
+	AI::NeuronBatch batch;
+	batch.reset(inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i) {
+		batch.set_input(i, inputs[i]);
+	}
+	batch.add(n1, true);
+	batch.add(n2, false, 3);
+	check_equal(batch.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i) {
+		check_equal(batch.sum(i),
+		            n1.get_result_safe(inputs[i], true) + n2.get_result_safe(inputs[i]) / 3);
+	}
+}
+
 // AI::FNeuron is uint32_t that serves as 32 bools, that can be set and get independently
 TESTCASE(fneuron_position) {
 	AI::FNeuron fn = AI::FNeuron(0, 0);
@@ -66,7 +66,7 @@ void set_initializer_thread() {
 	initializer_thread = std::this_thread::get_id();
 }
 
-void set_logic_thread() {
+void set_logic_thread(const bool may_be_initializer_thread) {
 	verb_log_info("Setting logic thread.");
 
 	if (initializer_thread == kNoThread) {
@@ -75,7 +75,7 @@ void set_logic_thread() {
 	if (logic_thread != kNoThread) {
 		throw wexception("attempt to set logic thread again");
 	}
-	if (is_initializer_thread()) {
+	if (is_initializer_thread() && !may_be_initializer_thread) {
 		throw wexception("initializer thread can not be the logic thread");
 	}
 
@@ -33,8 +33,9 @@
 void set_initializer_thread();
 // Whether the current thread is the same that called `set_initializer_thread()` on startup
 bool is_initializer_thread();
-// Same for the game logic thread
-void set_logic_thread();
+// Same for the game logic thread. Only programs without a user interface may
+// run the game logic on the initializer thread.
+void set_logic_thread(bool may_be_initializer_thread = false);
 bool is_logic_thread();
 
 /*
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "base/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Workers beyond this number hardly help with the small loops in the game logic
+constexpr unsigned kMaxWorkerThreads = 15;
+
+// Set in the pool's worker threads and while a thread is running a parallel loop
+thread_local bool in_parallel_for = false;
+
+class ThreadPool {
+public:
+	explicit ThreadPool(unsigned nr_workers) {
+		workers_.reserve(nr_workers);
+		for (unsigned i = 0; i < nr_workers; ++i) {
+			workers_.emplace_back([this]() { work(); });
+		}
+	}
+
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		wake_.notify_all();
+		for (std::thread& worker : workers_) {
+			worker.join();
+		}
+	}
+
+	[[nodiscard]] std::size_t concurrency() const {
+		return workers_.size() + 1;
+	}
+
+	/// Returns false without doing anything if the pool is busy with another loop.
+	bool run(std::size_t count, const std::function<void(std::size_t)>& fn) {
+		std::unique_lock<std::mutex> run_lock(run_mutex_, std::try_to_lock);
+		if (!run_lock.owns_lock()) {
+			return false;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			job_ = &fn;
+			count_ = count;
+			next_ = 0;
+			error_ = nullptr;
+			++generation_;
+		}
+		wake_.notify_all();
+
+		in_parallel_for = true;
+		process(fn, count);
+		in_parallel_for = false;
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		// All indices have been claimed now, so wait for the workers that are still busy
+		done_.wait(lock, [this]() { return busy_ == 0; });
+		job_ = nullptr;
+		if (error_) {
+			std::exception_ptr error = error_;
+			error_ = nullptr;
+			std::rethrow_exception(error);
+		}
+		return true;
+	}
+
+private:
+	void work() {
+		in_parallel_for = true;
+		uint64_t seen_generation = 0;
+		std::unique_lock<std::mutex> lock(mutex_);
+		for (;;) {
+			wake_.wait(lock, [this, &seen_generation]() {
+				return stop_ || generation_ != seen_generation;
+			});
+			if (stop_) {
+				return;
+			}
+			seen_generation = generation_;
+			if (job_ == nullptr) {
+				// We woke up too late, the job has been finished without us
+				continue;
+			}
+			const std::function<void(std::size_t)>& fn = *job_;
+			const std::size_t count = count_;
+			++busy_;
+			lock.unlock();
+			process(fn, count);
+			lock.lock();
+			if (--busy_ == 0) {
+				done_.notify_all();
+			}
+		}
+	}
+
+	void process(const std::function<void(std::size_t)>& fn, std::size_t count) {
+		for (std::size_t i = next_++; i < count; i = next_++) {
+			try {
+				fn(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(mutex_);
+				if (!error_) {
+					error_ = std::current_exception();
+				}
+				next_ = count;
+			}
+		}
+	}
+
+	std::mutex run_mutex_;  ///< Held by the thread whose loop is running
+	std::mutex mutex_;      ///< Protects the job description below
+	std::condition_variable wake_;
+	std::condition_variable done_;
+	std::vector<std::thread> workers_;
+
+	const std::function<void(std::size_t)>* job_{nullptr};
+	std::size_t count_{0};
+	std::atomic<std::size_t> next_{0};
+	std::size_t busy_{0};
+	uint64_t generation_{0};
+	std::exception_ptr error_;
+	bool stop_{false};
+};
+
+ThreadPool& thread_pool() {
+	static ThreadPool pool(
+	   std::min(std::max(std::thread::hardware_concurrency(), 1U) - 1, kMaxWorkerThreads));
+	return pool;
+}
+
+}  // namespace
+
+void parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn) {
+	if (count > 1 && !in_parallel_for) {
+		ThreadPool& pool = thread_pool();
+		if (pool.concurrency() > 1 && pool.run(count, fn)) {
+			return;
+		}
+	}
+	for (std::size_t i = 0; i < count; ++i) {
+		fn(i);
+	}
+}
+
+std::size_t parallel_for_concurrency() {
+	return thread_pool().concurrency();
+}
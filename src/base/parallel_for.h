@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WL_BASE_PARALLEL_FOR_H
+#define WL_BASE_PARALLEL_FOR_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * Calls 'fn(i)' for every i in [0, count) and returns when all calls have finished.
+ *
+ * The calls are spread over a shared pool of worker threads, and the calling thread
+ * helps out. The order in which the indices are processed is unspecified, so the
+ * results must not depend on it. If a call throws, the remaining indices are skipped
+ * and the first exception is rethrown in the calling thread.
+ *
+ * Only one parallel loop runs at a time. Loops that are started while the pool is
+ * busy with another thread's loop, and nested calls from within 'fn', are run
+ * serially in the calling thread, so that they never have to wait.
+ */
+void parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+/// The number of threads (including the calling one) that parallel_for() uses.
+std::size_t parallel_for_concurrency();
+
+#endif  // end of include guard: WL_BASE_PARALLEL_FOR_H
@@ -100,8 +100,19 @@ static RNG static_rng_(
    std::chrono::time_point_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now())
       .time_since_epoch()
       .count());
+static thread_local RNG* thread_static_rng_ = nullptr;
 uint32_t RNG::static_rand() {
-	return static_rng_.rand();
+	return thread_static_rng_ != nullptr ? thread_static_rng_->rand() : static_rng_.rand();
+}
+void RNG::static_seed(const uint32_t s) {
+	static_rng_.seed(s);
+}
+
+RNG::ScopedStaticRNG::ScopedStaticRNG(RNG& rng) : previous_(thread_static_rng_) {
+	thread_static_rng_ = &rng;
+}
+RNG::ScopedStaticRNG::~ScopedStaticRNG() {
+	thread_static_rng_ = previous_;
 }
 
 std::string generate_random_uuid() {
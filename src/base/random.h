@@ -46,6 +46,20 @@ struct RNG {
 		assert(exclusive_upper_bound > 0);
 		return static_rand() % exclusive_upper_bound;
 	}
+	/// Reseeds the generator behind static_rand(), e.g. for reproducible benchmarks.
+	static void static_seed(uint32_t);
+
+	/// While an instance exists, static_rand() in the thread that created it draws
+	/// from the given generator instead. Code that runs on several threads at once
+	/// then gets the same numbers no matter how the threads are scheduled.
+	class ScopedStaticRNG {
+	public:
+		explicit ScopedStaticRNG(RNG& rng);
+		~ScopedStaticRNG();
+
+	private:
+		RNG* previous_;
+	};
 
 private:
 	uint32_t state0{0U};
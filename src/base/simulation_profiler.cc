@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "base/simulation_profiler.h"
+
+#include <cassert>
+
+#include "base/wexception.h"
+
+bool SimulationProfiler::enabled_ = false;
+SimulationProfiler::Sample SimulationProfiler::sections_[kNumberOfSections];
+SimulationProfiler::Sample SimulationProfiler::commands_[kNumberOfCommandTypes];
+SimulationProfiler::Sample SimulationProfiler::ai_tasks_[kNumberOfAiTaskTypes];
+
+void SimulationProfiler::reset() {
+	for (Sample& sample : sections_) {
+		sample.nanoseconds = 0U;
+		sample.calls = 0U;
+	}
+	for (Sample& sample : commands_) {
+		sample.nanoseconds = 0U;
+		sample.calls = 0U;
+	}
+	for (Sample& sample : ai_tasks_) {
+		sample.nanoseconds = 0U;
+		sample.calls = 0U;
+	}
+}
+
+void SimulationProfiler::add(Section section, uint64_t nanoseconds) {
+	assert(static_cast<unsigned>(section) < kNumberOfSections);
+	Sample& sample = sections_[static_cast<unsigned>(section)];
+	sample.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+	sample.calls.fetch_add(1U, std::memory_order_relaxed);
+}
+
+void SimulationProfiler::add_command(uint8_t command_type, uint64_t nanoseconds) {
+	Sample& sample = commands_[command_type];
+	sample.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+	sample.calls.fetch_add(1U, std::memory_order_relaxed);
+}
+
+void SimulationProfiler::add_ai_task(uint8_t task_type, uint64_t nanoseconds) {
+	assert(task_type < kNumberOfAiTaskTypes);
+	Sample& sample = ai_tasks_[task_type];
+	sample.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+	sample.calls.fetch_add(1U, std::memory_order_relaxed);
+}
+
+const SimulationProfiler::Sample& SimulationProfiler::get(Section section) {
+	assert(static_cast<unsigned>(section) < kNumberOfSections);
+	return sections_[static_cast<unsigned>(section)];
+}
+
+const SimulationProfiler::Sample& SimulationProfiler::get_command(uint8_t command_type) {
+	return commands_[command_type];
+}
+
+const SimulationProfiler::Sample& SimulationProfiler::get_ai_task(uint8_t task_type) {
+	assert(task_type < kNumberOfAiTaskTypes);
+	return ai_tasks_[task_type];
+}
+
+const char* SimulationProfiler::to_string(Section section) {
+	switch (section) {
+	case Section::kEconomyBalance:
+		return "economy_balance";
+	case Section::kAiThink:
+		return "ai_think";
+	case Section::kPathfinding:
+		return "pathfinding";
+	case Section::kRouting:
+		return "routing";
+	case Section::kVision:
+		return "vision";
+	}
+	NEVER_HERE();
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WL_BASE_SIMULATION_PROFILER_H
+#define WL_BASE_SIMULATION_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "base/macros.h"
+
+/**
+ * Accumulates the wall time spent in the parts of the game simulation, for
+ * benchmarking. Profiling is switched off by default, so that outside of
+ * benchmarks the instrumentation only costs a branch.
+ *
+ * Sections can be nested in each other and in commands, e.g. routing happens
+ * during economy balancing, which is itself a command. Each sample therefore
+ * contains the inclusive time.
+ */
+class SimulationProfiler {
+public:
+	enum class Section : uint8_t { kEconomyBalance, kAiThink, kPathfinding, kRouting, kVision };
+	static constexpr unsigned kNumberOfSections = 5;
+	// Command samples are indexed by the numeric value of QueueCommandTypes.
+	static constexpr unsigned kNumberOfCommandTypes = 256;
+	// AI task samples are indexed by the numeric value of AI::SchedulerTaskId.
+	static constexpr unsigned kNumberOfAiTaskTypes = 32;
+
+	struct Sample {
+		std::atomic<uint64_t> nanoseconds{0U};
+		std::atomic<uint64_t> calls{0U};
+	};
+
+	inline static bool is_enabled() {
+		return enabled_;
+	}
+	static void set_enabled(bool enabled) {
+		enabled_ = enabled;
+	}
+
+	/// Clears all samples.
+	static void reset();
+
+	static void add(Section section, uint64_t nanoseconds);
+	static void add_command(uint8_t command_type, uint64_t nanoseconds);
+	static void add_ai_task(uint8_t task_type, uint64_t nanoseconds);
+
+	static const Sample& get(Section section);
+	static const Sample& get_command(uint8_t command_type);
+	static const Sample& get_ai_task(uint8_t task_type);
+
+	static const char* to_string(Section section);
+
+	/// Adds the time until the end of the scope to a section, if profiling is enabled.
+	class ScopedSample {
+	public:
+		explicit ScopedSample(Section section) : section_(section), active_(is_enabled()) {
+			if (active_) {
+				start_ = std::chrono::steady_clock::now();
+			}
+		}
+		~ScopedSample() {
+			if (active_) {
+				add(section_, elapsed_since(start_));
+			}
+		}
+
+	private:
+		const Section section_;
+		const bool active_;
+		std::chrono::steady_clock::time_point start_;
+
+		DISALLOW_COPY_AND_ASSIGN(ScopedSample);
+	};
+
+	static uint64_t elapsed_since(const std::chrono::steady_clock::time_point& start) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		          std::chrono::steady_clock::now() - start)
+		   .count();
+	}
+
+private:
+	static bool enabled_;
+	static Sample sections_[kNumberOfSections];
+	static Sample commands_[kNumberOfCommandTypes];
+	static Sample ai_tasks_[kNumberOfAiTaskTypes];
+};
+
+#endif  // end of include guard: WL_BASE_SIMULATION_PROFILER_H
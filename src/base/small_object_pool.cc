@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "base/small_object_pool.h"
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kNumberOfSizeClasses =
+   SmallObjectPool::kMaxSize / SmallObjectPool::kGranularity;
+
+struct FreeBlock {
+	FreeBlock* next;
+};
+
+// Owns the memory of all blocks, for all threads, and keeps the batches of free
+// blocks that threads have given back.
+struct ChunkStorage {
+	std::mutex mutex;
+	std::vector<std::unique_ptr<char[]>> chunks;
+	std::vector<FreeBlock*> batches[kNumberOfSizeClasses];
+};
+
+ChunkStorage& chunk_storage() {
+	static ChunkStorage storage;
+	return storage;
+}
+
+struct FreeList {
+	FreeBlock* head = nullptr;
+	std::size_t length = 0;
+};
+
+thread_local FreeList free_lists[kNumberOfSizeClasses];
+
+inline std::size_t size_class(std::size_t size) {
+	return size == 0 ? 0 : (size - 1) / SmallObjectPool::kGranularity;
+}
+
+void refill(std::size_t size_class) {
+	FreeList& free_list = free_lists[size_class];
+	ChunkStorage& storage = chunk_storage();
+	{
+		std::lock_guard<std::mutex> guard(storage.mutex);
+		std::vector<FreeBlock*>& batches = storage.batches[size_class];
+		if (!batches.empty()) {
+			free_list.head = batches.back();
+			free_list.length = SmallObjectPool::kBlocksPerBatch;
+			batches.pop_back();
+			return;
+		}
+	}
+
+	const std::size_t block_size = (size_class + 1) * SmallObjectPool::kGranularity;
+	char* chunk = new char[block_size * SmallObjectPool::kBlocksPerBatch];
+	{
+		std::lock_guard<std::mutex> guard(storage.mutex);
+		storage.chunks.emplace_back(chunk);
+	}
+
+	for (std::size_t i = SmallObjectPool::kBlocksPerBatch; i > 0; --i) {
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * block_size);
+		block->next = free_list.head;
+		free_list.head = block;
+	}
+	free_list.length = SmallObjectPool::kBlocksPerBatch;
+}
+
+// Hands one batch of blocks from the front of the list to the other threads.
+void give_back(std::size_t size_class) {
+	FreeList& free_list = free_lists[size_class];
+	FreeBlock* batch = free_list.head;
+	FreeBlock* last = batch;
+	for (std::size_t i = 1; i < SmallObjectPool::kBlocksPerBatch; ++i) {
+		last = last->next;
+	}
+	free_list.head = last->next;
+	free_list.length -= SmallObjectPool::kBlocksPerBatch;
+	last->next = nullptr;
+
+	ChunkStorage& storage = chunk_storage();
+	std::lock_guard<std::mutex> guard(storage.mutex);
+	storage.batches[size_class].push_back(batch);
+}
+
+}  // namespace
+
+void* SmallObjectPool::allocate(std::size_t size) {
+	if (size > kMaxSize) {
+		return ::operator new(size);
+	}
+	const std::size_t sc = size_class(size);
+	FreeList& free_list = free_lists[sc];
+	if (free_list.head == nullptr) {
+		refill(sc);
+	}
+	FreeBlock* block = free_list.head;
+	free_list.head = block->next;
+	--free_list.length;
+	return block;
+}
+
+void SmallObjectPool::deallocate(void* p, std::size_t size) {
+	if (p == nullptr) {
+		return;
+	}
+	if (size > kMaxSize) {
+		::operator delete(p);
+		return;
+	}
+	FreeBlock* block = static_cast<FreeBlock*>(p);
+	const std::size_t sc = size_class(size);
+	FreeList& free_list = free_lists[sc];
+	block->next = free_list.head;
+	free_list.head = block;
+	if (++free_list.length > 2 * kBlocksPerBatch) {
+		give_back(sc);
+	}
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef WL_BASE_SMALL_OBJECT_POOL_H
+#define WL_BASE_SMALL_OBJECT_POOL_H
+
+#include <cstddef>
+
+/**
+ * Allocator for small objects that are created and destroyed at a high rate,
+ * like the commands in the command queue. Sizes are rounded up to a multiple of
+ * kGranularity, and each size class keeps a free list of blocks that are carved
+ * from larger chunks. Objects larger than kMaxSize use the global allocator.
+ *
+ * The free lists are thread-local, so allocating and deallocating does not
+ * need any locking. A block can be freed by another thread than the one that
+ * allocated it; it then joins the free list of the freeing thread. A thread
+ * whose free list grows beyond two batches hands one batch over to a shared
+ * list, and threads that run out of blocks take a batch from there before they
+ * carve a new chunk. So blocks that one thread allocates and another frees are
+ * recycled instead of piling up. The chunks are only returned to the system on
+ * program exit.
+ *
+ * Classes can use this pool by defining class-specific operator new and
+ * operator delete(void*, std::size_t) that forward to it.
+ */
+class SmallObjectPool {
+public:
+	static constexpr std::size_t kGranularity = alignof(std::max_align_t);
+	static constexpr std::size_t kMaxSize = 256;
+	/// Blocks are carved and exchanged between threads in batches of this size.
+	static constexpr std::size_t kBlocksPerBatch = 256;
+
+	static void* allocate(std::size_t size);
+	/// 'size' must be the same as for the call to allocate().
+	static void deallocate(void* p, std::size_t size);
+};
+
+#endif  // end of include guard: WL_BASE_SMALL_OBJECT_POOL_H
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "base/parallel_for.h"
+#include "base/test.h"
+
+TESTSUITE_START(parallel_for)
+
+TESTCASE(visits_every_index_once) {
+	std::vector<int> visits(1000, 0);
+	parallel_for(visits.size(), [&visits](std::size_t i) { ++visits[i]; });
+	for (int count : visits) {
+		check_equal(count, 1);
+	}
+}
+
+TESTCASE(nested_loops) {
+	std::atomic<int> sum(0);
+	parallel_for(10, [&sum](std::size_t) {
+		parallel_for(10, [&sum](std::size_t j) { sum += static_cast<int>(j); });
+	});
+	check_equal(sum.load(), 450);
+}
+
+TESTCASE(concurrent_callers) {
+	std::vector<int> first(1000, 0);
+	std::vector<int> second(1000, 0);
+	std::thread other([&second]() {
+		for (int run = 0; run < 10; ++run) {
+			parallel_for(second.size(), [&second](std::size_t i) { ++second[i]; });
+		}
+	});
+	for (int run = 0; run < 10; ++run) {
+		parallel_for(first.size(), [&first](std::size_t i) { ++first[i]; });
+	}
+	other.join();
+	for (std::size_t i = 0; i < first.size(); ++i) {
+		check_equal(first[i], 10);
+		check_equal(second[i], 10);
+	}
+}
+
+TESTCASE(rethrows_exceptions) {
+	bool caught = false;
+	try {
+		parallel_for(100, [](std::size_t i) {
+			if (i == 42) {
+				throw std::runtime_error("42");
+			}
+		});
+	} catch (const std::runtime_error&) {
+		caught = true;
+	}
+	check_equal(caught, true);
+
+	// The pool is still usable afterwards
+	std::atomic<std::size_t> calls(0);
+	parallel_for(100, [&calls](std::size_t) { ++calls; });
+	check_equal(calls.load(), static_cast<std::size_t>(100));
+}
+
+TESTSUITE_END()
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <vector>
+
+#include "base/parallel_for.h"
+#include "base/random.h"
+#include "base/test.h"
+
+TESTSUITE_START(random)
+
+TESTCASE(scoped_static_rng) {
+	RNG expected(42);
+	RNG rng(42);
+	{
+		RNG::ScopedStaticRNG scope(rng);
+		for (int i = 0; i < 10; ++i) {
+			check_equal(RNG::static_rand(), expected.rand());
+		}
+	}
+	// The generator is no longer used after the scope
+	const uint32_t next = expected.rand();
+	RNG::static_rand();
+	check_equal(rng.rand(), next);
+}
+
+TESTCASE(scoped_static_rng_per_thread) {
+	// Every index draws the same numbers from its own generator, no matter on
+	// which thread it runs and what the other threads do meanwhile.
+	std::vector<uint32_t> results(16);
+	parallel_for(results.size(), [&results](std::size_t i) {
+		RNG rng(7);
+		RNG::ScopedStaticRNG scope(rng);
+		uint32_t sum = 0;
+		for (int j = 0; j < 1000; ++j) {
+			sum += RNG::static_rand();
+		}
+		results[i] = sum;
+	});
+	for (uint32_t result : results) {
+		check_equal(result, results.front());
+	}
+}
+
+TESTSUITE_END()
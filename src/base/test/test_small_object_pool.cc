@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "base/small_object_pool.h"
+#include "base/test.h"
+
+TESTSUITE_START(small_object_pool)
+
+TESTCASE(reuse_freed_blocks) {
+	void* a = SmallObjectPool::allocate(40);
+	SmallObjectPool::deallocate(a, 40);
+	// Sizes in the same size class share a free list
+	void* b = SmallObjectPool::allocate(33);
+	check_equal(a == b, true);
+	SmallObjectPool::deallocate(b, 33);
+}
+
+TESTCASE(distinct_aligned_blocks) {
+	std::vector<void*> blocks;
+	std::set<void*> unique_blocks;
+	for (std::size_t i = 0; i < 1000; ++i) {
+		const std::size_t size = 1 + i % SmallObjectPool::kMaxSize;
+		void* block = SmallObjectPool::allocate(size);
+		check_equal(reinterpret_cast<uintptr_t>(block) % SmallObjectPool::kGranularity, 0U);
+		blocks.push_back(block);
+		unique_blocks.insert(block);
+	}
+	check_equal(unique_blocks.size(), blocks.size());
+	for (std::size_t i = 0; i < blocks.size(); ++i) {
+		SmallObjectPool::deallocate(blocks[i], 1 + i % SmallObjectPool::kMaxSize);
+	}
+}
+
+TESTCASE(large_objects) {
+	const std::size_t size = SmallObjectPool::kMaxSize + 1;
+	char* block = static_cast<char*>(SmallObjectPool::allocate(size));
+	block[0] = 'a';
+	block[size - 1] = 'z';
+	check_equal(block[size - 1], 'z');
+	SmallObjectPool::deallocate(block, size);
+}
+
+TESTCASE(blocks_freed_by_other_thread_are_recycled) {
+	// A size class that the other tests do not use
+	constexpr std::size_t kSize = SmallObjectPool::kMaxSize - 8;
+	constexpr std::size_t kCount = 4 * SmallObjectPool::kBlocksPerBatch;
+
+	// One thread allocates, like the AI threads do with player commands ...
+	std::vector<void*> blocks;
+	std::thread producer([&blocks]() {
+		for (std::size_t i = 0; i < kCount; ++i) {
+			blocks.push_back(SmallObjectPool::allocate(kSize));
+		}
+	});
+	producer.join();
+
+	// ... and this one frees, like the logic thread does
+	const std::set<void*> freed(blocks.begin(), blocks.end());
+	for (void* block : blocks) {
+		SmallObjectPool::deallocate(block, kSize);
+	}
+
+	// A new thread gets the freed blocks back instead of new ones
+	std::vector<void*> reused;
+	std::thread consumer([&reused]() {
+		for (std::size_t i = 0; i < SmallObjectPool::kBlocksPerBatch; ++i) {
+			reused.push_back(SmallObjectPool::allocate(kSize));
+		}
+		for (void* block : reused) {
+			SmallObjectPool::deallocate(block, kSize);
+		}
+	});
+	consumer.join();
+	for (void* block : reused) {
+		check_equal(freed.count(block), 1U);
+	}
+}
+
+TESTSUITE_END()
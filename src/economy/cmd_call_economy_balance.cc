@@ -18,6 +18,8 @@
 
 #include "economy/cmd_call_economy_balance.h"
 
+#include <set>
+
 #include "base/wexception.h"
 #include "economy/economy.h"
 #include "io/fileread.h"
@@ -50,6 +52,53 @@ void CmdCallEconomyBalance::execute(Game& game) {
 	}
 }
 
+/**
+ * Economies of the same player can share warehouses and ships, so the batch is
+ * split into runs of commands for different players, and each run is balanced
+ * with \ref Economy::balance_parallel.
+ */
+void CmdCallEconomyBalance::execute_batch(Game& game, const std::vector<Command*>& batch) {
+	std::vector<std::pair<Economy*, uint32_t>> calls;
+	// The index in the batch of each call
+	std::vector<size_t> commands;
+	std::set<PlayerNumber> players;
+	size_t next_sync_entry = 0;
+	const auto write_sync_entries = [&game, &batch, &next_sync_entry](size_t end) {
+		for (; next_sync_entry < end; ++next_sync_entry) {
+			batch[next_sync_entry]->write_sync_entry(game);
+		}
+	};
+	for (size_t i = 0; i < batch.size();) {
+		calls.clear();
+		commands.clear();
+		players.clear();
+		// Look up the economies only when their run starts, because balancing can split them
+		for (; i < batch.size(); ++i) {
+			CmdCallEconomyBalance& cmd = dynamic_cast<CmdCallEconomyBalance&>(*batch[i]);
+			Flag* const flag = cmd.flag_.get(game);
+			if (flag == nullptr) {
+				continue;
+			}
+			if (!players.insert(flag->owner().player_number()).second) {
+				break;
+			}
+			calls.emplace_back(flag->get_economy(cmd.type_), cmd.timerid_);
+			commands.push_back(i);
+		}
+		if (calls.size() == 1) {
+			// Nothing to share, so the syncstream is the same as for execute()
+			write_sync_entries(commands.front() + 1);
+			calls.front().first->balance(calls.front().second);
+		} else {
+			// Each command is marked right before the economy commits its transfers
+			Economy::balance_parallel(game, calls, [&write_sync_entries, &commands](size_t call) {
+				write_sync_entries(commands[call] + 1);
+			});
+		}
+		write_sync_entries(i);
+	}
+}
+
 constexpr uint16_t kCurrentPacketVersion = 4;
 
 /**
@@ -33,6 +33,11 @@ struct CmdCallEconomyBalance : public GameLogicCommand {
 
 	void execute(Game&) override;
 
+	[[nodiscard]] bool is_batchable() const override {
+		return true;
+	}
+	void execute_batch(Game&, const std::vector<Command*>& batch) override;
+
 	[[nodiscard]] QueueCommandTypes id() const override {
 		return QueueCommandTypes::kCallEconomyBalance;
 	}
@@ -18,17 +18,22 @@
 
 #include "economy/economy.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "base/log.h"
 #include "base/macros.h"
+#include "base/parallel_for.h"
+#include "base/simulation_profiler.h"
 #include "base/wexception.h"
 #include "economy/cmd_call_economy_balance.h"
 #include "economy/flag.h"
+#include "economy/portdock.h"
 #include "economy/request.h"
 #include "economy/route.h"
 #include "economy/routeastar.h"
 #include "economy/router.h"
+#include "economy/ship_fleet.h"
 #include "economy/warehousesupply.h"
 #include "logic/game.h"
 #include "logic/map_objects/tribes/soldier.h"
@@ -228,6 +233,14 @@ bool Economy::find_route(Flag& start, Flag& end, Route* const route, int32_t con
 	   start, end, route, type_, cost_cutoff, *owner().egbase().mutable_map());
 }
 
+void Economy::invalidate_routes(RouteChange change) {
+	router_->invalidate_cache();
+	if (change == RouteChange::kAdded) {
+		// Routes can get cheaper now, so the landmark distances are no lower bounds anymore
+		router_->invalidate_landmarks();
+	}
+}
+
 struct ZeroEstimator {
 	int32_t operator()(RoutingNode& /* node */) const {
 		return 0;
@@ -289,6 +302,7 @@ void Economy::add_flag(Flag& flag) {
 	flag.set_economy(this, type_);
 
 	flag.reset_path_finding_cycle(type_);
+	invalidate_routes(RouteChange::kAdded);
 }
 
 /**
@@ -312,6 +326,8 @@ void Economy::remove_flag(Flag& flag) {
  */
 void Economy::do_remove_flag(Flag& flag) {
 	flag.set_economy(nullptr, type_);
+	invalidate_routes(RouteChange::kRemoved);
+	router_->remove_node(flag);
 
 	// fast remove
 	for (Flags::iterator flag_iter = flags_.begin(); flag_iter != flags_.end(); ++flag_iter) {
@@ -696,12 +712,11 @@ Supply* Economy::find_best_supply(Game& game, const Request& req, int32_t& cost)
 
 	available_supplies_.clear();
 
-	for (size_t i = 0; i < supplies_.get_nrsupplies(); ++i) {
-		Supply& supp = supplies_[i];
-
+	// Only look at the supplies that might provide the requested ware type
+	supplies_.for_each_candidate(req, [this, &game, &req, &target_flag](Supply& supp) {
 		// Just skip if supply does not provide required ware
 		if (supp.nr_supplies(game, req) == 0u) {
-			continue;
+			return;
 		}
 
 		const SupplyProviders provider = supp.provider_type(&game);
@@ -709,7 +724,7 @@ Supply* Economy::find_best_supply(Game& game, const Request& req, int32_t& cost)
 		// We generally ignore disponible wares on ship as it is not possible to reliably
 		// calculate route (transportation time)
 		if (provider == SupplyProviders::kShip) {
-			continue;
+			return;
 		}
 
 		const Widelands::Coords provider_position =
@@ -722,8 +737,8 @@ Supply* Economy::find_best_supply(Game& game, const Request& req, int32_t& cost)
 		// std::map quarantees uniqueness, practically it means that if more wares are on the same
 		// flag, only
 		// first one will be inserted into available_supplies
-		available_supplies_.insert(std::make_pair(ud, &supplies_[i]));
-	}
+		available_supplies_.insert(std::make_pair(ud, &supp));
+	});
 
 	// Now available supplies have been sorted by distance to requestor
 	for (auto& supplypair : available_supplies_) {
@@ -790,13 +805,17 @@ using RSPairQueue = std::
 struct RSPairStruct {
 	RSPairQueue queue;
 	uint32_t pairid = 0;
-	int32_t nexttimer = 0;
+	int32_t nexttimer = -1;
 
 	RSPairStruct() = default;
 };
 
 /**
  * Walk all Requests and find potential transfer candidates.
+ *
+ * Within a \ref ShipFleet::ScopedKnownPortPaths, this only reads the game state
+ * of our owner, so it may run in parallel with the same function of economies
+ * of other players (see \ref balance_parallel).
  */
 void Economy::process_requests(Game& game, RSPairStruct* supply_pairs) {
 	// Algorithm can decide that wares are not to be delivered to constructionsite
@@ -804,16 +823,6 @@ void Economy::process_requests(Game& game, RSPairStruct* supply_pairs) {
 	for (Request* temp_req : requests_) {
 		Request& req = *temp_req;
 
-		// We somehow get desynced request lists that don't trigger desync
-		// alerts, so add info to the sync stream here.
-		{
-			::StreamWrite& ss = game.syncstream();
-			ss.unsigned_8(SyncEntry::kProcessRequests);
-			ss.unsigned_8(req.get_type());
-			ss.unsigned_8(req.get_index());
-			ss.unsigned_32(req.target().serial());
-		}
-
 		int32_t cost;  // estimated time in milliseconds to fulfill Request
 		Supply* const supp = find_best_supply(game, req, cost);
 
@@ -848,14 +857,19 @@ void Economy::process_requests(Game& game, RSPairStruct* supply_pairs) {
 }
 
 /**
- * Try to fulfill open requests with available supplies.
+ * Try to fulfill open requests with the request/supply pairs that have been
+ * found by \ref process_requests.
  */
-void Economy::balance_requestsupply(Game& game) {
-	RSPairStruct rsps;
-	rsps.nexttimer = -1;
-
-	//  Try to fulfill Requests.
-	process_requests(game, &rsps);
+void Economy::balance_requestsupply(Game& game, RSPairStruct& rsps) {
+	// We somehow get desynced request lists that don't trigger desync
+	// alerts, so add info to the sync stream here.
+	::StreamWrite& ss = game.syncstream();
+	for (const Request* req : requests_) {
+		ss.unsigned_8(SyncEntry::kProcessRequests);
+		ss.unsigned_8(req->get_type());
+		ss.unsigned_8(req->get_index());
+		ss.unsigned_32(req->target().serial());
+	}
 
 	//  Now execute request/supply pairs.
 
@@ -1155,15 +1169,91 @@ void Economy::balance(uint32_t const timerid) {
 	if (request_timerid_ != timerid) {
 		return;
 	}
-	++request_timerid_;
 
+	SimulationProfiler::ScopedSample sample(SimulationProfiler::Section::kEconomyBalance);
 	Game& game = dynamic_cast<Game&>(owner().egbase());
 
+	start_balance(game);
+
+	//  Try to fulfill Requests.
+	RSPairStruct rsps;
+	process_requests(game, &rsps);
+
+	finish_balance(game, rsps);
+}
+
+/**
+ * Balancing is split into three phases: \ref start_balance and \ref finish_balance
+ * change the game state, whereas \ref process_requests, which does all the route
+ * finding and is by far the most expensive one, only reads the state of the
+ * economy's owner. Routes across the sea would search the paths between ports
+ * on demand, so \ref start_balance connects all ports beforehand and the middle
+ * phase only uses the known port paths. For economies of different players, the
+ * middle phases can therefore run concurrently. All changes of the game state, including the
+ * syncstream entries, happen serially in the given order, so the outcome does
+ * not depend on the number of threads. Note that the start phases of all calls
+ * come before the first call to \p before_commit.
+ */
+void Economy::balance_parallel(Game& game,
+                               const std::vector<std::pair<Economy*, uint32_t>>& calls,
+                               const std::function<void(size_t)>& before_commit) {
+	SimulationProfiler::ScopedSample sample(SimulationProfiler::Section::kEconomyBalance);
+
+	// Indices of the calls whose balancing is still due
+	std::vector<size_t> due;
+	due.reserve(calls.size());
+	for (size_t i = 0; i < calls.size(); ++i) {
+		Economy* economy = calls[i].first;
+		if (economy->request_timerid_ == calls[i].second) {
+			assert(std::none_of(due.begin(), due.end(), [&calls, economy](size_t j) {
+				return &calls[j].first->owner() == &economy->owner();
+			}));
+			economy->start_balance(game);
+			due.push_back(i);
+		}
+	}
+
+	std::vector<RSPairStruct> rsps(due.size());
+	{
+		ShipFleet::ScopedKnownPortPaths known_port_paths;
+		parallel_for(due.size(), [&game, &calls, &due, &rsps](size_t i) {
+			calls[due[i]].first->process_requests(game, &rsps[i]);
+		});
+	}
+
+	size_t next_call = 0;
+	for (size_t i = 0; i < due.size(); ++i) {
+		for (; next_call <= due[i]; ++next_call) {
+			before_commit(next_call);
+		}
+		calls[due[i]].first->finish_balance(game, rsps[i]);
+	}
+	for (; next_call < calls.size(); ++next_call) {
+		before_commit(next_call);
+	}
+}
+
+void Economy::start_balance(Game& game) {
+	++request_timerid_;
+
 	check_splits();
 
 	create_requested_workers(game);
 
-	balance_requestsupply(game);
+	// Port paths are searched here, so that the route finding in
+	// process_requests never needs to change a fleet.
+	for (Warehouse* warehouse : warehouses_) {
+		if (PortDock* portdock = warehouse->get_portdock()) {
+			ShipFleet* fleet = portdock->get_fleet();
+			if (fleet != nullptr && fleet->active()) {
+				fleet->connect_ports(game);
+			}
+		}
+	}
+}
+
+void Economy::finish_balance(Game& game, RSPairStruct& rsps) {
+	balance_requestsupply(game, rsps);
 
 	handle_active_supplies(game);
 }
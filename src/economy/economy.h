@@ -23,6 +23,7 @@
 #include <memory>
 
 #include "base/macros.h"
+#include "economy/routing_node.h"
 #include "economy/supply.h"
 #include "economy/supply_list.h"
 #include "logic/map_objects/map_object.h"
@@ -126,6 +127,8 @@ public:
 	static void check_split(Flag&, Flag&, WareWorker);
 
 	bool find_route(Flag& start, Flag& end, Route* route, int32_t cost_cutoff = -1);
+	/// Must be called whenever roads, ferries or ports change, or the cost of using them.
+	void invalidate_routes(RouteChange);
 
 	using WarehouseAcceptFn = std::function<bool(Warehouse&)>;
 	Warehouse* find_closest_warehouse(Flag& start,
@@ -203,6 +206,17 @@ public:
 
 	///< called by \ref Cmd_Call_Economy_Balance
 	void balance(uint32_t timerid);
+	/**
+	 * Balances several economies whose balancing is due at the same time, as if
+	 * balance() was called for each of them in the given order. The economies must
+	 * belong to different players, so that they cannot share any state: their
+	 * requests are then matched with supplies in parallel. \p before_commit is
+	 * called with the index of each call, in order, right before the results
+	 * of that call change the game state.
+	 */
+	static void balance_parallel(Game&,
+	                             const std::vector<std::pair<Economy*, uint32_t>>& calls,
+	                             const std::function<void(size_t)>& before_commit);
 
 	void rebalance_supply() {
 		start_request_timer();
@@ -241,7 +255,9 @@ private:
 
 	Supply* find_best_supply(Game&, const Request&, int32_t& cost);
 	void process_requests(Game&, RSPairStruct* supply_pairs);
-	void balance_requestsupply(Game&);
+	void balance_requestsupply(Game&, RSPairStruct& supply_pairs);
+	void start_balance(Game&);
+	void finish_balance(Game&, RSPairStruct& supply_pairs);
 	void handle_active_supplies(Game&);
 	void create_requested_workers(Game&);
 	void create_requested_worker(Game&, DescriptionIndex);
@@ -225,6 +225,10 @@ void Flag::attach_building(EditorGameBase& egbase, Building& building) {
 
 	building.set_economy(get_economy(wwWARE), wwWARE);
 	building.set_economy(get_economy(wwWORKER), wwWORKER);
+	// Only ports add routes, see add_neighbours()
+	if (building.descr().get_isport()) {
+		routes_changed(RouteChange::kAdded);
+	}
 }
 
 /**
@@ -235,6 +239,9 @@ void Flag::detach_building(EditorGameBase& egbase) {
 
 	building_->set_economy(nullptr, wwWARE);
 	building_->set_economy(nullptr, wwWORKER);
+	if (building_->descr().get_isport()) {
+		routes_changed(RouteChange::kRemoved);
+	}
 
 	const Map& map = egbase.map();
 	egbase.set_road(map.get_fcoords(map.tl_n(position_)), WALK_SE, RoadSegment::kNone);
@@ -251,6 +258,7 @@ void Flag::attach_road(int32_t const dir, RoadBase* const road) {
 	roads_[dir - 1] = road;
 	roads_[dir - 1]->set_economy(get_economy(wwWARE), wwWARE);
 	roads_[dir - 1]->set_economy(get_economy(wwWORKER), wwWORKER);
+	routes_changed(RouteChange::kAdded);
 }
 
 /**
@@ -262,6 +270,19 @@ void Flag::detach_road(int32_t const dir) {
 	roads_[dir - 1]->set_economy(nullptr, wwWARE);
 	roads_[dir - 1]->set_economy(nullptr, wwWORKER);
 	roads_[dir - 1] = nullptr;
+	routes_changed(RouteChange::kRemoved);
+}
+
+/**
+ * The roads or ports of this flag changed, so cached routes are invalid.
+ */
+void Flag::routes_changed(RouteChange change) {
+	if (Economy* e = get_economy(wwWARE)) {
+		e->invalidate_routes(change);
+	}
+	if (Economy* e = get_economy(wwWORKER)) {
+		e->invalidate_routes(change);
+	}
 }
 
 /**
@@ -277,6 +298,17 @@ BaseImmovable::PositionList Flag::get_positions(const EditorGameBase& /* egbase
  * \return neighbouring flags.
  */
 void Flag::get_neighbours(WareWorker type, RoutingNodeNeighbours& neighbours) {
+	add_neighbours(type, neighbours, true);
+}
+
+/**
+ * The neighbours without the costs for waiting wares.
+ */
+void Flag::get_base_neighbours(WareWorker type, RoutingNodeNeighbours& neighbours) {
+	add_neighbours(type, neighbours, false);
+}
+
+void Flag::add_neighbours(WareWorker type, RoutingNodeNeighbours& neighbours, bool with_waitcost) {
 	for (RoadBase* const road : roads_) {
 		if (road == nullptr) {
 			continue;
@@ -295,7 +327,7 @@ void Flag::get_neighbours(WareWorker type, RoutingNodeNeighbours& neighbours) {
 			f = &road->get_flag(RoadBase::FlagStart);
 			nb_cost = road->get_cost(RoadBase::FlagEnd);
 		}
-		if (type == wwWARE) {
+		if (type == wwWARE && with_waitcost) {
 			nb_cost += nb_cost * (get_waitcost() + f->get_waitcost()) / 2;
 		}
 		RoutingNodeNeighbour n(f, nb_cost);
@@ -100,9 +100,11 @@ struct Flag : public PlayerImmovable, public RoutingNode {
 	}
 	PositionList get_positions(const EditorGameBase&) const override;
 	void get_neighbours(WareWorker type, RoutingNodeNeighbours&) override;
+	void get_base_neighbours(WareWorker type, RoutingNodeNeighbours&) override;
 	int32_t get_waitcost() const {
 		return ware_filled_;
 	}
+	void routes_changed(RouteChange);
 
 	void set_economy(Economy*, WareWorker) override;
 
@@ -187,6 +189,7 @@ protected:
 	          RenderTarget* dst) override;
 
 	void wake_up_capacity_queue(Game&);
+	void add_neighbours(WareWorker type, RoutingNodeNeighbours&, bool with_waitcost);
 
 	static void
 	flag_job_request_callback(Game&, Request&, DescriptionIndex, Worker*, PlayerImmovable&);
@@ -338,7 +338,7 @@ void Road::postsplit(Game& game, Flag& flag) {
 		}
 
 		// Cause a worker update in any case
-		w->send_signal(game, "road");
+		w->send_signal(game, BobSignal::kRoad);
 	}
 
 	// Initialize the new road
@@ -472,7 +472,7 @@ void Road::charge_wallet(Game& game) {
 				}
 				if (Carrier* const c = slot.carrier.get(game)) {
 					if (c->top_state().task == &Carrier::taskRoad) {
-						c->send_signal(game, "cancel");
+						c->send_signal(game, BobSignal::kCancel);
 						// This signal is not handled in any special way. It will simply pop the task off
 						// the stack. The string "cancel" has been used to clarify the final goal we want
 						// to achieve, ie: cancelling the current task.
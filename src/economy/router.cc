@@ -18,6 +18,13 @@
 
 #include "economy/router.h"
 
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include "base/simulation_profiler.h"
 #include "economy/iroute.h"
 #include "economy/itransport_cost_calculator.h"
 #include "economy/routeastar.h"
@@ -25,6 +32,89 @@
 
 namespace Widelands {
 
+namespace {
+
+// Remembers the nodes of a route, so that it can be replayed from the cache
+struct RouteRecorder : public IRoute {
+	void init(int32_t cost) override {
+		cost_ = cost;
+		nodes_.clear();
+	}
+	void insert_as_first(RoutingNode* node) override {
+		nodes_.push_back(node);
+	}
+
+	int32_t cost_{0};
+	std::vector<RoutingNode*> nodes_;
+};
+
+constexpr int32_t kUnreachable = std::numeric_limits<int32_t>::max();
+
+// The part of the routing graph that can be reached from a node, with base costs
+struct BaseGraph {
+	using Edges = std::vector<std::pair<uint32_t, int32_t>>;
+
+	explicit BaseGraph(RoutingNode& start, WareWorker type) {
+		indices.emplace(&start, 0);
+		nodes.push_back(&start);
+		RoutingNodeNeighbours neighbours;
+		for (uint32_t i = 0; i < nodes.size(); ++i) {
+			neighbours.clear();
+			nodes[i]->get_base_neighbours(type, neighbours);
+			edges.emplace_back();
+			for (const RoutingNodeNeighbour& neighbour : neighbours) {
+				auto inserted = indices.emplace(neighbour.get_neighbour(), nodes.size());
+				if (inserted.second) {
+					nodes.push_back(neighbour.get_neighbour());
+				}
+				edges[i].emplace_back(inserted.first->second, neighbour.get_cost());
+			}
+		}
+
+		reverse_edges.resize(nodes.size());
+		for (uint32_t i = 0; i < nodes.size(); ++i) {
+			for (const auto& edge : edges[i]) {
+				reverse_edges[edge.first].emplace_back(i, edge.second);
+			}
+		}
+	}
+
+	std::vector<RoutingNode*> nodes;
+	std::unordered_map<const RoutingNode*, uint32_t> indices;
+	std::vector<Edges> edges;
+	std::vector<Edges> reverse_edges;
+};
+
+std::vector<int32_t> dijkstra(const std::vector<BaseGraph::Edges>& edges, uint32_t source) {
+	std::vector<int32_t> distances(edges.size(), kUnreachable);
+	using Entry = std::pair<int32_t, uint32_t>;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	distances[source] = 0;
+	queue.emplace(0, source);
+	while (!queue.empty()) {
+		const Entry current = queue.top();
+		queue.pop();
+		if (current.first > distances[current.second]) {
+			continue;
+		}
+		for (const auto& edge : edges[current.second]) {
+			const int32_t cost = current.first + edge.second;
+			if (cost < distances[edge.first]) {
+				distances[edge.first] = cost;
+				queue.emplace(cost, edge.first);
+			}
+		}
+	}
+	return distances;
+}
+
+}  // namespace
+
+bool Router::landmarks_enabled_ = true;
+std::atomic<uint64_t> Router::cache_hits_[2] = {{0U}, {0U}};
+std::atomic<uint64_t> Router::cache_misses_[2] = {{0U}, {0U}};
+std::atomic<uint64_t> Router::landmark_prunes_{0U};
+
 /*************************************************************************/
 /*                         Router Implementation                         */
 /*************************************************************************/
@@ -41,6 +131,140 @@ uint32_t Router::assign_cycle() {
 	return mpf_cycle;
 }
 
+void Router::invalidate_cache() {
+	cache_.clear();
+}
+
+void Router::invalidate_landmarks() {
+	landmarks_valid_ = false;
+	landmark_distances_.clear();
+}
+
+void Router::remove_node(const RoutingNode& node) {
+	// The distances of the remaining nodes are still lower bounds. The pointer
+	// must not stay in the table though, because a new node might reuse it.
+	landmark_distances_.erase(&node);
+}
+
+void Router::set_landmarks_enabled(bool enabled) {
+	landmarks_enabled_ = enabled;
+}
+
+Router::CacheStatistics Router::cache_statistics() {
+	return {cache_hits_[wwWARE].load(), cache_misses_[wwWARE].load(), cache_hits_[wwWORKER].load(),
+	        cache_misses_[wwWORKER].load(), landmark_prunes_.load()};
+}
+
+void Router::reset_cache_statistics() {
+	for (WareWorker type : {wwWARE, wwWORKER}) {
+		cache_hits_[type] = 0U;
+		cache_misses_[type] = 0U;
+	}
+	landmark_prunes_ = 0U;
+}
+
+/**
+ * Choose landmarks that are far away from each other and calculate the base
+ * costs from and to them for all nodes that can be reached from \p start.
+ */
+void Router::build_landmarks(RoutingNode& start, WareWorker type) {
+	landmark_distances_.clear();
+	landmarks_valid_ = true;
+	landmarks_type_ = type;
+	nr_landmarks_ = 0U;
+
+	const BaseGraph graph(start, type);
+	const size_t nr_nodes = graph.nodes.size();
+	if (nr_nodes < kMinNodesForLandmarks) {
+		return;
+	}
+
+	// Each landmark is the node whose distance to the closest of the previous
+	// landmarks is biggest. Ties go to the node that was discovered first.
+	std::vector<int32_t> closest = dijkstra(graph.edges, 0);
+	std::vector<std::vector<int32_t>> from;
+	std::vector<std::vector<int32_t>> to;
+	for (; nr_landmarks_ < kMaxLandmarks; ++nr_landmarks_) {
+		uint32_t landmark = 0U;
+		for (uint32_t i = 1; i < nr_nodes; ++i) {
+			if (closest[i] != kUnreachable && closest[i] > closest[landmark]) {
+				landmark = i;
+			}
+		}
+		if (closest[landmark] == 0) {
+			// No more nodes that are apart from the landmarks
+			break;
+		}
+		from.push_back(dijkstra(graph.edges, landmark));
+		to.push_back(dijkstra(graph.reverse_edges, landmark));
+		for (uint32_t i = 0; i < nr_nodes; ++i) {
+			closest[i] = std::min(closest[i], from.back()[i]);
+		}
+	}
+
+	landmark_distances_.reserve(nr_nodes);
+	for (uint32_t i = 0; i < nr_nodes; ++i) {
+		LandmarkDistances& distances = landmark_distances_[graph.nodes[i]];
+		for (size_t l = 0; l < nr_landmarks_; ++l) {
+			distances.from[l] = from[l][i];
+			distances.to[l] = to[l][i];
+		}
+	}
+}
+
+/**
+ * \return a lower bound for the cost of the cheapest route, kUnreachable if
+ * there is no route at all, or 0 if nothing is known.
+ */
+int32_t
+Router::landmark_lower_bound(RoutingNode& start, const RoutingNode& end, WareWorker type) {
+	if (!landmarks_valid_ || landmarks_type_ != type) {
+		build_landmarks(start, type);
+	}
+	const auto start_it = landmark_distances_.find(&start);
+	const auto end_it = landmark_distances_.find(&end);
+	if (start_it == landmark_distances_.end() || end_it == landmark_distances_.end()) {
+		return 0;
+	}
+
+	const LandmarkDistances& s = start_it->second;
+	const LandmarkDistances& e = end_it->second;
+	int32_t result = 0;
+	for (size_t l = 0; l < nr_landmarks_; ++l) {
+		// cost(start, end) >= cost(landmark, end) - cost(landmark, start)
+		if (s.from[l] != kUnreachable) {
+			if (e.from[l] == kUnreachable) {
+				return kUnreachable;
+			}
+			result = std::max(result, e.from[l] - s.from[l]);
+		}
+		// cost(start, end) >= cost(start, landmark) - cost(end, landmark)
+		if (e.to[l] != kUnreachable) {
+			if (s.to[l] == kUnreachable) {
+				return kUnreachable;
+			}
+			result = std::max(result, s.to[l] - e.to[l]);
+		}
+	}
+	return result;
+}
+
+bool Router::find_cached_route(const CacheKey& key, IRoute* route, int32_t cost_cutoff) const {
+	const auto it = cache_.find(key);
+	assert(it != cache_.end());
+	const CachedRoute& cached = it->second;
+	if (cost_cutoff >= 0 && cached.cost > cost_cutoff) {
+		return false;
+	}
+	if (route != nullptr) {
+		route->init(cached.cost);
+		for (RoutingNode* node : cached.nodes) {
+			route->insert_as_first(node);
+		}
+	}
+	return true;
+}
+
 /**
  * Calculate a route between two nodes.
  *
@@ -61,6 +285,15 @@ uint32_t Router::assign_cycle() {
  *        Set this parameter to -1 to allow arbitrarily large routes.
  *
  * \return true if a route has been found, false otherwise
+ *
+ * Found worker routes are cached, so that repeated queries only cost a lookup until
+ * the cache is invalidated. The cost cutoff does not change which nodes the
+ * search expands before it gives up, so a cached route is the one a new search
+ * would return if it got that far, and a cached route above the cutoff means
+ * that a new search would fail. The estimate may overestimate downhill
+ * routes, however, so a search with a cutoff can give up even though a route
+ * within the cutoff exists. Such queries are therefore always searched, so the
+ * answer never depends on what was cached before.
  */
 bool Router::find_route(RoutingNode& start,
                         RoutingNode& end,
@@ -68,6 +301,28 @@ bool Router::find_route(RoutingNode& start,
                         WareWorker const type,
                         int32_t const cost_cutoff,
                         ITransportCostCalculator& cost_calculator) {
+	SimulationProfiler::ScopedSample sample(SimulationProfiler::Section::kRouting);
+
+	// Ware routes depend on the wares waiting at the flags, which change all the
+	// time, so they are not worth caching
+	const bool use_cache = type == wwWORKER;
+	const CacheKey key{&start, &end, type};
+	if (use_cache) {
+		const auto cached = cache_.find(key);
+		if (cached != cache_.end() && (cost_cutoff < 0 || cached->second.cost > cost_cutoff)) {
+			cache_hits_[type].fetch_add(1U, std::memory_order_relaxed);
+			return find_cached_route(key, route, cost_cutoff);
+		}
+	}
+	cache_misses_[type].fetch_add(1U, std::memory_order_relaxed);
+
+	// The search can only succeed if the cutoff is not below the lower bound
+	if (cost_cutoff >= 0 && landmarks_enabled_ &&
+	    landmark_lower_bound(start, end, type) > cost_cutoff) {
+		landmark_prunes_.fetch_add(1U, std::memory_order_relaxed);
+		return false;
+	}
+
 	RouteAStar<AStarEstimator> astar(*this, type, AStarEstimator(cost_calculator, end));
 
 	astar.push(start);
@@ -80,10 +335,19 @@ bool Router::find_route(RoutingNode& start,
 
 		if (current == &end) {
 			// found our goal
-			if (route != nullptr) {
-				astar.routeto(end, *route);
+			if (!use_cache) {
+				if (route != nullptr) {
+					astar.routeto(end, *route);
+				}
+				return true;
+			}
+			if (cache_.size() >= kMaxCachedRoutes) {
+				cache_.clear();
 			}
-			return true;
+			RouteRecorder recorder;
+			astar.routeto(end, recorder);
+			cache_.emplace(key, CachedRoute{recorder.cost_, std::move(recorder.nodes_)});
+			return find_cached_route(key, route, cost_cutoff);
 		}
 	}
 
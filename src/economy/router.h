@@ -18,8 +18,11 @@
 #ifndef WL_ECONOMY_ROUTER_H
 #define WL_ECONOMY_ROUTER_H
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <unordered_map>
+#include <vector>
 
 #include "logic/map_objects/tribes/wareworker.h"
 
@@ -31,6 +34,20 @@ struct RoutingNode;
 /**
  * This class finds the best route between Nodes (Flags) in an economy.
  * The functionality was split from Economy
+ *
+ * Worker routes that have been found are cached until the economy calls
+ * invalidate_cache(), which it must do whenever the routing graph changes.
+ * Ware routes are not cached, because their costs include the wares waiting
+ * at the flags, which change with nearly every ware that moves.
+ *
+ * In large economies, the router also keeps the distances from and to a few
+ * landmark nodes, which give lower bounds for the cost of any route by the
+ * triangle inequality (see "Computing the shortest path: A* search meets graph
+ * theory", Goldberg & Harrelson). A search whose cost cutoff is below the lower
+ * bound can never succeed and is skipped. The A* search itself is unchanged, so
+ * the routes are the same with or without landmarks. Removing edges or nodes
+ * only makes routes more expensive, so the bounds stay valid until an edge or
+ * node is added and the economy calls invalidate_landmarks().
  */
 struct Router {
 	using ResetCycleFn = std::function<void()>;
@@ -45,9 +62,81 @@ struct Router {
 	                ITransportCostCalculator& cost_calculator);
 	uint32_t assign_cycle();
 
+	/// Forget all cached routes.
+	void invalidate_cache();
+	/// Forget the landmark distances.
+	void invalidate_landmarks();
+	/// The node is no longer part of the routing graph.
+	void remove_node(const RoutingNode&);
+
+	/// Landmarks are used by default; switching them off is only useful for benchmarking.
+	static void set_landmarks_enabled(bool enabled);
+
+	/// Cache statistics, summed up over all routers. Ware routes are never cached,
+	/// so every ware query counts as a miss. 'pruned' counts the searches that
+	/// were skipped because of the landmark lower bounds.
+	struct CacheStatistics {
+		uint64_t ware_hits;
+		uint64_t ware_misses;
+		uint64_t worker_hits;
+		uint64_t worker_misses;
+		uint64_t pruned;
+	};
+	static CacheStatistics cache_statistics();
+	static void reset_cache_statistics();
+
 private:
+	// Limits the memory used by the cache in economies that do not change for a long time
+	static constexpr size_t kMaxCachedRoutes = 8192;
+
+	struct CacheKey {
+		const RoutingNode* start;
+		const RoutingNode* end;
+		WareWorker type;
+
+		bool operator==(const CacheKey& other) const {
+			return start == other.start && end == other.end && type == other.type;
+		}
+	};
+	struct CacheKeyHash {
+		size_t operator()(const CacheKey& key) const {
+			return std::hash<const void*>()(key.start) * 31 + std::hash<const void*>()(key.end) * 2 +
+			       key.type;
+		}
+	};
+	struct CachedRoute {
+		int32_t cost;
+		// In the order in which they were passed to IRoute::insert_as_first()
+		std::vector<RoutingNode*> nodes;
+	};
+
+	bool find_cached_route(const CacheKey& key, IRoute* route, int32_t cost_cutoff) const;
+
+	// Smaller economies are routed quickly enough without landmarks
+	static constexpr size_t kMinNodesForLandmarks = 256;
+	static constexpr size_t kMaxLandmarks = 4;
+
+	struct LandmarkDistances {
+		int32_t from[kMaxLandmarks];  ///< Base cost of the cheapest route from the landmark
+		int32_t to[kMaxLandmarks];    ///< Base cost of the cheapest route to the landmark
+	};
+	void build_landmarks(RoutingNode& start, WareWorker type);
+	int32_t landmark_lower_bound(RoutingNode& start, const RoutingNode& end, WareWorker type);
+
 	ResetCycleFn reset_;
 	uint32_t mpf_cycle{0U};  ///< pathfinding cycle, see Flag::mpf_cycle
+	std::unordered_map<CacheKey, CachedRoute, CacheKeyHash> cache_;
+
+	bool landmarks_valid_{false};
+	WareWorker landmarks_type_{wwWARE};
+	size_t nr_landmarks_{0U};
+	std::unordered_map<const RoutingNode*, LandmarkDistances> landmark_distances_;
+
+	static bool landmarks_enabled_;
+	// Indexed by WareWorker
+	static std::atomic<uint64_t> cache_hits_[2];
+	static std::atomic<uint64_t> cache_misses_[2];
+	static std::atomic<uint64_t> landmark_prunes_;
 };
 }  // namespace Widelands
 #endif  // end of include guard: WL_ECONOMY_ROUTER_H
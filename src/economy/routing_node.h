@@ -47,6 +47,12 @@ private:
 };
 using RoutingNodeNeighbours = std::vector<RoutingNodeNeighbour>;
 
+/// How the routing graph of an economy changed, see Economy::invalidate_routes()
+enum class RouteChange {
+	kRemoved,  ///< Roads, ferries, ports or ships were removed
+	kAdded     ///< Roads, ferries, ports or ships were added
+};
+
 /**
  * A routing node is a field with a cost attached to it
  * plus some status variables needed for path finding.
@@ -99,6 +105,14 @@ public:
 
 	virtual Flag& base_flag() = 0;
 	virtual void get_neighbours(WareWorker type, RoutingNodeNeighbours&) = 0;
+	/**
+	 * Like get_neighbours(), but only with the base costs, which do not change
+	 * while the neighbours stay the same. They must never be higher than the
+	 * costs from get_neighbours().
+	 */
+	virtual void get_base_neighbours(WareWorker type, RoutingNodeNeighbours& neighbours) {
+		get_neighbours(type, neighbours);
+	}
 	[[nodiscard]] virtual const Coords& get_position() const = 0;
 };
 }  // namespace Widelands
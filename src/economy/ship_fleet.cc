@@ -349,6 +349,18 @@ const ShipFleet::PortPath& ShipFleet::portpath_bidir(uint32_t i, uint32_t j, boo
 	return portpath(i, j);
 }
 
+/**
+ * The path between the ports with the given indices in either direction, or
+ * nullptr if it was never requested. Unlike \ref portpath, this never changes the fleet.
+ */
+const ShipFleet::PortPath* ShipFleet::find_portpath(uint32_t i, uint32_t j) const {
+	if (i > j) {
+		std::swap(i, j);
+	}
+	const auto it = port_paths_.find(std::make_pair(ports_[i]->serial(), ports_[j]->serial()));
+	return it != port_paths_.end() ? &it->second : nullptr;
+}
+
 /**
  * Find the two docks in the fleet, and fill in the path between them.
  *
@@ -393,6 +405,15 @@ bool ShipFleet::get_act_pending() const {
 	return act_pending_;
 }
 
+/**
+ * Ships or ports were added or removed, which changes the routes through the ports.
+ */
+void ShipFleet::routes_changed(RouteChange change) {
+	for (PortDock* port : ports_) {
+		port->base_flag().routes_changed(change);
+	}
+}
+
 void ShipFleet::add_neighbours(PortDock& pd, std::vector<RoutingNodeNeighbour>& neighbours) {
 	uint32_t idx = std::find(ports_.begin(), ports_.end(), &pd) - ports_.begin();
 
@@ -401,23 +422,70 @@ void ShipFleet::add_neighbours(PortDock& pd, std::vector<RoutingNodeNeighbour>&
 			continue;
 		}
 
-		bool reverse;
-		PortPath& pp(portpath_bidir(idx, otheridx, reverse));
-
-		if (pp.cost < 0) {
-			// Lazily discover routes between ports
-			connect_port(get_owner()->egbase(), idx);
+		const PortPath* pp;
+		if (known_port_paths_only_) {
+			pp = find_portpath(idx, otheridx);
+			if (pp == nullptr) {
+				continue;
+			}
+		} else {
+			bool reverse;
+			PortPath& path(portpath_bidir(idx, otheridx, reverse));
+			if (path.cost < 0) {
+				// Lazily discover routes between ports
+				connect_port(get_owner()->egbase(), idx);
+			}
+			pp = &path;
 		}
 
-		if (pp.cost >= 0) {
+		if (pp->cost >= 0) {
 			// TODO(unknown): keep statistics on average transport time instead of using the arbitrary
 			// 2x factor
-			RoutingNodeNeighbour neighb(&ports_[otheridx]->base_flag(), 2 * pp.cost);
+			RoutingNodeNeighbour neighb(&ports_[otheridx]->base_flag(), 2 * pp->cost);
 			neighbours.push_back(neighb);
 		}
 	}
 }
 
+/**
+ * Search the paths between all ports that are not connected yet, so that
+ * \ref add_neighbours does not have to do it while a \ref ScopedKnownPortPaths exists.
+ */
+void ShipFleet::connect_ports(EditorGameBase& egbase) {
+	for (uint32_t idx = 0; idx < ports_.size(); ++idx) {
+		for (uint32_t otheridx = idx + 1; otheridx < ports_.size(); ++otheridx) {
+			const PortPath* pp = find_portpath(idx, otheridx);
+			if (pp == nullptr || pp->cost < 0) {
+				connect_port(egbase, idx);
+				break;
+			}
+		}
+	}
+}
+
+bool ShipFleet::has_unconnected_ports() const {
+	for (uint32_t idx = 0; idx < ports_.size(); ++idx) {
+		for (uint32_t otheridx = idx + 1; otheridx < ports_.size(); ++otheridx) {
+			const PortPath* pp = find_portpath(idx, otheridx);
+			if (pp == nullptr || pp->cost < 0) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+std::atomic<bool> ShipFleet::known_port_paths_only_{false};
+
+ShipFleet::ScopedKnownPortPaths::ScopedKnownPortPaths() {
+	assert(!known_port_paths_only_);
+	known_port_paths_only_ = true;
+}
+
+ShipFleet::ScopedKnownPortPaths::~ScopedKnownPortPaths() {
+	known_port_paths_only_ = false;
+}
+
 void ShipFleet::add_ship(EditorGameBase& egbase, Ship* ship) {
 	ships_.push_back(ship);
 	assert(std::count(ships_.begin(), ships_.end(), ship) == 1);
@@ -438,6 +506,7 @@ void ShipFleet::add_ship(EditorGameBase& egbase, Ship* ship) {
 	if (ships_.size() == 1) {
 		check_merge_economy();
 	}
+	routes_changed(RouteChange::kAdded);
 	update(egbase);
 }
 
@@ -455,6 +524,7 @@ void ShipFleet::remove_ship(EditorGameBase& egbase, Ship* ship) {
 	assert(std::count(ships_.begin(), ships_.end(), ship) == 0);
 
 	ship->set_fleet(nullptr);
+	routes_changed(RouteChange::kRemoved);
 
 	if (upcast(Game, game, &egbase)) {
 		ship->set_economy(*game, nullptr, wwWARE);
@@ -637,6 +707,7 @@ void ShipFleet::connect_port(EditorGameBase& egbase, uint32_t idx) {
 void ShipFleet::add_port(EditorGameBase& egbase, PortDock* port) {
 	ports_.push_back(port);
 	port->set_fleet(this);
+	routes_changed(RouteChange::kAdded);
 	if (ports_.size() == 1) {
 		set_economy(ports_[0]->get_economy(wwWARE), wwWARE);
 		set_economy(ports_[0]->get_economy(wwWORKER), wwWORKER);
@@ -654,6 +725,7 @@ void ShipFleet::add_port(EditorGameBase& egbase, PortDock* port) {
 }
 
 void ShipFleet::remove_port(EditorGameBase& egbase, PortDock* port) {
+	routes_changed(RouteChange::kRemoved);
 	for (auto it = port_paths_.begin(); it != port_paths_.end();) {
 		if (it->first.first == port->serial() || it->first.second == port->serial()) {
 			it = port_paths_.erase(it);
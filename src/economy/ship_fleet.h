@@ -19,9 +19,11 @@
 #ifndef WL_ECONOMY_SHIP_FLEET_H
 #define WL_ECONOMY_SHIP_FLEET_H
 
+#include <atomic>
 #include <memory>
 
 #include "base/macros.h"
+#include "economy/routing_node.h"
 #include "economy/shipping_schedule.h"
 #include "logic/map_objects/map_object.h"
 #include "logic/map_objects/tribes/wareworker.h"
@@ -119,6 +121,18 @@ struct ShipFleet : MapObject {
 
 	bool get_path(const PortDock& start, const PortDock& end, Path& path);
 	void add_neighbours(PortDock& pd, std::vector<RoutingNodeNeighbour>& neighbours);
+	void connect_ports(EditorGameBase& egbase);
+	[[nodiscard]] bool has_unconnected_ports() const;
+
+	/// While an instance exists, add_neighbours() only uses the port paths that
+	/// are already known instead of searching for the missing ones. It then
+	/// neither changes the fleet nor uses the map's pathfields, so routes can be
+	/// found on several threads at once. Call connect_ports() beforehand.
+	class ScopedKnownPortPaths {
+	public:
+		ScopedKnownPortPaths();
+		~ScopedKnownPortPaths();
+	};
 
 	[[nodiscard]] uint32_t count_ships() const;
 	[[nodiscard]] uint32_t count_ports() const;
@@ -150,12 +164,14 @@ private:
 	bool find_other_fleet(EditorGameBase& egbase);
 	bool merge(EditorGameBase& egbase, ShipFleet* other);
 	void check_merge_economy();
+	void routes_changed(RouteChange);
 	void connect_port(EditorGameBase& egbase, uint32_t idx);
 
 	PortPath& portpath(uint32_t i, uint32_t j);
 	const PortPath& portpath(uint32_t i, uint32_t j) const;
 	PortPath& portpath_bidir(uint32_t i, uint32_t j, bool& reverse);
 	const PortPath& portpath_bidir(uint32_t i, uint32_t j, bool& reverse) const;
+	[[nodiscard]] const PortPath* find_portpath(uint32_t i, uint32_t j) const;
 
 	std::vector<Ship*> ships_;
 	std::vector<ShipFleetYardInterface*> interfaces_;
@@ -167,6 +183,8 @@ private:
 
 	std::map<std::pair<Serial, Serial>, PortPath> port_paths_;
 
+	static std::atomic<bool> known_port_paths_only_;
+
 	ShippingSchedule schedule_;
 
 	// saving and loading
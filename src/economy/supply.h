@@ -78,6 +78,18 @@ struct Supply : public Trackable {
 	 */
 	virtual void get_ware_type(WareWorker& type, DescriptionIndex& ware) const = 0;
 
+	/**
+	 * Whether this supply can only ever provide wares of one single type, e.g.
+	 * because it is a ware lying on a flag. Economies use this to index their
+	 * supplies by ware type.
+	 *
+	 * \return \c true and the ware type in \p ware for such supplies, \c false
+	 * for supplies that can provide several types.
+	 */
+	virtual bool get_fixed_ware_type(DescriptionIndex& /* ware */) const {
+		return false;
+	}
+
 	/**
 	 * Send this to the given warehouse.
 	 *
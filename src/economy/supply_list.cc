@@ -19,6 +19,7 @@
 #include "economy/supply_list.h"
 
 #include <algorithm>
+#include <cassert>
 
 #include "base/wexception.h"
 #include "economy/request.h"
@@ -31,6 +32,16 @@ namespace Widelands {
  */
 void SupplyList::add_supply(Supply& supp) {
 	supplies_.push_back(&supp);
+
+	DescriptionIndex ware;
+	if (supp.get_fixed_ware_type(ware)) {
+		if (ware >= supplies_by_ware_.size()) {
+			supplies_by_ware_.resize(ware + 1);
+		}
+		supplies_by_ware_[ware].push_back(&supp);
+	} else {
+		mixed_supplies_.push_back(&supp);
+	}
 }
 
 /**
@@ -40,13 +51,25 @@ void SupplyList::remove_supply(Supply& supp) {
 	if (supplies_.empty()) {
 		throw wexception("SupplyList::remove: list is empty");
 	}
-	for (Supplies::iterator item_iter = supplies_.begin(); item_iter != supplies_.end();
+	remove_from(supplies_, supp);
+
+	DescriptionIndex ware;
+	if (supp.get_fixed_ware_type(ware)) {
+		assert(ware < supplies_by_ware_.size());
+		remove_from(supplies_by_ware_[ware], supp);
+	} else {
+		remove_from(mixed_supplies_, supp);
+	}
+}
+
+void SupplyList::remove_from(Supplies& supplies, Supply& supp) {
+	for (Supplies::iterator item_iter = supplies.begin(); item_iter != supplies.end();
 	     ++item_iter) {
 
 		if (*item_iter == &supp) {
 			// Copy last element to current positon, avoids shifts
-			*item_iter = *(supplies_.end() - 1);
-			supplies_.pop_back();
+			*item_iter = *(supplies.end() - 1);
+			supplies.pop_back();
 			return;
 		}
 		// no extra code for last element, copy will be a noop then
@@ -54,13 +77,26 @@ void SupplyList::remove_supply(Supply& supp) {
 	throw wexception("SupplyList::remove: not in list");
 }
 
+const SupplyList::Supplies* SupplyList::typed_supplies(const Request& req) const {
+	if (req.get_type() != wwWARE || req.get_index() >= supplies_by_ware_.size()) {
+		return nullptr;
+	}
+	return &supplies_by_ware_[req.get_index()];
+}
+
 /**
  * Return whether there is at least one available
  * supply that can match the given request.
  */
 bool SupplyList::have_supplies(const Game& game, const Request& req) {
-	return std::any_of(supplies_.begin(), supplies_.end(), [&game, &req](const Supply* supply) {
+	const auto can_supply = [&game, &req](const Supply* supply) {
 		return supply->nr_supplies(game, req) != 0u;
-	});
+	};
+	if (const Supplies* typed = typed_supplies(req)) {
+		if (std::any_of(typed->begin(), typed->end(), can_supply)) {
+			return true;
+		}
+	}
+	return std::any_of(mixed_supplies_.begin(), mixed_supplies_.end(), can_supply);
 }
 }  // namespace Widelands
@@ -22,6 +22,8 @@
 #include <cstddef>
 #include <vector>
 
+#include "logic/widelands.h"
+
 namespace Widelands {
 
 class Game;
@@ -30,6 +32,11 @@ struct Supply;
 
 /**
  * SupplyList is used in the Economy to keep track of supplies.
+ *
+ * Besides the list of all supplies, it keeps an index of the supplies that
+ * only provide a single ware type (see Supply::get_fixed_ware_type()), so that
+ * finding supplies for a request does not need to look at every ware on every
+ * flag of the economy.
  */
 struct SupplyList {
 	void add_supply(Supply&);
@@ -47,11 +54,35 @@ struct SupplyList {
 
 	bool have_supplies(const Game& game, const Request&);
 
+	/**
+	 * All supplies that might be able to fulfill the request: the ones of the
+	 * requested ware type are passed first, then the ones that can provide
+	 * several types.
+	 */
+	template <typename Callback> void for_each_candidate(const Request& req, Callback callback) {
+		if (const std::vector<Supply*>* typed = typed_supplies(req)) {
+			for (Supply* supply : *typed) {
+				callback(*supply);
+			}
+		}
+		for (Supply* supply : mixed_supplies_) {
+			callback(*supply);
+		}
+	}
+
 private:
+	[[nodiscard]] const std::vector<Supply*>* typed_supplies(const Request&) const;
+	static void remove_from(std::vector<Supply*>& supplies, Supply&);
+
 	// TODO(klaus-halfmann): try to use a Map or Set
 	// (-> keep in mind that the iteration order needs to be platform-independent though)
 	using Supplies = std::vector<Supply*>;
 	Supplies supplies_;
+
+	// Supplies with a fixed ware type, indexed by that type
+	std::vector<Supplies> supplies_by_ware_;
+	// All other supplies, e.g. warehouses and idle workers
+	Supplies mixed_supplies_;
 };
 }  // namespace Widelands
 
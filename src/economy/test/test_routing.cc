@@ -532,6 +532,8 @@ TESTCASE(find_long_route) {
 
 	// directly connect d0 -> d5
 	f.d0->add_neighbour(d5);
+	f.r.invalidate_cache();
+	f.r.invalidate_landmarks();
 
 	rval = f.r.find_route(*f.d0, *d5, &f.route, Widelands::wwWORKER, -1, f.cc);
 
@@ -582,6 +584,7 @@ TESTCASE(priced_routing) {
 
 	// Make the middle node on the short path very expensive
 	f.d1->set_waitcost(8);
+	f.r.invalidate_cache();
 
 	// Same result without wait
 	rval = f.r.find_route(*f.start, *f.end, &f.route, Widelands::wwWORKER, -1, f.cc);
@@ -613,6 +616,90 @@ TESTCASE(cutoff) {
 
 	check_equal(rval, false);
 }
+TESTCASE(route_cache) {
+	DistanceRoutingFixture f;
+	DistanceRoutingFixture::Nodes chain;
+	chain.push_back(f.start);
+	chain.push_back(f.d1);
+	chain.push_back(f.end);
+
+	Widelands::Router::reset_cache_statistics();
+	bool rval = f.r.find_route(*f.start, *f.end, &f.route, Widelands::wwWORKER, -1, f.cc);
+	check_equal(true, rval);
+	check_equal(Widelands::Router::cache_statistics().worker_misses, 1U);
+	check_equal(Widelands::Router::cache_statistics().worker_hits, 0U);
+
+	// The second query is answered from the cache with the same route
+	f.route.init(0);
+	rval = f.r.find_route(*f.start, *f.end, &f.route, Widelands::wwWORKER, -1, f.cc);
+	check_equal(true, rval);
+	check_equal(true, f.route.has_chain(chain));
+	check_equal(Widelands::Router::cache_statistics().worker_hits, 1U);
+
+	// The cost cutoff also applies to cached routes
+	rval = f.r.find_route(*f.start, *f.end, &f.route, Widelands::wwWORKER, 1, f.cc);
+	check_equal(false, rval);
+	check_equal(Widelands::Router::cache_statistics().worker_hits, 2U);
+
+	// A cached route within the cutoff does not answer the query, because a new
+	// search might give up early
+	f.route.init(0);
+	rval = f.r.find_route(*f.start, *f.end, &f.route, Widelands::wwWORKER, 10000, f.cc);
+	check_equal(true, rval);
+	check_equal(true, f.route.has_chain(chain));
+	check_equal(Widelands::Router::cache_statistics().worker_hits, 2U);
+	check_equal(Widelands::Router::cache_statistics().worker_misses, 2U);
+
+	// After invalidation, the route is searched again
+	f.r.invalidate_cache();
+	rval = f.r.find_route(*f.start, *f.end, nullptr, Widelands::wwWORKER, -1, f.cc);
+	check_equal(true, rval);
+	check_equal(Widelands::Router::cache_statistics().worker_misses, 3U);
+}
+TESTCASE(ware_routes_not_cached) {
+	DistanceRoutingFixture f;
+	DistanceRoutingFixture::Nodes chain;
+	chain.push_back(f.start);
+	chain.push_back(f.d1);
+	chain.push_back(f.end);
+
+	// Ware routes depend on the wares waiting at the flags, so every query is searched
+	Widelands::Router::reset_cache_statistics();
+	for (uint32_t i = 1; i <= 2; ++i) {
+		f.route.init(0);
+		bool rval = f.r.find_route(*f.start, *f.end, &f.route, Widelands::wwWARE, -1, f.cc);
+		check_equal(true, rval);
+		check_equal(true, f.route.has_chain(chain));
+		check_equal(Widelands::Router::cache_statistics().ware_misses, i);
+		check_equal(Widelands::Router::cache_statistics().ware_hits, 0U);
+	}
+	check_equal(Widelands::Router::cache_statistics().worker_misses, 0U);
+}
+TESTCASE(landmark_pruning) {
+	ComplexRouterFixture f;
+	ComplexRouterFixture::Nodes chain;
+
+	// Long enough for the router to use landmarks
+	Widelands::RoutingNode* end_node = f.add_chain(300, f.d0, &chain);
+
+	Widelands::Router::reset_cache_statistics();
+	bool rval = f.r.find_route(*f.d0, *end_node, &f.route, Widelands::wwWORKER, 1000, f.cc);
+	check_equal(rval, false);
+	check_equal(Widelands::Router::cache_statistics().pruned, 1U);
+
+	// Without landmarks, the search has the same result
+	Widelands::Router::set_landmarks_enabled(false);
+	rval = f.r.find_route(*f.d0, *end_node, &f.route, Widelands::wwWORKER, 1000, f.cc);
+	check_equal(rval, false);
+	check_equal(Widelands::Router::cache_statistics().pruned, 1U);
+	Widelands::Router::set_landmarks_enabled(true);
+
+	// The cutoff is not below the actual cost, so the route is found
+	rval = f.r.find_route(*f.d0, *end_node, &f.route, Widelands::wwWORKER, 300000, f.cc);
+	check_equal(rval, true);
+	check_equal(true, f.route.has_chain(chain));
+	check_equal(Widelands::Router::cache_statistics().pruned, 1U);
+}
 
 // }}}
 
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include "base/parallel_for.h"
+#include "base/test.h"
+#include "economy/portdock.h"
+#include "economy/routing_node.h"
+#include "economy/ship_fleet.h"
+#include "logic/map_objects/map_object.h"
+
+namespace {
+
+// The fleet of one player with two ports whose paths were never searched. The
+// docks have no warehouses, so searching a port path would crash.
+struct UnconnectedFleet {
+	explicit UnconnectedFleet(Widelands::ObjectManager& objects)
+	   : objects_(objects), fleet(nullptr), port_a(nullptr), port_b(nullptr) {
+		objects_.insert(&port_a);
+		objects_.insert(&port_b);
+		fleet.get_ports().push_back(&port_a);
+		fleet.get_ports().push_back(&port_b);
+	}
+	~UnconnectedFleet() {
+		objects_.remove(port_a);
+		objects_.remove(port_b);
+	}
+
+	Widelands::ObjectManager& objects_;
+	Widelands::ShipFleet fleet;
+	Widelands::PortDock port_a;
+	Widelands::PortDock port_b;
+};
+
+}  // namespace
+
+TESTSUITE_START(ship_fleet)
+
+TESTCASE(known_port_paths_do_not_search) {
+	Widelands::ObjectManager objects;
+	std::vector<std::unique_ptr<UnconnectedFleet>> players;
+	players.emplace_back(new UnconnectedFleet(objects));
+	players.emplace_back(new UnconnectedFleet(objects));
+
+	std::vector<std::vector<Widelands::RoutingNodeNeighbour>> neighbours(players.size());
+	{
+		Widelands::ShipFleet::ScopedKnownPortPaths known_port_paths;
+		parallel_for(players.size(), [&players, &neighbours](size_t i) {
+			players[i]->fleet.add_neighbours(players[i]->port_a, neighbours[i]);
+			players[i]->fleet.add_neighbours(players[i]->port_b, neighbours[i]);
+		});
+	}
+
+	for (size_t i = 0; i < players.size(); ++i) {
+		check_equal(neighbours[i].empty(), true);
+		check_equal(players[i]->fleet.has_unconnected_ports(), true);
+	}
+}
+
+TESTSUITE_END()
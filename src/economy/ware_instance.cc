@@ -57,6 +57,7 @@ struct IdleWareSupply : public Supply {
 	SupplyProviders provider_type(Game* /*game*/) const override;
 	[[nodiscard]] bool has_storage() const override;
 	void get_ware_type(WareWorker& type, DescriptionIndex& ware) const override;
+	bool get_fixed_ware_type(DescriptionIndex& ware) const override;
 	void send_to_storage(Game& /*game*/, Warehouse* wh) override;
 
 	[[nodiscard]] uint32_t nr_supplies(const Game& /* game */,
@@ -157,6 +158,11 @@ void IdleWareSupply::get_ware_type(WareWorker& type, DescriptionIndex& ware) con
 	ware = ware_.descr_index();
 }
 
+bool IdleWareSupply::get_fixed_ware_type(DescriptionIndex& ware) const {
+	ware = ware_.descr_index();
+	return true;
+}
+
 uint32_t IdleWareSupply::nr_supplies(const Game& /* game */, const Request& req) const {
 	if (req.get_type() == wwWARE && req.get_index() == ware_.descr_index()) {
 		return 1;
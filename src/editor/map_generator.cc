@@ -628,10 +628,10 @@ bool MapGenerator::create_random_map() {
 
 	//  Now we have generated a lot of random data!!
 	//  Lets use it !!!
-	iterate_Map_FCoords(map_, map_info_, fc) fc.field->set_height(
-	   make_node_elevation(static_cast<double>(elevations[fc.x + map_info_.w * fc.y]) /
-	                          static_cast<double>(kMaxElevation),
-	                       fc));
+	iterate_Map_FCoords(map_, map_info_, fc) map_.set_field_height(
+	   *fc.field, make_node_elevation(static_cast<double>(elevations[fc.x + map_info_.w * fc.y]) /
+	                                     static_cast<double>(kMaxElevation),
+	                                  fc));
 
 	//  Now lets set the terrain right according to the heights.
 
@@ -672,13 +672,17 @@ bool MapGenerator::create_random_map() {
 
 		MapGenAreaInfo::Terrain terrType;
 
-		fc.field->set_terrain_d(figure_out_terrain(
-		   random2.get(), random3.get(), random4.get(), fc, Coords(lower_x, lower_y),
-		   Coords(lower_right_x, lower_y), height_x0_y0, height_x0_y1, height_x1_y1, rng, terrType));
-
-		fc.field->set_terrain_r(figure_out_terrain(
-		   random2.get(), random3.get(), random4.get(), fc, Coords(right_x, fc.y),
-		   Coords(lower_right_x, lower_y), height_x0_y0, height_x1_y0, height_x1_y1, rng, terrType));
+		map_.set_field_terrain(
+		   *fc.field, TriangleIndex::D,
+		   figure_out_terrain(random2.get(), random3.get(), random4.get(), fc, Coords(lower_x, lower_y),
+		                      Coords(lower_right_x, lower_y), height_x0_y0, height_x0_y1,
+		                      height_x1_y1, rng, terrType));
+
+		map_.set_field_terrain(
+		   *fc.field, TriangleIndex::R,
+		   figure_out_terrain(random2.get(), random3.get(), random4.get(), fc, Coords(right_x, fc.y),
+		                      Coords(lower_right_x, lower_y), height_x0_y0, height_x1_y0,
+		                      height_x1_y1, rng, terrType));
 
 		//  set resources for this field
 		generate_resources(
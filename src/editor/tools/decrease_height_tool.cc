@@ -54,7 +54,7 @@ int32_t EditorDecreaseHeightTool::handle_undo_impl(const Widelands::NodeAndTrian
 	std::list<Widelands::Field::Height>::iterator i = args->original_heights.begin();
 
 	do {
-		mr.location().field->set_height(*i);
+		map->set_field_height(*mr.location().field, *i);
 		++i;
 	} while (mr.advance(*map));
 
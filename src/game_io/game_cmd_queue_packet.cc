@@ -64,8 +64,7 @@ void GameCmdQueuePacket::read(FileSystem& fs, Game& game, MapObjectLoader* const
 
 				item.cmd = &cmd;
 
-				cmdq.cmds_[cmd.duetime().get() % kCommandQueueBucketSize].push(item);
-				++cmdq.ncmds_;
+				cmdq.push(item);
 			}
 		} else {
 			throw UnhandledVersionError("GameCmdQueuePacket", packet_version, kCurrentPacketVersion);
@@ -77,7 +76,7 @@ void GameCmdQueuePacket::read(FileSystem& fs, Game& game, MapObjectLoader* const
 
 void GameCmdQueuePacket::write(FileSystem& fs, Game& game, MapObjectSaver* const os) {
 	// If the player would send a command while we're saving the queue,
-	// this function would get trapped in an endless loop.
+	// the queue would change while we're collecting its commands.
 	// So all new commands are put on hold until we're done here.
 	MutexLock m(MutexLock::ID::kCommands);
 
@@ -93,41 +92,18 @@ void GameCmdQueuePacket::write(FileSystem& fs, Game& game, MapObjectSaver* const
 	fw.unsigned_32(cmdq.nextserial_);
 
 	// Write all commands
+	for (const CmdQueue::CmdItem& item : cmdq.pending_commands()) {
+		if (upcast(GameLogicCommand, cmd, item.cmd)) {
+			// The id (aka command type)
+			fw.unsigned_16(static_cast<uint16_t>(cmd->id()));
 
-	// Find all the items in the current cmdqueue
-	Time time = game.get_gametime();
-	size_t nhandled = 0;
+			// Serial number
+			fw.signed_32(item.category);
+			fw.unsigned_32(item.serial);
 
-	while (nhandled < cmdq.ncmds_) {
-		// Make a copy, so we can pop stuff
-		std::priority_queue<CmdQueue::CmdItem> p = cmdq.cmds_[time.get() % kCommandQueueBucketSize];
-
-		while (!p.empty()) {
-			const CmdQueue::CmdItem& it = p.top();
-			if (it.cmd->duetime() > time) {
-				// Time is the primary sorting key, so we can't have any additional commands in this
-				// queue for this time
-				break;
-			}
-			if (it.cmd->duetime() == time) {
-				if (upcast(GameLogicCommand, cmd, it.cmd)) {
-					// The id (aka command type)
-					fw.unsigned_16(static_cast<uint16_t>(cmd->id()));
-
-					// Serial number
-					fw.signed_32(it.category);
-					fw.unsigned_32(it.serial);
-
-					// Now the command itself
-					cmd->write(fw, game, *os);
-				}
-				++nhandled;
-			}
-
-			// DONE: next command
-			p.pop();
+			// Now the command itself
+			cmd->write(fw, game, *os);
 		}
-		time.increment();
 	}
 
 	fw.unsigned_16(0);  // end of command queue
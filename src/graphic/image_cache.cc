@@ -21,6 +21,8 @@
 #include <cassert>
 #include <memory>
 
+#include <SDL_surface.h>
+
 #include "base/multithreading.h"
 #include "graphic/image.h"
 #include "graphic/image_io.h"
@@ -30,6 +32,40 @@
 
 ImageCache* g_image_cache;
 
+namespace {
+
+// Stands in for a texture when no OpenGL context is available.
+class PlaceholderImage : public Image {
+public:
+	PlaceholderImage(int w, int h)
+	   : w_(w), h_(h), blit_data_{0U, w, h, Rectf(0.f, 0.f, w, h)} {
+	}
+
+	[[nodiscard]] int width() const override {
+		return w_;
+	}
+	[[nodiscard]] int height() const override {
+		return h_;
+	}
+	[[nodiscard]] const BlitData& blit_data() const override {
+		return blit_data_;
+	}
+
+private:
+	const int w_;
+	const int h_;
+	const BlitData blit_data_;
+};
+
+std::unique_ptr<const Image> load_placeholder_image(const std::string& fn) {
+	SDL_Surface* surface = load_image_as_sdl_surface(fn);
+	std::unique_ptr<const Image> result(new PlaceholderImage(surface->w, surface->h));
+	SDL_FreeSurface(surface);
+	return result;
+}
+
+}  // namespace
+
 bool ImageCache::has(const std::string& hash) const {
 	return images_.count(hash) != 0u;
 }
@@ -81,7 +117,14 @@ const Image* ImageCache::get(std::string hash, const bool theme_lookup, const ui
 
 		if (it == images_.end()) {
 			NoteThreadSafeFunction::instantiate(
-			   [this, &hash]() { images_.insert(std::make_pair(hash, load_image(hash))); }, true);
+			   [this, &hash]() {
+				   if (headless_) {
+					   images_.insert(std::make_pair(hash, load_placeholder_image(hash)));
+				   } else {
+					   images_.insert(std::make_pair(hash, load_image(hash)));
+				   }
+			   },
+			   true);
 			it = images_.find(hash);
 			assert(it != images_.end());
 		}
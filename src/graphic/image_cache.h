@@ -64,7 +64,19 @@ public:
 	fill_with_texture_atlases(std::vector<std::unique_ptr<Texture>> texture_atlases,
 	                          std::map<std::string, std::unique_ptr<Texture>> textures_in_atlas);
 
+	// Without an OpenGL context (e.g. when simulating games headless), images can not
+	// be uploaded as textures. In that case, the cache hands out placeholders instead
+	// that know their dimensions but must never be drawn.
+	void set_headless(bool headless) {
+		headless_ = headless;
+	}
+	[[nodiscard]] bool is_headless() const {
+		return headless_;
+	}
+
 private:
+	bool headless_{false};
+
 	std::vector<std::unique_ptr<Texture>> texture_atlases_;
 	std::map<std::string, std::unique_ptr<const Image>> images_;
 	std::map<std::string, uint8_t /* scales bitset */> mipmap_cache_;
@@ -0,0 +1,373 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+// Runs one generation of AI training: many AI-only games, each in its own wl_headless process
+// with its own home directory and parent DNA, several of them at the same time. The DNA files
+// that the AIs wrote are then ranked by how well their players did, and the best ones are copied
+// to become the parents of the next generation.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/log.h"
+#include "base/macros.h"
+#include "base/math.h"
+#include "base/random.h"
+#include "base/string.h"
+#include "base/wexception.h"
+#include "headless/headless_common.h"
+#include "io/filesystem/disk_filesystem.h"
+#include "logic/filesystem_constants.h"
+
+namespace {
+
+constexpr uint32_t kDefaultDurationMinutes = 180;
+constexpr uint32_t kDefaultSeed = 1;
+// The AI picks its parents from the files ai_input_1 to ai_input_4
+constexpr uint32_t kParentSlots = 4;
+const std::string kDefaultWorkdir = "ai_training";
+const std::string kDefaultOutput = "ai_training.csv";
+const std::string kNextGenerationDir = "next_generation";
+const std::string kResultsFile = "results.csv";
+const std::string kLogFile = "wl_headless.log";
+
+void show_usage(const char* program) {
+	log_err("Usage: %s [options] --dna=DIRNAME <map> [<map> ...]\n"
+	        "\n"
+	        "Options:\n"
+	        " --dna=DIRNAME          Directory with the DNA files (*%s) to pick the parents from\n"
+	        " --datadir=DIRNAME      Use the specified directory for the Widelands data files\n"
+	        " --workdir=DIRNAME      Directory for the home directories of the games\n"
+	        "                        (default: %s)\n"
+	        " --games=NUMBER         Number of games to play, on the given maps in turn\n"
+	        "                        (default: twice the number of jobs)\n"
+	        " --jobs=NUMBER          Number of games to play at the same time\n"
+	        "                        (default: number of CPU cores)\n"
+	        " --duration=MINUTES     Amount of game time to simulate per game (default: %u)\n"
+	        " --seed=NUMBER          Random seed for picking the parents and for the games\n"
+	        "                        (default: %u)\n"
+	        " --headless=FILE        The wl_headless binary (default: the one next to this one)\n"
+	        " --output=FILE          Write the ranked results to this CSV file (default: %s)\n"
+	        "\n"
+	        "The CSV file has the columns rank,game,map,player,tribe,result,land,\n"
+	        "military_strength,productivity,dna. Players are ranked by their final land size,\n"
+	        "then by their military strength and productivity. The column dna contains the\n"
+	        "DNA file that the player's AI wrote at the start of its game. The best %u of them\n"
+	        "are copied to %s in the working directory, named like the files that\n"
+	        "the AI reads its parents from, so that this directory can be passed to --dna for\n"
+	        "the next generation.\n",
+	        program, kAiExtension.c_str(), kDefaultWorkdir.c_str(), kDefaultDurationMinutes,
+	        kDefaultSeed, kDefaultOutput.c_str(), kParentSlots, kNextGenerationDir.c_str());
+}
+
+struct TrainingGame {
+	uint32_t number;
+	std::string map;
+	// Relative to the working directory
+	std::string directory;
+	std::string command;
+	int exit_code{-1};
+};
+
+struct PlayerResult {
+	uint32_t game;
+	std::string map;
+	uint32_t player;
+	std::string tribe;
+	std::string result;
+	uint32_t land;
+	uint32_t military_strength;
+	uint32_t productivity;
+	// Relative to the working directory, empty if the AI did not write its DNA
+	std::string dna;
+};
+
+std::string parent_filename(uint32_t slot) {
+	return format("ai_input_%u%s", slot, kAiExtension);
+}
+
+void copy_file(FileSystem& from,
+               const std::string& source,
+               FileSystem& to,
+               const std::string& dest) {
+	size_t length = 0U;
+	void* data = from.load(source, length);
+	to.write(dest, data, length);
+	free(data);
+}
+
+// Quotes a command line argument for the shell
+std::string quote(const std::string& argument) {
+#ifdef _WIN32
+	// Double quotes cannot be part of a file name on Windows
+	return "\"" + argument + "\"";
+#else
+	// Nothing is special between single quotes, so only single quotes need to be escaped by
+	// closing the quotes, adding an escaped quote and opening them again
+	std::string quoted = "'";
+	for (const char c : argument) {
+		if (c == '\'') {
+			quoted += "'\\''";
+		} else {
+			quoted += c;
+		}
+	}
+	return quoted + "'";
+#endif
+}
+
+// Creates the game's home directory with randomly picked parents, and the command that plays it
+TrainingGame prepare_game(uint32_t const number,
+                          const std::string& map,
+                          const std::vector<std::string>& dna_pool,
+                          RNG& rng,
+                          FileSystem& dna_fs,
+                          FileSystem& work_fs,
+                          const std::string& workdir,
+                          const std::map<std::string, std::string>& args) {
+	TrainingGame game{number, map, format("game_%03u", number), "", -1};
+	const std::string ai_dir = game.directory + FileSystem::file_separator() + kAiDir;
+	work_fs.ensure_directory_exists(ai_dir);
+	for (uint32_t slot = 1; slot <= kParentSlots; ++slot) {
+		copy_file(dna_fs, dna_pool[rng.rand() % dna_pool.size()], work_fs,
+		          ai_dir + FileSystem::file_separator() + parent_filename(slot));
+	}
+
+	const std::string homedir = workdir + FileSystem::file_separator() + game.directory;
+	game.command = quote(args.at("headless"));
+	if (args.count("datadir") != 0) {
+		game.command += " --datadir=" + quote(args.at("datadir"));
+	}
+	game.command += format(
+	   " --homedir=%s --duration=%s --seed=%u --ai_training --results=%s %s > %s 2>&1",
+	   quote(homedir), quote(args.at("duration")), rng.rand() % 1000000 + 1,
+	   quote(homedir + FileSystem::file_separator() + kResultsFile), quote(map),
+	   quote(homedir + FileSystem::file_separator() + kLogFile));
+#ifdef _WIN32
+	// cmd.exe strips the first and the last quote of the whole command
+	game.command = quote(game.command);
+#endif
+	return game;
+}
+
+// Plays the games, 'jobs' of them at the same time
+void play_games(std::vector<TrainingGame>& games, uint32_t const jobs) {
+	std::atomic<size_t> next_game(0U);
+	std::mutex log_mutex;
+	const auto play = [&games, &next_game, &log_mutex]() {
+		for (size_t i = next_game++; i < games.size(); i = next_game++) {
+			games[i].exit_code = std::system(games[i].command.c_str());
+			std::lock_guard<std::mutex> guard(log_mutex);
+			log_info("Game %u on %s finished with exit code %d\n", games[i].number,
+			         games[i].map.c_str(), games[i].exit_code);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (uint32_t i = 1; i < jobs; ++i) {
+		threads.emplace_back(play);
+	}
+	play();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+// Reads the results that wl_headless wrote for the game, and finds the DNA files of its players
+void collect_results(const TrainingGame& game,
+                     FileSystem& work_fs,
+                     std::vector<PlayerResult>* results) {
+	const std::string results_file = game.directory + FileSystem::file_separator() + kResultsFile;
+	if (game.exit_code != 0 || !work_fs.file_exists(results_file)) {
+		log_warn("Game %u on %s has no results, see %s\n", game.number, game.map.c_str(),
+		         (game.directory + FileSystem::file_separator() + kLogFile).c_str());
+		return;
+	}
+
+	size_t length = 0U;
+	char* data = static_cast<char*>(work_fs.load(results_file, length));
+	std::vector<std::string> lines;
+	split(lines, std::string(data, length), {'\n'});
+	free(data);
+
+	// The columns are looked up by name in the header line
+	std::map<std::string, size_t> columns;
+	std::vector<std::string> header;
+	split(header, lines.front(), {','});
+	for (size_t i = 0; i < header.size(); ++i) {
+		columns[header[i]] = i;
+	}
+	const FilenameSet dna_files =
+	   work_fs.list_directory(game.directory + FileSystem::file_separator() + kAiDir);
+
+	for (size_t line = 1; line < lines.size(); ++line) {
+		std::vector<std::string> values;
+		split(values, lines[line], {','});
+		if (values.size() != header.size()) {
+			continue;
+		}
+		const auto value = [&values, &columns](const std::string& column) {
+			return values.at(columns.at(column));
+		};
+		PlayerResult result{game.number,
+		                    game.map,
+		                    static_cast<uint32_t>(math::to_int(value("player"))),
+		                    value("tribe"),
+		                    value("result"),
+		                    static_cast<uint32_t>(math::to_int(value("land"))),
+		                    static_cast<uint32_t>(math::to_int(value("military_strength"))),
+		                    static_cast<uint32_t>(math::to_int(value("productivity"))),
+		                    ""};
+		// The AI names its DNA file after the time and its player number. The names sort by time,
+		// so the last one is the newest.
+		const std::string suffix = format("_ai_player_%u%s", result.player, kAiExtension);
+		for (const std::string& filename : dna_files) {
+			if (ends_with(filename, suffix)) {
+				result.dna = filename;
+			}
+		}
+		results->push_back(result);
+	}
+}
+
+bool write_ranking(const std::vector<PlayerResult>& results, const std::string& output) {
+	std::ofstream out(output);
+	if (!out.good()) {
+		log_err("Unable to open %s for writing\n", output.c_str());
+		return false;
+	}
+	out << "rank,game,map,player,tribe,result,land,military_strength,productivity,dna\n";
+	for (size_t i = 0; i < results.size(); ++i) {
+		const PlayerResult& r = results[i];
+		out << format("%u,%u,%s,%u,%s,%s,%u,%u,%u,%s\n", static_cast<unsigned>(i + 1), r.game,
+		              r.map, r.player, r.tribe, r.result, r.land, r.military_strength,
+		              r.productivity, r.dna);
+	}
+	return out.good();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	std::map<std::string, std::string> args;
+	std::vector<std::string> maps;
+	if (!parse_headless_arguments(argc, argv, &args, &maps) || maps.empty() ||
+	    args.count("dna") == 0 || args.count("help") != 0) {
+		show_usage(argv[0]);
+		return 1;
+	}
+
+	uint32_t jobs = std::max(1U, std::thread::hardware_concurrency());
+	uint32_t duration_minutes = kDefaultDurationMinutes;
+	uint32_t seed = kDefaultSeed;
+	if (!read_natural_argument(args, "jobs", &jobs) ||
+	    !read_natural_argument(args, "duration", &duration_minutes) ||
+	    !read_natural_argument(args, "seed", &seed)) {
+		return 1;
+	}
+	uint32_t nr_games = 2 * jobs;
+	if (!read_natural_argument(args, "games", &nr_games)) {
+		return 1;
+	}
+	args["duration"] = std::to_string(duration_minutes);
+	if (args.count("headless") == 0) {
+		args["headless"] = FileSystem::fs_dirname(argv[0]) + "wl_headless";
+#ifdef _WIN32
+		args["headless"] += ".exe";
+#endif
+	}
+	const std::string workdir = args.count("workdir") != 0 ? args.at("workdir") : kDefaultWorkdir;
+	const std::string output = args.count("output") != 0 ? args.at("output") : kDefaultOutput;
+
+	try {
+		RealFSImpl dna_fs(args.at("dna"));
+		std::vector<std::string> dna_pool;
+		for (const std::string& filename : dna_fs.list_directory("")) {
+			if (ends_with(filename, kAiExtension)) {
+				dna_pool.push_back(filename);
+			}
+		}
+		if (dna_pool.empty()) {
+			log_err("No DNA files (*%s) found in %s\n", kAiExtension.c_str(),
+			        args.at("dna").c_str());
+			return 1;
+		}
+
+		RealFSImpl work_fs(workdir);
+		work_fs.ensure_directory_exists(".");
+		RNG rng(seed);
+		std::vector<TrainingGame> games;
+		for (uint32_t i = 0; i < nr_games; ++i) {
+			games.push_back(prepare_game(
+			   i + 1, maps[i % maps.size()], dna_pool, rng, dna_fs, work_fs, workdir, args));
+		}
+
+		log_info("Playing %u games with %" PRIuS " parent DNA files, %u at a time\n", nr_games,
+		         dna_pool.size(), std::min(jobs, nr_games));
+		play_games(games, std::min(jobs, nr_games));
+
+		std::vector<PlayerResult> results;
+		for (const TrainingGame& game : games) {
+			collect_results(game, work_fs, &results);
+		}
+		// Ties are broken by the game and player, so that the ranking does not depend on the order
+		// the games finished in
+		std::sort(results.begin(), results.end(), [](const PlayerResult& a, const PlayerResult& b) {
+			if (a.land != b.land) {
+				return a.land > b.land;
+			}
+			if (a.military_strength != b.military_strength) {
+				return a.military_strength > b.military_strength;
+			}
+			if (a.productivity != b.productivity) {
+				return a.productivity > b.productivity;
+			}
+			return a.game != b.game ? a.game < b.game : a.player < b.player;
+		});
+		if (!write_ranking(results, output)) {
+			return 1;
+		}
+
+		work_fs.ensure_directory_exists(kNextGenerationDir);
+		uint32_t slot = 0U;
+		for (const PlayerResult& result : results) {
+			if (slot == kParentSlots) {
+				break;
+			}
+			if (result.dna.empty()) {
+				continue;
+			}
+			++slot;
+			copy_file(work_fs, result.dna, work_fs,
+			          kNextGenerationDir + FileSystem::file_separator() + parent_filename(slot));
+			log_info("Parent %u of the next generation: %s (game %u, player %u, land %u)\n", slot,
+			         result.dna.c_str(), result.game, result.player, result.land);
+		}
+	} catch (std::exception& e) {
+		log_err("Exception: %s.\n", e.what());
+		return 1;
+	}
+	return 0;
+}
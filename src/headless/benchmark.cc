@@ -0,0 +1,626 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+// Simulates a fixed amount of game time on a set of maps or savegames with
+// fixed random seeds, and writes the wall time spent per simulation subsystem
+// and per command type as CSV, so that the results of different builds can be
+// compared.
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ai/ai_help_structs.h"
+#include "base/log.h"
+#include "base/macros.h"
+#include "base/random.h"
+#include "base/simulation_profiler.h"
+#include "base/string.h"
+#include "config.h"
+#include "economy/router.h"
+#include "headless/headless_common.h"
+#include "logic/game.h"
+#include "logic/map.h"
+#include "logic/map_objects/descriptions.h"
+#include "logic/map_objects/tribes/production_program.h"
+#include "logic/map_objects/tribes/productionsite.h"
+#include "logic/map_objects/tribes/worker_descr.h"
+#include "logic/map_objects/tribes/worker_program.h"
+#include "logic/mapregion.h"
+#include "logic/pathfield.h"
+#include "logic/player.h"
+#include "logic/queue_cmd_ids.h"
+
+namespace {
+
+constexpr uint32_t kDefaultDurationMinutes = 30;
+constexpr uint32_t kDefaultStepMs = 100;
+constexpr uint32_t kDefaultSeed = 1;
+constexpr uint32_t kMapPassRepetitions = 100;
+constexpr uint32_t kVisionSeersPerPlayer = 500;
+constexpr uint32_t kVisionSteps = 20;
+const std::string kDefaultOutput = "wl_benchmark.csv";
+const std::string kWinCondition = "scripting/win_conditions/endless_game.lua";
+
+void show_usage(const char* program) {
+	log_err("Usage: %s [options] <map or savegame> [<map or savegame> ...]\n"
+	        "\n"
+	        "Options:\n"
+	        " --datadir=DIRNAME      Use the specified directory for the Widelands data files\n"
+	        " --homedir=DIRNAME      Use the specified directory for Widelands config files\n"
+	        "                        and AI files\n"
+	        " --duration=MINUTES     Amount of game time to simulate per map (default: %u)\n"
+	        " --step=MS              Game time advanced per simulation step (default: %u)\n"
+	        " --seed=NUMBER          Random seed for the game logic and the AI (default: %u)\n"
+	        " --output=FILE          Write the results to this CSV file (default: %s)\n"
+	        " --no_landmarks         Do not use landmarks to skip hopeless route searches\n"
+	        " --concurrent_ai        Let the AIs think on several threads at the same time\n"
+	        "\n"
+	        "The CSV file has the columns map,kind,name,calls,value. Rows of kind 'total'\n"
+	        "contain the load time, the simulation time and the simulated game time in seconds.\n"
+	        "Rows of kind 'section', 'command' and 'ai_task' contain the inclusive wall time\n"
+	        "in seconds spent in a simulation subsystem, in executing a type of command or in\n"
+	        "a type of AI job, summed over all AIs. Rows of kind 'counter' contain a count\n"
+	        "in the calls column and its share of all lookups;\n"
+	        "for path searches, the value is the searches per second of simulation, the\n"
+	        "nodes expanded per search or the share of searches that used a local window;\n"
+	        "for the AI's counts of land around buildable fields, the value is the share of\n"
+	        "lookups answered without a search or the nodes updated from notes per lookup.\n"
+	        "Rows of kind 'map_pass' contain the wall time in seconds for whole-map passes\n"
+	        "over the loaded map, reading either the Fields or the map's separate layers.\n"
+	        "Rows of kind 'vision' contain the wall time in seconds for walking many units\n"
+	        "across the map at the end of the simulation, with their vision updated node by\n"
+	        "node or area by area.\n"
+	        "Rows of kind 'programs' contain the wall time in seconds for looking up the\n"
+	        "programs, resources and attributes that all loaded programs refer to, either by\n"
+	        "name or through the references resolved when the programs were parsed.\n",
+	        program, kDefaultDurationMinutes, kDefaultStepMs, kDefaultSeed, kDefaultOutput.c_str());
+}
+
+std::string command_name(uint8_t id) {
+	using Widelands::QueueCommandTypes;
+	switch (static_cast<QueueCommandTypes>(id)) {
+	case QueueCommandTypes::kDestroyMapObject:
+		return "destroy_map_object";
+	case QueueCommandTypes::kAct:
+		return "act";
+	case QueueCommandTypes::kIncorporate:
+		return "incorporate";
+	case QueueCommandTypes::kLuaScript:
+		return "lua_script";
+	case QueueCommandTypes::kLuaCoroutine:
+		return "lua_coroutine";
+	case QueueCommandTypes::kCalculateStatistics:
+		return "calculate_statistics";
+	case QueueCommandTypes::kCallEconomyBalance:
+		return "call_economy_balance";
+	case QueueCommandTypes::kDeleteMessage:
+		return "delete_message";
+	case QueueCommandTypes::kNetCheckSync:
+		return "net_check_sync";
+	default:
+		// Player commands and rarely used commands are only listed by their ID
+		return format("command_%u", static_cast<unsigned>(id));
+	}
+}
+
+std::string ai_task_name(uint8_t id) {
+	using AI::SchedulerTaskId;
+	switch (static_cast<SchedulerTaskId>(id)) {
+	case SchedulerTaskId::kBbuildableFieldsCheck:
+		return "buildable_fields_check";
+	case SchedulerTaskId::kMineableFieldsCheck:
+		return "mineable_fields_check";
+	case SchedulerTaskId::kRoadCheck:
+		return "road_check";
+	case SchedulerTaskId::kUnbuildableFCheck:
+		return "unbuildable_fields_check";
+	case SchedulerTaskId::kCheckEconomies:
+		return "check_economies";
+	case SchedulerTaskId::kProductionsitesStats:
+		return "productionsites_stats";
+	case SchedulerTaskId::kConstructBuilding:
+		return "construct_building";
+	case SchedulerTaskId::kCheckProductionsites:
+		return "check_productionsites";
+	case SchedulerTaskId::kCheckShips:
+		return "check_ships";
+	case SchedulerTaskId::KMarineDecisions:
+		return "marine_decisions";
+	case SchedulerTaskId::kCheckMines:
+		return "check_mines";
+	case SchedulerTaskId::kWareReview:
+		return "ware_review";
+	case SchedulerTaskId::kPrintStats:
+		return "print_stats";
+	case SchedulerTaskId::kCheckMilitarysites:
+		return "check_militarysites";
+	case SchedulerTaskId::kCheckTrainingsites:
+		return "check_trainingsites";
+	case SchedulerTaskId::kCountMilitaryVacant:
+		return "count_military_vacant";
+	case SchedulerTaskId::kCheckEnemySites:
+		return "check_enemy_sites";
+	case SchedulerTaskId::kManagementUpdate:
+		return "management_update";
+	case SchedulerTaskId::kUpdateStats:
+		return "update_stats";
+	case SchedulerTaskId::kWarehouseFlagDist:
+		return "warehouse_flag_distances";
+	case SchedulerTaskId::kDiplomacy:
+		return "diplomacy";
+	default:
+		return format("ai_task_%u", static_cast<unsigned>(id));
+	}
+}
+
+void write_row(std::ostream& out,
+               const std::string& map,
+               const std::string& kind,
+               const std::string& name,
+               uint64_t calls,
+               double value) {
+	out << map << ',' << kind << ',' << name << ',' << calls << ',' << format("%.6f", value)
+	    << '\n';
+}
+
+double to_seconds(uint64_t nanoseconds) {
+	return nanoseconds / 1e9;
+}
+
+// Runs a pass (e.g. over the whole map) repeatedly and returns the wall time in seconds. The pass
+// returns a checksum, so that the compiler cannot optimize it away.
+template <typename Pass> double time_map_pass(const Pass& pass, uint64_t* checksum) {
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < kMapPassRepetitions; ++i) {
+		*checksum += pass();
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Compares whole-map passes that read the Fields with the same passes reading
+// the map's layers.
+void benchmark_map_passes(const Widelands::Map& map,
+                          const std::string& filename,
+                          std::ostream& out) {
+	using Widelands::Field;
+	using Widelands::MapIndex;
+	const MapIndex size = map.max_index();
+	const Widelands::MapLayers& layers = map.layers();
+
+	struct MapPass {
+		std::string name;
+		std::function<uint64_t()> fields;
+		std::function<uint64_t()> layers;
+	};
+	const std::vector<MapPass> passes = {
+	   {"heights",
+	    [&map, size]() {
+		    uint64_t sum = 0;
+		    for (MapIndex i = 0; i < size; ++i) {
+			    sum += map[i].get_height();
+		    }
+		    return sum;
+	    },
+	    [&layers, size]() {
+		    uint64_t sum = 0;
+		    for (MapIndex i = 0; i < size; ++i) {
+			    sum += layers.heights[i];
+		    }
+		    return sum;
+	    }},
+	   {"buildable",
+	    [&map, size]() {
+		    uint64_t count = 0;
+		    for (MapIndex i = 0; i < size; ++i) {
+			    count += (map[i].nodecaps() & Widelands::BUILDCAPS_SIZEMASK) != 0 ? 1 : 0;
+		    }
+		    return count;
+	    },
+	    [&layers, size]() {
+		    uint64_t count = 0;
+		    for (MapIndex i = 0; i < size; ++i) {
+			    count += (layers.caps[i] & Widelands::BUILDCAPS_SIZEMASK) != 0 ? 1 : 0;
+		    }
+		    return count;
+	    }},
+	   {"terrains",
+	    [&map, size]() {
+		    uint64_t sum = 0;
+		    for (MapIndex i = 0; i < size; ++i) {
+			    const Field::Terrains terrains = map[i].get_terrains();
+			    sum += terrains.d + terrains.r;
+		    }
+		    return sum;
+	    },
+	    [&layers, size]() {
+		    uint64_t sum = 0;
+		    for (MapIndex i = 0; i < size; ++i) {
+			    sum += layers.terrains[i].d + layers.terrains[i].r;
+		    }
+		    return sum;
+	    }},
+	   {"owned",
+	    [&map, size]() {
+		    uint64_t count = 0;
+		    for (MapIndex i = 0; i < size; ++i) {
+			    count += map[i].get_owned_by() != Widelands::neutral() ? 1 : 0;
+		    }
+		    return count;
+	    },
+	    [&layers, size]() {
+		    uint64_t count = 0;
+		    for (MapIndex i = 0; i < size; ++i) {
+			    count += layers.owners[i] != Widelands::neutral() ? 1 : 0;
+		    }
+		    return count;
+	    }},
+	   {"resources",
+	    [&map, size]() {
+		    uint64_t sum = 0;
+		    for (MapIndex i = 0; i < size; ++i) {
+			    sum += map[i].get_resources_amount();
+		    }
+		    return sum;
+	    },
+	    [&layers, size]() {
+		    uint64_t sum = 0;
+		    for (MapIndex i = 0; i < size; ++i) {
+			    sum += layers.resource_amounts[i];
+		    }
+		    return sum;
+	    }},
+	};
+
+	for (const MapPass& pass : passes) {
+		uint64_t fields_checksum = 0;
+		uint64_t layers_checksum = 0;
+		const double fields_seconds = time_map_pass(pass.fields, &fields_checksum);
+		const double layers_seconds = time_map_pass(pass.layers, &layers_checksum);
+		if (fields_checksum != layers_checksum) {
+			log_warn("%s: map layers are out of sync with the fields in pass '%s'\n",
+			         filename.c_str(), pass.name.c_str());
+		}
+		write_row(out, filename, "map_pass", pass.name + "_fields", kMapPassRepetitions,
+		          fields_seconds);
+		write_row(out, filename, "map_pass", pass.name + "_layers", kMapPassRepetitions,
+		          layers_seconds);
+	}
+}
+
+// Walks many units that see like soldiers and ships across the map, once updating
+// the players' vision with see_node()/unsee_node() for each node of the areas,
+// like it used to be done, and once with see_area()/unsee_area(). Afterwards, all
+// units stop seeing, so the vision counts are the same as before.
+void benchmark_vision(Widelands::Game& game,
+                      const std::string& filename,
+                      uint32_t seed,
+                      std::ostream& out) {
+	using Widelands::Area;
+	using Widelands::FCoords;
+	using Widelands::MapIndex;
+	const Widelands::Map& map = game.map();
+
+	struct Seer {
+		Widelands::Player* player;
+		Area<FCoords> area;
+	};
+	const auto update_nodes = [&map](Widelands::Player& player, const Area<FCoords>& area,
+	                                 bool see) {
+		Widelands::MapRegion<Area<FCoords>> mr(map, area);
+		do {
+			const MapIndex i = mr.location().field - &map[0];
+			if (see) {
+				player.see_node(i);
+			} else {
+				player.unsee_node(i);
+			}
+		} while (mr.advance(map));
+	};
+	const auto update_areas = [](Widelands::Player& player, const Area<FCoords>& area, bool see) {
+		if (see) {
+			player.see_area(area);
+		} else {
+			player.unsee_area(area);
+		}
+	};
+
+	const auto run = [&game, &map, seed](const auto& update) {
+		RNG rng(seed);
+		std::vector<Seer> seers;
+		iterate_players_existing(p, map.get_nrplayers(), game, player) {
+			for (uint32_t i = 0; i < kVisionSeersPerPlayer; ++i) {
+				const FCoords position = map.get_fcoords(Widelands::Coords(
+				   rng.rand() % map.get_width(), rng.rand() % map.get_height()));
+				// Soldiers see 2 or 3 nodes far, ships 4
+				seers.push_back({player, Area<FCoords>(position, 2 + rng.rand() % 3)});
+				update(*player, seers.back().area, true);
+			}
+		}
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32_t step = 0; step < kVisionSteps; ++step) {
+			for (Seer& seer : seers) {
+				// Like a walking bob, see the new area before unseeing the old one
+				const Area<FCoords> old_area = seer.area;
+				map.get_neighbour(old_area, Widelands::FIRST_DIRECTION + rng.rand() % 6, &seer.area);
+				update(*seer.player, seer.area, true);
+				update(*seer.player, old_area, false);
+			}
+		}
+		const double seconds =
+		   std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		for (const Seer& seer : seers) {
+			update(*seer.player, seer.area, false);
+		}
+		return std::make_pair(seers.size() * kVisionSteps, seconds);
+	};
+
+	const auto nodes = run(update_nodes);
+	const auto areas = run(update_areas);
+	write_row(out, filename, "vision", "nodes", nodes.first, nodes.second);
+	write_row(out, filename, "vision", "areas", areas.first, areas.second);
+}
+
+// Compares looking up the programs, resources and attributes that the programs of all
+// loaded productionsites and workers refer to by name, like it used to be done whenever
+// an action ran, with reading the references that are resolved when parsing the programs.
+void benchmark_programs(const Widelands::Descriptions& descriptions,
+                        const std::string& filename,
+                        std::ostream& out) {
+	std::vector<std::pair<const Widelands::ProductionSiteDescr*, std::string>> program_names;
+	std::vector<const Widelands::ProductionProgram*> programs;
+	std::vector<std::string> resource_names;
+	std::vector<Widelands::DescriptionIndex> resources;
+	std::vector<std::string> attribute_names;
+	std::vector<uint32_t> attributes;
+
+	for (Widelands::DescriptionIndex i = 0; i < descriptions.nr_buildings(); ++i) {
+		upcast(const Widelands::ProductionSiteDescr, productionsite,
+		       descriptions.get_building_descr(i));
+		if (productionsite == nullptr) {
+			continue;
+		}
+		for (const auto& program : productionsite->programs()) {
+			for (size_t ip = 0; ip < program.second->size(); ++ip) {
+				upcast(const Widelands::ProductionProgram::ActCall, act_call, &(*program.second)[ip]);
+				if (act_call != nullptr) {
+					program_names.emplace_back(productionsite, act_call->program_name());
+					programs.push_back(act_call->program());
+				}
+			}
+		}
+	}
+	for (Widelands::DescriptionIndex i = 0; i < descriptions.nr_workers(); ++i) {
+		for (const auto& program : descriptions.get_worker_descr(i)->programs()) {
+			for (const auto& action : program.second->actions()) {
+				if (action.dparam1 != Widelands::INVALID_INDEX) {
+					resource_names.push_back(action.sparam1);
+					resources.push_back(action.dparam1);
+				}
+				for (size_t a = 0; a < action.iparamv.size(); ++a) {
+					attribute_names.push_back(action.sparamv.at(a));
+					attributes.push_back(action.iparamv.at(a));
+				}
+			}
+		}
+	}
+
+	const auto by_name = [&]() {
+		uint64_t sum = 0;
+		for (const auto& program_name : program_names) {
+			sum += program_name.first->get_program(program_name.second)->size();
+		}
+		for (const std::string& name : resource_names) {
+			sum += descriptions.resource_index(name);
+		}
+		for (const std::string& name : attribute_names) {
+			sum += Widelands::MapObjectDescr::get_attribute_id(name);
+		}
+		return sum;
+	};
+	const auto resolved = [&]() {
+		uint64_t sum = 0;
+		for (const Widelands::ProductionProgram* program : programs) {
+			sum += program->size();
+		}
+		for (const Widelands::DescriptionIndex resource : resources) {
+			sum += resource;
+		}
+		for (const uint32_t attribute : attributes) {
+			sum += attribute;
+		}
+		return sum;
+	};
+
+	uint64_t by_name_checksum = 0;
+	uint64_t resolved_checksum = 0;
+	const double by_name_seconds = time_map_pass(by_name, &by_name_checksum);
+	const double resolved_seconds = time_map_pass(resolved, &resolved_checksum);
+	if (by_name_checksum != resolved_checksum) {
+		log_warn("%s: resolved program references differ from the names\n", filename.c_str());
+	}
+
+	const uint64_t lookups =
+	   static_cast<uint64_t>(program_names.size() + resource_names.size() + attribute_names.size()) *
+	   kMapPassRepetitions;
+	write_row(out, filename, "programs", "by_name", lookups, by_name_seconds);
+	write_row(out, filename, "programs", "resolved", lookups, resolved_seconds);
+}
+
+bool run_benchmark(const std::string& filename,
+                   uint32_t duration_minutes,
+                   uint32_t step_ms,
+                   uint32_t seed,
+                   bool concurrent_ai,
+                   std::ostream& out) {
+	try {
+		// The AI draws from the static random number generator
+		RNG::static_seed(seed);
+		SimulationProfiler::reset();
+
+		Widelands::Game game;
+		game.logic_rand_seed(seed);
+
+		const auto load_start = std::chrono::steady_clock::now();
+		game.init_headless(filename, kWinCondition, Duration(step_ms), concurrent_ai);
+		const auto load_end = std::chrono::steady_clock::now();
+
+		benchmark_map_passes(game.map(), filename, out);
+		benchmark_programs(game.descriptions(), filename, out);
+		const auto simulation_start = std::chrono::steady_clock::now();
+
+		// Loading is not part of the subsystem measurements
+		SimulationProfiler::reset();
+		Widelands::Router::reset_cache_statistics();
+		Widelands::PathfieldManager::reset_search_statistics();
+		AI::FieldFeatureGrid::reset_statistics();
+		SimulationProfiler::set_enabled(true);
+		const Time start_time = game.get_gametime();
+		game.run_headless(start_time + Duration(duration_minutes * 60 * 1000));
+		SimulationProfiler::set_enabled(false);
+		const auto run_end = std::chrono::steady_clock::now();
+		benchmark_vision(game, filename, seed, out);
+
+		const double load_seconds = std::chrono::duration<double>(load_end - load_start).count();
+		const double run_seconds =
+		   std::chrono::duration<double>(run_end - simulation_start).count();
+		const double game_seconds = (game.get_gametime() - start_time).get() / 1000.0;
+		log_info("%s: simulated %.0f game seconds in %.2f s\n", filename.c_str(), game_seconds,
+		         run_seconds);
+
+		write_row(out, filename, "total", "load", 1, load_seconds);
+		write_row(out, filename, "total", "simulation", 1, run_seconds);
+		write_row(out, filename, "total", "game_time", 1, game_seconds);
+		for (unsigned i = 0; i < SimulationProfiler::kNumberOfSections; ++i) {
+			const auto section = static_cast<SimulationProfiler::Section>(i);
+			const SimulationProfiler::Sample& sample = SimulationProfiler::get(section);
+			write_row(out, filename, "section", SimulationProfiler::to_string(section), sample.calls,
+			          to_seconds(sample.nanoseconds));
+		}
+		const Widelands::Router::CacheStatistics route_cache = Widelands::Router::cache_statistics();
+		const uint64_t ware_lookups = route_cache.ware_hits + route_cache.ware_misses;
+		const uint64_t worker_lookups = route_cache.worker_hits + route_cache.worker_misses;
+		const uint64_t route_lookups = ware_lookups + worker_lookups;
+		write_row(out, filename, "counter", "route_cache_ware_hits", route_cache.ware_hits,
+		          ware_lookups > 0 ? static_cast<double>(route_cache.ware_hits) / ware_lookups : 0.0);
+		write_row(out, filename, "counter", "route_cache_ware_misses", route_cache.ware_misses,
+		          ware_lookups > 0 ? static_cast<double>(route_cache.ware_misses) / ware_lookups : 0.0);
+		write_row(
+		   out, filename, "counter", "route_cache_worker_hits", route_cache.worker_hits,
+		   worker_lookups > 0 ? static_cast<double>(route_cache.worker_hits) / worker_lookups : 0.0);
+		write_row(
+		   out, filename, "counter", "route_cache_worker_misses", route_cache.worker_misses,
+		   worker_lookups > 0 ? static_cast<double>(route_cache.worker_misses) / worker_lookups : 0.0);
+		write_row(out, filename, "counter", "route_searches_pruned", route_cache.pruned,
+		          route_lookups > 0 ? static_cast<double>(route_cache.pruned) / route_lookups : 0.0);
+		const Widelands::PathfieldManager::SearchStatistics paths =
+		   Widelands::PathfieldManager::search_statistics();
+		write_row(out, filename, "counter", "path_searches", paths.searches,
+		          run_seconds > 0.0 ? paths.searches / run_seconds : 0.0);
+		write_row(out, filename, "counter", "path_nodes_expanded", paths.nodes_expanded,
+		          paths.searches > 0 ? static_cast<double>(paths.nodes_expanded) / paths.searches :
+		                               0.0);
+		write_row(out, filename, "counter", "path_searches_windowed", paths.windowed,
+		          paths.searches > 0 ? static_cast<double>(paths.windowed) / paths.searches : 0.0);
+		const AI::FieldFeatureGrid::Statistics ai_fields = AI::FieldFeatureGrid::statistics();
+		write_row(out, filename, "counter", "ai_field_lookups", ai_fields.lookups,
+		          ai_fields.lookups > 0 ?
+		             static_cast<double>(ai_fields.lookups - ai_fields.searches) / ai_fields.lookups :
+		             0.0);
+		write_row(out, filename, "counter", "ai_field_updates", ai_fields.node_updates,
+		          ai_fields.lookups > 0 ?
+		             static_cast<double>(ai_fields.node_updates) / ai_fields.lookups :
+		             0.0);
+		for (unsigned i = 0; i < SimulationProfiler::kNumberOfCommandTypes; ++i) {
+			const SimulationProfiler::Sample& sample = SimulationProfiler::get_command(i);
+			if (sample.calls == 0U) {
+				continue;
+			}
+			write_row(out, filename, "command", command_name(i), sample.calls,
+			          to_seconds(sample.nanoseconds));
+		}
+		for (unsigned i = 0; i < SimulationProfiler::kNumberOfAiTaskTypes; ++i) {
+			const SimulationProfiler::Sample& sample = SimulationProfiler::get_ai_task(i);
+			if (sample.calls == 0U) {
+				continue;
+			}
+			write_row(out, filename, "ai_task", ai_task_name(i), sample.calls,
+			          to_seconds(sample.nanoseconds));
+		}
+	} catch (std::exception& e) {
+		SimulationProfiler::set_enabled(false);
+		log_err("Benchmark of %s failed: %s.\n", filename.c_str(), e.what());
+		return false;
+	}
+	return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	std::map<std::string, std::string> args;
+	std::vector<std::string> maps;
+	if (!parse_headless_arguments(argc, argv, &args, &maps) || maps.empty() ||
+	    args.count("help") != 0) {
+		show_usage(argv[0]);
+		return 1;
+	}
+
+	uint32_t duration_minutes = kDefaultDurationMinutes;
+	uint32_t step_ms = kDefaultStepMs;
+	uint32_t seed = kDefaultSeed;
+	if (!read_natural_argument(args, "duration", &duration_minutes) ||
+	    !read_natural_argument(args, "step", &step_ms) ||
+	    !read_natural_argument(args, "seed", &seed)) {
+		return 1;
+	}
+	const std::string datadir = args.count("datadir") != 0 ? args.at("datadir") : INSTALL_DATADIR;
+	const std::string homedir =
+	   args.count("homedir") != 0 ? args.at("homedir") : default_headless_homedir();
+	const std::string output = args.count("output") != 0 ? args.at("output") : kDefaultOutput;
+	Widelands::Router::set_landmarks_enabled(args.count("no_landmarks") == 0);
+	const bool concurrent_ai = args.count("concurrent_ai") != 0;
+
+	std::ofstream out(output);
+	if (!out.good()) {
+		log_err("Unable to open %s for writing\n", output.c_str());
+		return 1;
+	}
+	out << "map,kind,name,calls,value\n";
+
+	bool success = true;
+	try {
+		initialize_headless(datadir, homedir);
+	} catch (std::exception& e) {
+		log_err("Exception: %s.\n", e.what());
+		cleanup_headless();
+		return 1;
+	}
+	for (const std::string& map : maps) {
+		success = run_benchmark(map, duration_minutes, step_ms, seed, concurrent_ai, out) && success;
+		out.flush();
+	}
+	cleanup_headless();
+
+	log_info("Results written to %s\n", output.c_str());
+	return success ? 0 : 1;
+}
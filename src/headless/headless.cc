@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+// Simulates an AI-only game from a map or savegame as fast as possible, without
+// any graphics, sound or user interface, and reports the simulation throughput.
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/log.h"
+#include "base/random.h"
+#include "base/string.h"
+#include "base/time_string.h"
+#include "config.h"
+#include "headless/headless_common.h"
+#include "logic/game.h"
+#include "logic/map_objects/tribes/tribe_descr.h"
+#include "logic/player.h"
+#include "logic/playersmanager.h"
+
+namespace {
+
+constexpr uint32_t kDefaultDurationMinutes = 60;
+constexpr uint32_t kDefaultStepMs = 100;
+const std::string kDefaultWinCondition = "endless_game.lua";
+
+void show_usage(const char* program) {
+	log_err("Usage: %s [options] <map or savegame>\n"
+	        "\n"
+	        "Options:\n"
+	        " --datadir=DIRNAME      Use the specified directory for the Widelands data files\n"
+	        " --homedir=DIRNAME      Use the specified directory for Widelands config files,\n"
+	        "                        savegames and AI files\n"
+	        " --duration=MINUTES     Amount of game time to simulate (default: %u)\n"
+	        " --step=MS              Game time advanced per simulation step (default: %u)\n"
+	        " --win_condition=FILE   Win condition script from data/scripting/win_conditions\n"
+	        "                        for new games (default: %s)\n"
+	        " --seed=NUMBER          Random seed for the game logic and the AI\n"
+	        " --ai_training          Let the AIs mutate and write their DNA files\n"
+	        " --concurrent_ai        Let the AIs think on several threads at the same time\n"
+	        " --results=FILE         Write the players' final statistics to this CSV file\n",
+	        program, kDefaultDurationMinutes, kDefaultStepMs, kDefaultWinCondition.c_str());
+}
+
+const char* end_result_name(Widelands::PlayerEndResult result) {
+	switch (result) {
+	case Widelands::PlayerEndResult::kLost:
+		return "lost";
+	case Widelands::PlayerEndResult::kWon:
+		return "won";
+	case Widelands::PlayerEndResult::kResigned:
+		return "resigned";
+	case Widelands::PlayerEndResult::kUndefined:
+		break;
+	}
+	return "undefined";
+}
+
+void print_statistics(Widelands::Game& game, const std::vector<std::string>& player_names) {
+	const Widelands::Game::GeneralStatsVector& stats = game.get_general_statistics();
+	const auto& end_status = game.player_manager()->get_all_players_end_status();
+	for (size_t i = 0; i < player_names.size() && i < stats.size(); ++i) {
+		if (player_names[i].empty() || stats[i].land_size.empty()) {
+			continue;
+		}
+		const Widelands::Game::GeneralStats& s = stats[i];
+		const auto result = end_status.find(i + 1);
+		std::cout << format("Player %u (%s): %s, land %u, buildings %u, workers %u, wares %u, "
+		                    "productivity %u%%, military strength %u, kills %u, casualties %u",
+		                    static_cast<unsigned>(i + 1), player_names[i],
+		                    result == end_status.end() ? "playing" :
+                                                     end_result_name(result->second.result),
+		                    s.land_size.back(), s.nr_buildings.back(), s.nr_workers.back(),
+		                    s.nr_wares.back(), s.productivity.back(), s.miltary_strength.back(),
+		                    s.nr_kills.back(), s.nr_casualties.back())
+		          << std::endl;
+	}
+}
+
+// Writes one row per player with the final values of the general statistics, for wl_ai_training
+bool write_results(Widelands::Game& game, const std::string& filename) {
+	std::ofstream out(filename);
+	if (!out.good()) {
+		log_err("Unable to open %s for writing\n", filename.c_str());
+		return false;
+	}
+	out << "player,tribe,ai,result,land,buildings,workers,wares,productivity,military_strength,"
+	       "kills,casualties\n";
+	const Widelands::Game::GeneralStatsVector& stats = game.get_general_statistics();
+	const auto& end_status = game.player_manager()->get_all_players_end_status();
+	iterate_players_existing(p, game.map().get_nrplayers(), game, plr) {
+		if (p > stats.size() || stats[p - 1].land_size.empty()) {
+			continue;
+		}
+		const Widelands::Game::GeneralStats& s = stats[p - 1];
+		const auto result = end_status.find(p);
+		out << format("%u,%s,%s,%s,%u,%u,%u,%u,%u,%u,%u,%u\n", static_cast<unsigned>(p),
+		              plr->tribe().name(), plr->get_ai(),
+		              result == end_status.end() ? "playing" :
+                                               end_result_name(result->second.result),
+		              s.land_size.back(), s.nr_buildings.back(), s.nr_workers.back(),
+		              s.nr_wares.back(), s.productivity.back(), s.miltary_strength.back(),
+		              s.nr_kills.back(), s.nr_casualties.back());
+	}
+	return out.good();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	std::map<std::string, std::string> args;
+	std::vector<std::string> positional;
+	if (!parse_headless_arguments(argc, argv, &args, &positional) || positional.size() != 1 ||
+	    args.count("help") != 0) {
+		show_usage(argv[0]);
+		return 1;
+	}
+
+	uint32_t duration_minutes = kDefaultDurationMinutes;
+	uint32_t step_ms = kDefaultStepMs;
+	uint32_t seed = 0U;
+	if (!read_natural_argument(args, "duration", &duration_minutes) ||
+	    !read_natural_argument(args, "step", &step_ms) ||
+	    !read_natural_argument(args, "seed", &seed)) {
+		return 1;
+	}
+	const std::string filename = positional.front();
+	const std::string datadir = args.count("datadir") != 0 ? args.at("datadir") : INSTALL_DATADIR;
+	const std::string homedir =
+	   args.count("homedir") != 0 ? args.at("homedir") : default_headless_homedir();
+	const std::string win_condition =
+	   args.count("win_condition") != 0 ? args.at("win_condition") : kDefaultWinCondition;
+
+	try {
+		initialize_headless(datadir, homedir);
+
+		Widelands::Game game;
+		game.set_ai_training_mode(args.count("ai_training") != 0);
+		if (seed != 0U) {
+			RNG::static_seed(seed);
+			game.logic_rand_seed(seed);
+		}
+
+		const auto load_start = std::chrono::steady_clock::now();
+		game.init_headless(filename, "scripting/win_conditions/" + win_condition,
+		                   Duration(step_ms), args.count("concurrent_ai") != 0);
+		const auto load_end = std::chrono::steady_clock::now();
+		log_info("Loaded %s in %.2f s\n", filename.c_str(),
+		         std::chrono::duration<double>(load_end - load_start).count());
+
+		std::vector<std::string> player_names(game.map().get_nrplayers());
+		iterate_players_existing(p, game.map().get_nrplayers(), game, plr) {
+			player_names[p - 1] = format("%s, %s, %s", plr->get_name(), plr->tribe().name(),
+			                             plr->get_ai());
+		}
+
+		const Time start_time = game.get_gametime();
+		game.run_headless(start_time + Duration(duration_minutes * 60 * 1000));
+		const auto run_end = std::chrono::steady_clock::now();
+
+		const uint32_t simulated = (game.get_gametime() - start_time).get();
+		const double wall_seconds = std::chrono::duration<double>(run_end - load_end).count();
+		std::cout << format("Simulated %s of game time in %.2f s: %.1f game seconds per wall second",
+		                    gametimestring(simulated, true), wall_seconds,
+		                    wall_seconds > 0 ? simulated / 1000.0 / wall_seconds : 0.0)
+		          << std::endl;
+		print_statistics(game, player_names);
+		if (args.count("results") != 0 && !write_results(game, args.at("results"))) {
+			cleanup_headless();
+			return 1;
+		}
+	} catch (std::exception& e) {
+		log_err("Exception: %s.\n", e.what());
+		cleanup_headless();
+		return 1;
+	}
+	cleanup_headless();
+	return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "headless/headless_common.h"
+
+#include <memory>
+
+#include "base/i18n.h"
+#include "base/log.h"
+#include "base/math.h"
+#include "base/multithreading.h"
+#include "base/wexception.h"
+#include "graphic/graphic.h"
+#include "graphic/image_cache.h"
+#include "io/filesystem/disk_filesystem.h"
+#include "io/filesystem/layered_filesystem.h"
+#include "logic/filesystem_constants.h"
+#include "sound/sound_handler.h"
+
+void initialize_headless(const std::string& datadir, const std::string& homedir) {
+	set_initializer_thread();
+	// Everything runs on the main thread, so it is the logic thread as well.
+	set_logic_thread(true);
+	i18n::set_locale("en");
+
+	SoundHandler::disable_backend();
+
+	g_fs = new LayeredFileSystem();
+	g_fs->add_file_system(&FileSystem::create(datadir));
+
+	std::unique_ptr<FileSystem> home(new RealFSImpl(homedir));
+	home->ensure_directory_exists(".");
+	g_fs->set_home_file_system(home.release());
+	g_fs->ensure_directory_exists(kTempFileDir);
+
+	// Creating the Graphic object only creates the image cache and animation
+	// manager. There will be no window and no OpenGL context.
+	g_gr = new Graphic();
+	g_image_cache->set_headless(true);
+}
+
+void cleanup_headless() {
+	if (g_gr != nullptr) {
+		delete g_gr;
+		g_gr = nullptr;
+	}
+
+	if (g_fs != nullptr) {
+		delete g_fs;
+		g_fs = nullptr;
+	}
+}
+
+std::string default_headless_homedir() {
+#ifdef _WIN32
+	return FileSystem::get_homedir() + "\\.widelands";
+#elif defined USE_XDG
+	return FileSystem::get_userdatadir();
+#else
+	return FileSystem::get_homedir() + "/.widelands";
+#endif
+}
+
+bool parse_headless_arguments(int argc,
+                              char** argv,
+                              std::map<std::string, std::string>* result,
+                              std::vector<std::string>* positional) {
+	for (int i = 1; i < argc; ++i) {
+		std::string opt = argv[i];
+		if (opt.compare(0, 2, "--") != 0) {
+			positional->push_back(opt);
+			continue;
+		}
+		opt.erase(0, 2);
+		if (opt.empty()) {
+			log_err("Empty command line parameter");
+			return false;
+		}
+
+		std::string::size_type const pos = opt.find('=');
+		if (pos == std::string::npos) {
+			(*result)[opt] = "";
+		} else {
+			(*result)[opt.substr(0, pos)] = opt.substr(pos + 1);
+		}
+	}
+	return true;
+}
+
+bool read_natural_argument(const std::map<std::string, std::string>& args,
+                           const std::string& key,
+                           uint32_t* value) {
+	const auto it = args.find(key);
+	if (it == args.end()) {
+		return true;
+	}
+	int result = 0;
+	try {
+		result = math::to_int(it->second);
+	} catch (const WException&) {
+	}
+	if (result <= 0) {
+		log_err("Invalid value for --%s: '%s'\n", key.c_str(), it->second.c_str());
+		return false;
+	}
+	*value = result;
+	return true;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WL_HEADLESS_HEADLESS_COMMON_H
+#define WL_HEADLESS_HEADLESS_COMMON_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Setup the static objects that are needed to simulate games without any user
+// interface. Neither SDL video nor OpenGL nor sound are initialized.
+void initialize_headless(const std::string& datadir, const std::string& homedir);
+
+// Cleanup before program end
+void cleanup_headless();
+
+// The default home directory, the same one that Widelands uses.
+std::string default_headless_homedir();
+
+// Splits "--key=value" and "--flag" arguments into a map. Arguments that do not
+// start with "--" are appended to 'positional'. Returns false for malformed
+// arguments.
+bool parse_headless_arguments(int argc,
+                              char** argv,
+                              std::map<std::string, std::string>* result,
+                              std::vector<std::string>* positional);
+
+// Reads the positive integer option 'key' into 'value' if it was given. Returns
+// false and logs an error if the option has an invalid value.
+bool read_natural_argument(const std::map<std::string, std::string>& args,
+                           const std::string& key,
+                           uint32_t* value);
+
+#endif  // end of include guard: WL_HEADLESS_HEADLESS_COMMON_H
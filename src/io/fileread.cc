@@ -19,6 +19,9 @@
 #include "io/fileread.h"
 
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 
 FileRead::~FileRead() {
 	if (data_ != nullptr) {
@@ -28,7 +31,17 @@ FileRead::~FileRead() {
 
 void FileRead::open(FileSystem& fs, const std::string& filename) {
 	assert(!data_);
-	data_ = static_cast<char*>(fs.load(filename, length_));
+	FileSystem::FileView view;
+	if (fs.load_view(filename, view)) {
+		// We only modify the data after copy_view().
+		data_ = const_cast<char*>(view.data);
+		length_ = view.length;
+		view_owner_ = std::move(view.owner);
+		owns_data_ = false;
+	} else {
+		data_ = static_cast<char*>(fs.load(filename, length_));
+		owns_data_ = true;
+	}
 	filepos_ = 0;
 }
 
@@ -43,8 +56,25 @@ bool FileRead::try_open(FileSystem& fs, const std::string& filename) {
 
 void FileRead::close() {
 	assert(data_);
-	free(data_);
+	if (owns_data_) {
+		free(data_);
+	}
 	data_ = nullptr;
+	view_owner_.reset();
+	owns_data_ = false;
+}
+
+void FileRead::copy_view() {
+	assert(data_);
+	assert(!owns_data_);
+	char* const copy = static_cast<char*>(malloc(length_ + 1));
+	if (copy == nullptr) {
+		throw std::bad_alloc();
+	}
+	memcpy(copy, data_, length_);
+	copy[length_] = 0;
+	data_ = copy;
+	owns_data_ = true;
 }
 
 size_t FileRead::get_size() const {
@@ -96,9 +126,14 @@ char* FileRead::c_string(const Pos& pos) {
 	if (i >= length_) {
 		throw FileBoundaryExceeded();
 	}
-	char* const result = data_ + i;
-	for (char* p = result; *p != 0; ++p, ++i) {
+	const Pos start = i;
+	for (; i < length_ && data_[i] != 0; ++i) {
 	}
+	if (i >= length_ && !owns_data_) {
+		//  a view has no null after the end of the file
+		copy_view();
+	}
+	char* const result = data_ + start;
 	++i;                      //  beyond the null
 	if (i > (length_ + 1)) {  // allow EOF as end marker for string
 		throw FileBoundaryExceeded();
@@ -117,6 +152,9 @@ char* FileRead::read_line() {
 	if (end_of_file()) {
 		return nullptr;
 	}
+	if (!owns_data_) {
+		copy_view();
+	}
 	char* result = data_ + filepos_;
 	for (; (data_[filepos_] != 0) && data_[filepos_] != '\n'; ++filepos_) {
 		if (data_[filepos_] == '\r') {
@@ -20,6 +20,7 @@
 #define WL_IO_FILEREAD_H
 
 #include <limits>
+#include <memory>
 
 #ifndef _WIN32
 #include <sys/mman.h>
@@ -29,8 +30,10 @@
 #include "io/streamread.h"
 
 /// Can be used to read a file. It works quite naively by reading the entire
-/// file into memory. Convenience functions are available for endian-safe
-/// access of common data types.
+/// file into memory. If the filesystem can provide the file contents without
+/// copying them (see FileSystem::load_view), they are read from there instead
+/// and only copied when they need to be modified. Convenience functions are
+/// available for endian-safe access of common data types.
 class FileRead : public StreamRead {
 public:
 	struct Pos {
@@ -80,7 +83,8 @@ public:
 	char const* c_string() override;
 
 	/// Loads a file into memory. Reserves one additional byte which is zeroed,
-	/// so that text files can be handled like a null-terminated string.
+	/// so that text files can be handled like a null-terminated string. Views of
+	/// the file contents are not null-terminated, but behave the same.
 	/// \throws an exception if the file couldn't be loaded for whatever reason.
 
 	// TODO(unknown): error handling
@@ -116,9 +120,17 @@ public:
 	char* read_line();
 
 private:
+	// Replaces a view of the file contents with a null-terminated copy that we
+	// may modify. The view stays alive so that pointers into it remain valid.
+	void copy_view();
+
 	char* data_{nullptr};
 	size_t length_{0U};
 	Pos filepos_;
+
+	// Keeps the file contents alive if 'data_' is a view that we do not own.
+	std::shared_ptr<const void> view_owner_;
+	bool owns_data_{false};
 };
 
 #endif  // end of include guard: WL_IO_FILEREAD_H
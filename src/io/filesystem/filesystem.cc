@@ -146,6 +146,16 @@ bool FileSystem::is_path_absolute(const std::string& path) const {
 	return path[root_size] == file_separator();
 }
 
+bool FileSystem::load_view(const std::string& /* fname */, FileView& /* view */) {
+	return false;
+}
+
+void FileSystem::write_files(const std::vector<FileToWrite>& files) {
+	for (const FileToWrite& file : files) {
+		write(file.filename, file.data, file.length);
+	}
+}
+
 /**
  * Fix a path that might come from another OS.
  * This function is used to make sure that paths send via network are usable
@@ -19,6 +19,7 @@
 #ifndef WL_IO_FILESYSTEM_FILESYSTEM_H
 #define WL_IO_FILESYSTEM_FILESYSTEM_H
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -49,7 +50,29 @@ public:
 
 	virtual void* load(const std::string& fname, size_t& length) = 0;
 
+	/// File contents that can be read without copying them. 'data' is not
+	/// null-terminated and stays valid as long as 'owner' is alive.
+	struct FileView {
+		const char* data{nullptr};
+		size_t length{0U};
+		std::shared_ptr<const void> owner;
+	};
+	/// Provides the contents of 'fname' without copying them if the filesystem
+	/// can do so for this file. Returns false if load() has to be used instead.
+	virtual bool load_view(const std::string& fname, FileView& view);
+
 	virtual void write(const std::string& fname, void const* data, size_t length) = 0;
+
+	/// A file for write_files().
+	struct FileToWrite {
+		std::string filename;
+		void const* data;
+		size_t length;
+	};
+	/// Writes several files. Filesystems that can write them faster together
+	/// than one by one override this.
+	virtual void write_files(const std::vector<FileToWrite>& files);
+
 	virtual void ensure_directory_exists(const std::string& fs_dirname) = 0;
 	// TODO(unknown): use this only from inside ensure_directory_exists()
 	virtual void make_directory(const std::string& fs_dirname) = 0;
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "io/filesystem/mapped_file.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const char* data, size_t size) : data_(data), size_(size) {
+}
+
+#ifndef _WIN32
+std::shared_ptr<const MappedFile> MappedFile::open(const std::string& path) {
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return nullptr;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		::close(fd);
+		return nullptr;
+	}
+	const size_t size = st.st_size;
+	void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after the file descriptor is closed.
+	::close(fd);
+	if (data == MAP_FAILED) {
+		return nullptr;
+	}
+	return std::shared_ptr<const MappedFile>(new MappedFile(static_cast<const char*>(data), size));
+}
+
+MappedFile::~MappedFile() {
+	munmap(const_cast<char*>(data_), size_);
+}
+#else
+// Files are not mapped on Windows. Returning nullptr is intended: callers then
+// read the file into memory, which is what they did before files were mapped.
+std::shared_ptr<const MappedFile> MappedFile::open(const std::string& /* path */) {
+	return nullptr;
+}
+
+MappedFile::~MappedFile() = default;
+#endif
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WL_IO_FILESYSTEM_MAPPED_FILE_H
+#define WL_IO_FILESYSTEM_MAPPED_FILE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/// A file on disk that is mapped read-only into memory. The contents are
+/// only paged in when they are accessed.
+class MappedFile {
+public:
+	/// Maps the file with the given absolute path. Returns nullptr if the
+	/// file cannot be mapped, e.g. because it is empty or the platform does
+	/// not support it. Callers should then fall back to reading the file.
+	static std::shared_ptr<const MappedFile> open(const std::string& path);
+
+	~MappedFile();
+
+	[[nodiscard]] const char* data() const {
+		return data_;
+	}
+	[[nodiscard]] size_t size() const {
+		return size_;
+	}
+
+private:
+	MappedFile(const char* data, size_t size);
+
+	const char* const data_;
+	const size_t size_;
+};
+
+#endif  // end of include guard: WL_IO_FILESYSTEM_MAPPED_FILE_H
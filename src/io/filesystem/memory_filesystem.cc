@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "io/filesystem/memory_filesystem.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "io/filesystem/filesystem_exceptions.h"
+#include "io/streamread.h"
+#include "io/streamwrite.h"
+
+namespace {
+
+struct MemoryStreamRead : StreamRead {
+	explicit MemoryStreamRead(const std::string& contents) : contents_(contents) {
+	}
+	~MemoryStreamRead() override = default;
+
+	size_t data(void* read_data, size_t bufsize) override {
+		const size_t size = std::min(bufsize, contents_.size() - position_);
+		memcpy(read_data, contents_.data() + position_, size);
+		position_ += size;
+		return size;
+	}
+	[[nodiscard]] bool end_of_file() const override {
+		return position_ == contents_.size();
+	}
+
+private:
+	const std::string contents_;
+	size_t position_{0U};
+};
+
+struct MemoryStreamWrite : StreamWrite {
+	explicit MemoryStreamWrite(std::string* file) : file_(file) {
+	}
+	~MemoryStreamWrite() override = default;
+
+	void data(const void* write_data, size_t size) override {
+		file_->append(static_cast<const char*>(write_data), size);
+	}
+
+private:
+	// std::map never moves its elements, so this stays valid as long as the
+	// file is not removed.
+	std::string* file_;
+};
+
+}  // namespace
+
+MemoryFileSystem::MemoryFileSystem() : contents_(std::make_shared<Contents>()) {
+}
+
+MemoryFileSystem::MemoryFileSystem(const std::shared_ptr<Contents>& contents,
+                                   const std::string& basedir)
+   : contents_(contents), basedir_(basedir) {
+}
+
+std::string MemoryFileSystem::full_path(const std::string& path) const {
+	std::vector<std::string> components;
+	const std::string joined = basedir_ + '/' + path;
+	size_t start = 0;
+	while (start <= joined.size()) {
+		size_t end = joined.find_first_of("/\\", start);
+		if (end == std::string::npos) {
+			end = joined.size();
+		}
+		const std::string component = joined.substr(start, end - start);
+		if (component == "..") {
+			if (!components.empty()) {
+				components.pop_back();
+			}
+		} else if (!component.empty() && component != ".") {
+			components.push_back(component);
+		}
+		start = end + 1;
+	}
+
+	std::string result;
+	for (const std::string& component : components) {
+		if (!result.empty()) {
+			result += '/';
+		}
+		result += component;
+	}
+	return result;
+}
+
+bool MemoryFileSystem::is_writable() const {
+	return true;
+}
+
+FilenameSet MemoryFileSystem::list_directory(const std::string& path) const {
+	const std::string directory = full_path(path);
+	const std::string prefix = directory.empty() ? "" : directory + '/';
+	// Results are relative to this filesystem, like those of the other filesystems.
+	std::string relative_prefix = directory.substr(std::min(directory.size(), basedir_.size()));
+	if (!relative_prefix.empty()) {
+		if (relative_prefix.front() == '/') {
+			relative_prefix.erase(0, 1);
+		}
+		relative_prefix += '/';
+	}
+
+	FilenameSet results;
+	auto add_if_child = [&prefix, &relative_prefix, &results](const std::string& entry) {
+		if (entry.size() > prefix.size() && entry.compare(0, prefix.size(), prefix) == 0 &&
+		    entry.find('/', prefix.size()) == std::string::npos) {
+			results.insert(relative_prefix + entry.substr(prefix.size()));
+		}
+	};
+	for (const auto& file : contents_->files) {
+		add_if_child(file.first);
+	}
+	for (const std::string& dir : contents_->directories) {
+		add_if_child(dir);
+	}
+	return results;
+}
+
+bool MemoryFileSystem::is_directory(const std::string& path) const {
+	const std::string fullname = full_path(path);
+	return fullname.empty() || contents_->directories.count(fullname) != 0;
+}
+
+bool MemoryFileSystem::file_exists(const std::string& path) const {
+	const std::string fullname = full_path(path);
+	return contents_->files.count(fullname) != 0 || is_directory(path);
+}
+
+void* MemoryFileSystem::load(const std::string& fname, size_t& length) {
+	const auto it = contents_->files.find(full_path(fname));
+	if (it == contents_->files.end()) {
+		throw FileNotFoundError("MemoryFileSystem::load", fname);
+	}
+
+	length = it->second.size();
+	// Consumers of load() expect a null-terminated buffer that they free().
+	void* data = malloc(length + 1);
+	if (data == nullptr) {
+		throw FileError("MemoryFileSystem::load", fname, "out of memory");
+	}
+	memcpy(data, it->second.data(), length);
+	static_cast<char*>(data)[length] = '\0';
+	return data;
+}
+
+void MemoryFileSystem::write(const std::string& fname, void const* const data, size_t length) {
+	const std::string fullname = full_path(fname);
+	if (contents_->directories.count(fullname) != 0) {
+		throw FileTypeError("MemoryFileSystem::write", fname, "is a directory");
+	}
+	contents_->files[fullname].assign(static_cast<const char*>(data), length);
+}
+
+void MemoryFileSystem::ensure_directory_exists(const std::string& fs_dirname) {
+	const std::string fullname = full_path(fs_dirname);
+	if (contents_->files.count(fullname) != 0) {
+		throw FileTypeError(
+		   "MemoryFileSystem::ensure_directory_exists", fs_dirname, "a file is in the way");
+	}
+	// Also create all parent directories.
+	for (size_t end = fullname.find('/'); end != std::string::npos;
+	     end = fullname.find('/', end + 1)) {
+		contents_->directories.insert(fullname.substr(0, end));
+	}
+	if (!fullname.empty()) {
+		contents_->directories.insert(fullname);
+	}
+}
+
+void MemoryFileSystem::make_directory(const std::string& fs_dirname) {
+	if (file_exists(fs_dirname)) {
+		throw FileError("MemoryFileSystem::make_directory", fs_dirname, "already exists");
+	}
+	ensure_directory_exists(fs_dirname);
+}
+
+StreamRead* MemoryFileSystem::open_stream_read(const std::string& fname) {
+	const auto it = contents_->files.find(full_path(fname));
+	if (it == contents_->files.end()) {
+		throw FileNotFoundError("MemoryFileSystem::open_stream_read", fname);
+	}
+	return new MemoryStreamRead(it->second);
+}
+
+StreamWrite* MemoryFileSystem::open_stream_write(const std::string& fname) {
+	const std::string fullname = full_path(fname);
+	if (contents_->directories.count(fullname) != 0) {
+		throw FileTypeError("MemoryFileSystem::open_stream_write", fname, "is a directory");
+	}
+	std::string& file = contents_->files[fullname];
+	file.clear();
+	return new MemoryStreamWrite(&file);
+}
+
+FileSystem* MemoryFileSystem::make_sub_file_system(const std::string& path) {
+	if (!is_directory(path)) {
+		throw FileNotFoundError("MemoryFileSystem::make_sub_file_system", path);
+	}
+	return new MemoryFileSystem(contents_, full_path(path));
+}
+
+FileSystem* MemoryFileSystem::create_sub_file_system(const std::string& path, Type const type) {
+	if (file_exists(path)) {
+		throw FileError("MemoryFileSystem::create_sub_file_system", path, "already exists");
+	}
+	if (type != FileSystem::DIR) {
+		throw FileTypeError("MemoryFileSystem::create_sub_file_system", path,
+		                    "only directories can be created in memory");
+	}
+	ensure_directory_exists(path);
+	return new MemoryFileSystem(contents_, full_path(path));
+}
+
+void MemoryFileSystem::fs_unlink(const std::string& filename) {
+	const std::string fullname = full_path(filename);
+	if (contents_->files.erase(fullname) != 0) {
+		return;
+	}
+	if (fullname.empty() || contents_->directories.erase(fullname) == 0) {
+		throw FileNotFoundError("MemoryFileSystem::fs_unlink", filename);
+	}
+	const std::string prefix = fullname + '/';
+	auto is_inside = [&prefix](const std::string& entry) {
+		return entry.compare(0, prefix.size(), prefix) == 0;
+	};
+	for (auto it = contents_->files.begin(); it != contents_->files.end();) {
+		it = is_inside(it->first) ? contents_->files.erase(it) : std::next(it);
+	}
+	for (auto it = contents_->directories.begin(); it != contents_->directories.end();) {
+		it = is_inside(*it) ? contents_->directories.erase(it) : std::next(it);
+	}
+}
+
+void MemoryFileSystem::fs_rename(const std::string& old_name, const std::string& new_name) {
+	const std::string old_fullname = full_path(old_name);
+	const auto it = contents_->files.find(old_fullname);
+	if (it == contents_->files.end()) {
+		throw FileNotFoundError("MemoryFileSystem::fs_rename", old_name,
+		                        "only files can be renamed in memory");
+	}
+	std::string file = std::move(it->second);
+	contents_->files.erase(it);
+	contents_->files[full_path(new_name)] = std::move(file);
+}
+
+unsigned long long MemoryFileSystem::disk_space() {  // NOLINT
+	return std::numeric_limits<unsigned long long>::max();  // NOLINT
+}
+
+std::string MemoryFileSystem::get_basename() {
+	return basedir_;
+}
+
+void MemoryFileSystem::copy_to(FileSystem& target) const {
+	const std::string prefix = basedir_.empty() ? "" : basedir_ + '/';
+	auto relative = [&prefix](const std::string& entry) -> const char* {
+		return entry.size() > prefix.size() && entry.compare(0, prefix.size(), prefix) == 0 ?
+		          entry.c_str() + prefix.size() :
+		          nullptr;
+	};
+
+	// Directories are sorted, so parents are created before their children.
+	for (const std::string& dir : contents_->directories) {
+		if (const char* path = relative(dir)) {
+			target.ensure_directory_exists(path);
+		}
+	}
+	std::vector<FileToWrite> files;
+	for (const auto& file : contents_->files) {
+		if (const char* path = relative(file.first)) {
+			files.push_back({path, file.second.data(), file.second.size()});
+		}
+	}
+	target.write_files(files);
+}
+
+size_t MemoryFileSystem::total_size() const {
+	size_t result = 0;
+	for (const auto& file : contents_->files) {
+		result += file.second.size();
+	}
+	return result;
+}
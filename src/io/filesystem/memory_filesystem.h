@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WL_IO_FILESYSTEM_MEMORY_FILESYSTEM_H
+#define WL_IO_FILESYSTEM_MEMORY_FILESYSTEM_H
+
+#include <map>
+#include <memory>
+
+#include "io/filesystem/filesystem.h"
+
+/**
+ * A FileSystem that keeps all of its files in memory.
+ *
+ * Writing to it is fast, so it can be used to take a snapshot of data that is
+ * copied to a real file system later, e.g. on another thread. Sub filesystems
+ * share their contents with the filesystem that created them.
+ *
+ * The contents are not protected against concurrent access.
+ */
+class MemoryFileSystem : public FileSystem {
+public:
+	MemoryFileSystem();
+	~MemoryFileSystem() override = default;
+
+	[[nodiscard]] bool is_writable() const override;
+
+	[[nodiscard]] FilenameSet list_directory(const std::string& path) const override;
+
+	[[nodiscard]] bool is_directory(const std::string& path) const override;
+	bool file_exists(const std::string& path) const override;  // NOLINT not nodicard
+
+	void* load(const std::string& fname, size_t& length) override;
+
+	void write(const std::string& fname, void const* data, size_t length) override;
+	void ensure_directory_exists(const std::string& fs_dirname) override;
+	void make_directory(const std::string& fs_dirname) override;
+
+	StreamRead* open_stream_read(const std::string& fname) override;
+	StreamWrite* open_stream_write(const std::string& fname) override;
+
+	FileSystem* make_sub_file_system(const std::string& path) override;
+	FileSystem* create_sub_file_system(const std::string& path, Type type) override;
+	void fs_unlink(const std::string& filename) override;
+	void fs_rename(const std::string& old_name, const std::string& new_name) override;
+
+	unsigned long long disk_space() override;  // NOLINT
+
+	std::string get_basename() override;
+
+	/// Creates all directories and files of this filesystem in 'target'.
+	void copy_to(FileSystem& target) const;
+
+	/// The total size of all files in bytes.
+	[[nodiscard]] size_t total_size() const;
+
+private:
+	// Shared between a filesystem and all of its sub filesystems. Paths are
+	// relative to the root filesystem and use '/' as separator.
+	struct Contents {
+		std::map<std::string, std::string> files;
+		FilenameSet directories;
+	};
+
+	MemoryFileSystem(const std::shared_ptr<Contents>& contents, const std::string& basedir);
+
+	// The path relative to the root filesystem, without '.', '..' and
+	// separators at the start or end.
+	[[nodiscard]] std::string full_path(const std::string& path) const;
+
+	std::shared_ptr<Contents> contents_;
+	std::string basedir_;
+};
+
+#endif  // end of include guard: WL_IO_FILESYSTEM_MEMORY_FILESYSTEM_H
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "base/test.h"
+#include "io/filesystem/memory_filesystem.h"
+#include "io/streamread.h"
+#include "io/streamwrite.h"
+
+namespace {
+
+std::string load_string(FileSystem& fs, const std::string& fname) {
+	size_t length = 0;
+	void* data = fs.load(fname, length);
+	std::string result(static_cast<const char*>(data), length);
+	free(data);
+	return result;
+}
+
+}  // namespace
+
+TESTSUITE_START(MemoryFileSystemTests)
+
+TESTCASE(write_and_load) {
+	MemoryFileSystem fs;
+	fs.ensure_directory_exists("binary");
+	fs.write("binary/data", "abc", 3);
+	{
+		std::unique_ptr<StreamWrite> stream(fs.open_stream_write("binary/stream"));
+		stream->data("de", 2);
+		stream->data("f", 1);
+	}
+
+	check_equal(fs.is_directory("binary"), true);
+	check_equal(fs.is_directory("binary/data"), false);
+	check_equal(fs.file_exists("binary/data"), true);
+	check_equal(fs.file_exists("binary/missing"), false);
+	check_equal(load_string(fs, "binary/data"), std::string("abc"));
+	check_equal(load_string(fs, "./binary/../binary/stream"), std::string("def"));
+	check_equal(fs.total_size(), 6U);
+
+	std::unique_ptr<StreamRead> stream(fs.open_stream_read("binary/stream"));
+	char buffer[8];
+	check_equal(stream->data(buffer, sizeof(buffer)), 3U);
+	check_equal(stream->end_of_file(), true);
+}
+
+TESTCASE(list_directory) {
+	MemoryFileSystem fs;
+	fs.ensure_directory_exists("map/scripting");
+	fs.write("map/elemental", "1", 1);
+	fs.write("map/scripting/init.lua", "2", 1);
+	fs.write("preload", "3", 1);
+
+	check_equal(fs.list_directory("") == FilenameSet({"map", "preload"}), true);
+	check_equal(fs.list_directory("map") == FilenameSet({"map/elemental", "map/scripting"}), true);
+
+	std::unique_ptr<FileSystem> sub(fs.make_sub_file_system("map"));
+	check_equal(sub->list_directory("scripting") == FilenameSet({"scripting/init.lua"}), true);
+	check_equal(load_string(*sub, "elemental"), std::string("1"));
+}
+
+TESTCASE(copy_to) {
+	MemoryFileSystem source;
+	source.ensure_directory_exists("a/b");
+	source.write("a/b/c", "xyz", 3);
+	source.write("d", "", 0);
+
+	MemoryFileSystem target;
+	source.copy_to(target);
+	check_equal(target.is_directory("a/b"), true);
+	check_equal(load_string(target, "a/b/c"), std::string("xyz"));
+	check_equal(target.file_exists("d"), true);
+
+	// Copying a sub filesystem only copies its contents.
+	std::unique_ptr<FileSystem> sub(source.make_sub_file_system("a"));
+	MemoryFileSystem sub_target;
+	dynamic_cast<MemoryFileSystem&>(*sub).copy_to(sub_target);
+	check_equal(sub_target.list_directory("") == FilenameSet({"b"}), true);
+	check_equal(load_string(sub_target, "b/c"), std::string("xyz"));
+}
+
+TESTSUITE_END()
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "base/test.h"
+#include "io/fileread.h"
+#include "io/filesystem/disk_filesystem.h"
+#include "io/filesystem/zip_filesystem.h"
+
+namespace {
+
+constexpr char kBinary[] = "ab\0cd";
+constexpr char kText[] = "line 1\r\nline 2";
+
+// Creates a zip file in the working directory with the given compression
+// level and removes it again when done.
+class TestZipFile {
+public:
+	explicit TestZipFile(int level) : disk_(FileSystem::get_working_directory()) {
+		ZipFilesystem::set_compression_level(level);
+		zip_.reset(new ZipFilesystem(disk_.get_basename() + FileSystem::file_separator() +
+		                             "test_zip_filesystem.wgf"));
+		zip_->write("binary", kBinary, sizeof(kBinary) - 1);
+		zip_->write("text", kText, sizeof(kText) - 1);
+	}
+	~TestZipFile() {
+		zip_.reset();
+		disk_.fs_unlink("test_zip_filesystem.wgf");
+		ZipFilesystem::set_compression_level(9);
+	}
+
+	FileSystem& fs() {
+		return *zip_;
+	}
+
+private:
+	RealFSImpl disk_;
+	std::unique_ptr<ZipFilesystem> zip_;
+};
+}  // namespace
+
+TESTSUITE_START(ZipFilesystemTests)
+
+static void check_file_read(FileSystem& fs) {
+	FileRead binary;
+	binary.open(fs, "binary");
+	check_equal(binary.get_size(), sizeof(kBinary) - 1);
+	check_equal(std::string(binary.c_string()), std::string("ab"));
+	check_equal(std::string(binary.c_string()), std::string("cd"));
+	check_equal(binary.end_of_file(), true);
+
+	FileRead text;
+	text.open(fs, "text");
+	check_equal(std::string(text.read_line()), std::string("line 1"));
+	check_equal(std::string(text.read_line()), std::string("line 2"));
+	check_equal(text.read_line() == nullptr, true);
+}
+
+TESTCASE(stored_files_are_viewed) {
+	TestZipFile zip(0);
+
+	FileSystem::FileView view;
+	check_equal(zip.fs().load_view("binary", view), true);
+	check_equal(view.length, sizeof(kBinary) - 1);
+	check_equal(memcmp(view.data, kBinary, view.length), 0);
+
+	check_file_read(zip.fs());
+	// Reading lines must not modify the view shared with other readers.
+	check_file_read(zip.fs());
+}
+
+TESTCASE(compressed_files_are_loaded) {
+	TestZipFile zip(9);
+
+	FileSystem::FileView view;
+	check_equal(zip.fs().load_view("binary", view), false);
+
+	size_t length = 0;
+	void* data = zip.fs().load("text", length);
+	check_equal(length, sizeof(kText) - 1);
+	check_equal(std::string(static_cast<const char*>(data)), std::string(kText));
+	free(data);
+
+	check_file_read(zip.fs());
+}
+
+TESTSUITE_END()
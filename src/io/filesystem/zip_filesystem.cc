@@ -18,14 +18,19 @@
 
 #include "io/filesystem/zip_filesystem.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cerrno>
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <limits>
 #include <memory>
+#include <vector>
 
+#include "base/parallel_for.h"
 #include "base/string.h"
 #include "base/wexception.h"
 #include "io/filesystem/filesystem_exceptions.h"
@@ -33,6 +38,11 @@
 #include "io/streamread.h"
 #include "io/streamwrite.h"
 
+namespace {
+// Files are also compressed on other threads
+std::atomic<int> compression_level_setting(Z_BEST_COMPRESSION);
+}  // namespace
+
 ZipFilesystem::ZipFile::ZipFile(const std::string& zipfile)
    : path_(zipfile), basename_(fs_filename(zipfile.c_str())) {
 }
@@ -47,6 +57,7 @@ void ZipFilesystem::ZipFile::close() {
 	} else if (state_ == State::kUnzipping) {
 		unzClose(read_handle_);
 	}
+	mapping_.reset();
 	state_ = State::kIdle;
 }
 
@@ -77,6 +88,7 @@ void ZipFilesystem::ZipFile::open_for_unzip() {
 	if (read_handle_ == nullptr) {
 		throw FileTypeError("ZipFilesystem::open_for_unzip", path_, "not a .zip file");
 	}
+	mapping_ = MappedFile::open(path_);
 
 	std::string first_entry;
 	size_t longest_prefix = 0;
@@ -120,6 +132,10 @@ const unzFile& ZipFilesystem::ZipFile::read_handle() {
 	return read_handle_;
 }
 
+const std::shared_ptr<const MappedFile>& ZipFilesystem::ZipFile::mapping() const {
+	return mapping_;
+}
+
 const std::string& ZipFilesystem::ZipFile::path() const {
 	return path_;
 }
@@ -390,41 +406,92 @@ void ZipFilesystem::set_time_info(tm_zip& time) {
 	time.tm_year = now->tm_year;
 }
 
+unz_file_info ZipFilesystem::open_file_for_load(const std::string& fname, const char* thrower) {
+	if (!file_exists(fname) || is_directory(fname)) {
+		throw ZipOperationError(thrower, fname, zip_file_->path(), "could not open file from zipfile");
+	}
+	unz_file_info info;
+	unzGetCurrentFileInfo(zip_file_->read_handle(), &info, nullptr, 0, nullptr, 0, nullptr, 0);
+	return info;
+}
+
+const char* ZipFilesystem::mapped_file_data(const unz_file_info& info) {
+	const std::shared_ptr<const MappedFile>& mapping = zip_file_->mapping();
+	uLong offset = 0;
+	// Bit 0 of the flag marks encrypted files.
+	if (mapping == nullptr || (info.flag & 1) != 0 ||
+	    unzGetCurrentFileDataOffset(zip_file_->read_handle(), &offset) != UNZ_OK ||
+	    offset > mapping->size() || mapping->size() - offset < info.compressed_size) {
+		return nullptr;
+	}
+	return mapping->data() + offset;
+}
+
 /**
  * Read the given file into alloced memory; called by FileRead::open.
+ * If the zip file is mapped into memory, the file is decompressed straight
+ * from the mapping, otherwise it is read through minizip.
  * \throw FileNotFoundError if the file couldn't be opened.
  */
 void* ZipFilesystem::load(const std::string& fname, size_t& length) {
-	if (!file_exists(fname) || is_directory(fname)) {
-		throw ZipOperationError(
-		   "ZipFilesystem::load", fname, zip_file_->path(), "could not open file from zipfile");
-	}
-
-	char buffer[1024];
-	size_t totallen = 0;
-	unzOpenCurrentFile(zip_file_->read_handle());
-	for (;;) {
-		const int32_t len = unzReadCurrentFile(zip_file_->read_handle(), buffer, sizeof(buffer));
-		if (len == 0) {
-			break;
-		}
-		if (len < 0) {
-			unzCloseCurrentFile(zip_file_->read_handle());
-			const std::string errormessage = format("read error %i", len);
-			throw ZipOperationError("ZipFilesystem::load", fname, zip_file_->path(), errormessage);
-		}
-
-		totallen += len;
-	}
-	unzCloseCurrentFile(zip_file_->read_handle());
+	const unz_file_info info = open_file_for_load(fname, "ZipFilesystem::load");
+	const size_t totallen = info.uncompressed_size;
 
 	void* const result = malloc(totallen + 1);
 	if (result == nullptr) {
 		throw std::bad_alloc();
 	}
-	unzOpenCurrentFile(zip_file_->read_handle());
-	unzReadCurrentFile(zip_file_->read_handle(), result, totallen);
-	unzCloseCurrentFile(zip_file_->read_handle());
+	const auto fail = [this, &fname, result](const std::string& errormessage) {
+		free(result);
+		throw ZipOperationError("ZipFilesystem::load", fname, zip_file_->path(), errormessage);
+	};
+
+	if (const char* mapped = mapped_file_data(info); mapped != nullptr) {
+		if (info.compression_method == 0) {
+			if (info.compressed_size != totallen) {
+				fail("size mismatch");
+			}
+			memcpy(result, mapped, totallen);
+		} else {
+			z_stream stream;
+			stream.zalloc = Z_NULL;
+			stream.zfree = Z_NULL;
+			stream.opaque = Z_NULL;
+			stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(mapped));
+			stream.avail_in = info.compressed_size;
+			if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+				fail("could not decompress");
+			}
+			stream.next_out = static_cast<Bytef*>(result);
+			stream.avail_out = totallen;
+			const int status = inflate(&stream, Z_FINISH);
+			const size_t decompressed = stream.total_out;
+			inflateEnd(&stream);
+			if (status != Z_STREAM_END || decompressed != totallen) {
+				fail(format("decompression error %i", status));
+			}
+		}
+	} else {
+		unzOpenCurrentFile(zip_file_->read_handle());
+		size_t read = 0;
+		for (;;) {
+			const int32_t len = unzReadCurrentFile(zip_file_->read_handle(),
+			                                       static_cast<uint8_t*>(result) + read,
+			                                       std::max<size_t>(totallen - read, 1));
+			if (len == 0) {
+				break;
+			}
+			if (len < 0 || read + len > totallen) {
+				unzCloseCurrentFile(zip_file_->read_handle());
+				fail(format("read error %i", len));
+			}
+			read += len;
+		}
+		unzCloseCurrentFile(zip_file_->read_handle());
+		if (read != totallen) {
+			fail("size mismatch");
+		}
+	}
 
 	static_cast<uint8_t*>(result)[totallen] = 0;
 	length = totallen;
@@ -432,6 +499,21 @@ void* ZipFilesystem::load(const std::string& fname, size_t& length) {
 	return result;
 }
 
+bool ZipFilesystem::load_view(const std::string& fname, FileView& view) {
+	const unz_file_info info = open_file_for_load(fname, "ZipFilesystem::load_view");
+	if (info.compression_method != 0 || info.compressed_size != info.uncompressed_size) {
+		return false;
+	}
+	const char* const data = mapped_file_data(info);
+	if (data == nullptr) {
+		return false;
+	}
+	view.data = data;
+	view.length = info.uncompressed_size;
+	view.owner = zip_file_->mapping();
+	return true;
+}
+
 /**
  * Write the given block of memory to the repository.
  * Throws an exception if it fails.
@@ -440,24 +522,10 @@ void ZipFilesystem::write(const std::string& fname, void const* const data, size
 	std::string filename = fname;
 	std::replace(filename.begin(), filename.end(), '\\', '/');
 
-	zip_fileinfo zi;
-	set_time_info(zi.tmz_date);
-
-	zi.dosDate = 0;
-	zi.internal_fa = 0;
-	zi.external_fa = 0;
-
 	std::string complete_filename = basedir_in_zip_file_ + "/" + filename;
 
 	//  create file
-	switch (zipOpenNewFileInZip3(zip_file_->write_handle(), complete_filename.c_str(), &zi, nullptr,
-	                             0, nullptr, 0, nullptr /* comment*/, Z_DEFLATED, Z_BEST_COMPRESSION,
-	                             0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, nullptr, 0)) {
-	case ZIP_OK:
-		break;
-	default:
-		throw ZipOperationError("ZipFilesystem::write", complete_filename, zip_file_->path());
-	}
+	open_new_file(complete_filename, false, "ZipFilesystem::write");
 
 	switch (zipWriteInFileInZip(zip_file_->write_handle(), data, length)) {
 	case ZIP_OK:
@@ -473,6 +541,97 @@ void ZipFilesystem::write(const std::string& fname, void const* const data, size
 	zipCloseFileInZip(zip_file_->write_handle());
 }
 
+void ZipFilesystem::write_files(const std::vector<FileToWrite>& files) {
+	struct Compressed {
+		std::vector<Bytef> data;
+		uLong crc;
+	};
+	std::vector<Compressed> compressed(files.size());
+	const int level = compression_level();
+
+	// Compressing the files is independent of the zip file, so it can be done
+	// for all of them at the same time.
+	parallel_for(files.size(), [&files, &compressed, level](size_t i) {
+		const FileToWrite& file = files[i];
+		Compressed& result = compressed[i];
+		assert(file.length <= std::numeric_limits<uInt>::max());
+		const Bytef* const data = static_cast<const Bytef*>(file.data);
+		result.crc = crc32(crc32(0L, Z_NULL, 0), data, file.length);
+
+		if (level == Z_NO_COMPRESSION) {
+			result.data.assign(data, data + file.length);
+			return;
+		}
+
+		z_stream stream;
+		stream.zalloc = Z_NULL;
+		stream.zfree = Z_NULL;
+		stream.opaque = Z_NULL;
+		if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL,
+		                 Z_DEFAULT_STRATEGY) != Z_OK) {
+			throw FileError("ZipFilesystem::write_files", file.filename, "could not compress");
+		}
+		result.data.resize(deflateBound(&stream, file.length));
+		stream.next_in = const_cast<Bytef*>(data);
+		stream.avail_in = file.length;
+		stream.next_out = result.data.data();
+		stream.avail_out = result.data.size();
+		const int status = deflate(&stream, Z_FINISH);
+		result.data.resize(stream.total_out);
+		deflateEnd(&stream);
+		if (status != Z_STREAM_END) {
+			throw FileError("ZipFilesystem::write_files", file.filename, "could not compress");
+		}
+	});
+
+	for (size_t i = 0; i < files.size(); ++i) {
+		std::string filename = files[i].filename;
+		std::replace(filename.begin(), filename.end(), '\\', '/');
+		const std::string complete_filename = basedir_in_zip_file_ + "/" + filename;
+
+		open_new_file(complete_filename, true, "ZipFilesystem::write_files");
+		if (zipWriteInFileInZip(zip_file_->write_handle(), compressed[i].data.data(),
+		                        compressed[i].data.size()) != ZIP_OK) {
+			throw FileError("ZipFilesystem::write_files", complete_filename,
+			                format("in path '%s'", zip_file_->path()));
+		}
+		zipCloseFileInZipRaw(zip_file_->write_handle(), files[i].length, compressed[i].crc);
+		// Free the memory as soon as possible
+		compressed[i].data = std::vector<Bytef>();
+	}
+}
+
+void ZipFilesystem::open_new_file(const std::string& complete_filename,
+                                  bool const raw,
+                                  const char* const thrower) {
+	zip_fileinfo zi;
+	set_time_info(zi.tmz_date);
+
+	zi.dosDate = 0;
+	zi.internal_fa = 0;
+	zi.external_fa = 0;
+
+	const int level = compression_level();
+	switch (zipOpenNewFileInZip3(zip_file_->write_handle(), complete_filename.c_str(), &zi, nullptr,
+	                             0, nullptr, 0, nullptr /* comment*/,
+	                             level == Z_NO_COMPRESSION ? 0 : Z_DEFLATED, level,
+	                             static_cast<int32_t>(raw), -MAX_WBITS, DEF_MEM_LEVEL,
+	                             Z_DEFAULT_STRATEGY, nullptr, 0)) {
+	case ZIP_OK:
+		break;
+	default:
+		throw ZipOperationError(thrower, complete_filename, zip_file_->path());
+	}
+}
+
+void ZipFilesystem::set_compression_level(int const level) {
+	compression_level_setting = std::max(Z_NO_COMPRESSION, std::min(Z_BEST_COMPRESSION, level));
+}
+
+int ZipFilesystem::compression_level() {
+	return compression_level_setting;
+}
+
 StreamRead* ZipFilesystem::open_stream_read(const std::string& fname) {
 	if (!file_exists(fname) || is_directory(fname)) {
 		throw ZipOperationError(
@@ -492,25 +651,9 @@ StreamRead* ZipFilesystem::open_stream_read(const std::string& fname) {
 }
 
 StreamWrite* ZipFilesystem::open_stream_write(const std::string& fname) {
-	zip_fileinfo zi;
-
-	set_time_info(zi.tmz_date);
-
-	zi.dosDate = 0;
-	zi.internal_fa = 0;
-	zi.external_fa = 0;
-
 	std::string complete_filename = basedir_in_zip_file_ + "/" + fname;
 	//  create file
-	switch (zipOpenNewFileInZip3(zip_file_->write_handle(), complete_filename.c_str(), &zi, nullptr,
-	                             0, nullptr, 0, nullptr /* comment*/, Z_DEFLATED, Z_BEST_COMPRESSION,
-	                             0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, nullptr, 0)) {
-	case ZIP_OK:
-		break;
-	default:
-		throw ZipOperationError(
-		   "ZipFilesystem: Failed to open streamwrite", complete_filename, zip_file_->path());
-	}
+	open_new_file(complete_filename, false, "ZipFilesystem: Failed to open streamwrite");
 	return new ZipStreamWrite(zip_file_);
 }
 
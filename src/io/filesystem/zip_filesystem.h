@@ -25,6 +25,7 @@
 #include <zip.h>
 
 #include "io/filesystem/filesystem.h"
+#include "io/filesystem/mapped_file.h"
 #include "io/streamread.h"
 #include "io/streamwrite.h"
 
@@ -41,8 +42,12 @@ public:
 	bool file_exists(const std::string& path) const override;  // NOLINT not nodicard
 
 	void* load(const std::string& fname, size_t& length) override;
+	/// Only stored (uncompressed) files can be viewed directly in the zip file.
+	bool load_view(const std::string& fname, FileView& view) override;
 
 	void write(const std::string& fname, void const* data, size_t length) override;
+	/// Compresses the files in parallel, then adds them to the zip file one by one.
+	void write_files(const std::vector<FileToWrite>& files) override;
 	void ensure_directory_exists(const std::string& fs_dirname) override;
 	void make_directory(const std::string& fs_dirname) override;
 
@@ -58,6 +63,11 @@ public:
 
 	static FileSystem* create_from_directory(const std::string& directory);
 
+	/// The zlib compression level for new files, from 0 (store only) to 9 (best).
+	/// Lower levels save faster but produce larger files.
+	static void set_compression_level(int level);
+	static int compression_level();
+
 	std::string get_basename() override;
 
 private:
@@ -89,6 +99,10 @@ private:
 		// minizip handle.
 		const unzFile& read_handle();
 
+		// The zip file mapped into memory while it is opened for reading, or
+		// nullptr if it could not be mapped.
+		[[nodiscard]] const std::shared_ptr<const MappedFile>& mapping() const;
+
 	private:
 		// Closes 'path_' and reopens it for unzipping (read).
 		void open_for_unzip();
@@ -115,6 +129,8 @@ private:
 		// File handles for zipping and unzipping.
 		zipFile write_handle_{nullptr};
 		unzFile read_handle_{nullptr};
+
+		std::shared_ptr<const MappedFile> mapping_;
 	};
 
 	struct ZipStreamRead : StreamRead {
@@ -143,6 +159,18 @@ private:
 	// Place current time in tm_zip struct
 	void set_time_info(tm_zip& time);
 
+	// Checks that 'fname' is a file in the zip file, makes it the current file
+	// of the read handle and returns its info.
+	unz_file_info open_file_for_load(const std::string& fname, const char* thrower);
+
+	// Returns where the data of the current file starts in the mapped zip file,
+	// or nullptr if the data is not available in the mapping.
+	const char* mapped_file_data(const unz_file_info& info);
+
+	// Opens a new file for writing in the zip file. If 'raw' is true, the data
+	// must already be compressed.
+	void open_new_file(const std::string& complete_filename, bool raw, const char* thrower);
+
 	// The data shared between all zip filesystems with the same
 	// underlying zip file.
 	std::shared_ptr<ZipFile> zip_file_;
@@ -18,7 +18,11 @@
 
 #include "logic/cmd_queue.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "base/macros.h"
+#include "base/simulation_profiler.h"
 #include "base/wexception.h"
 #include "io/fileread.h"
 #include "io/filewrite.h"
@@ -30,13 +34,23 @@
 
 namespace Widelands {
 
+void Command::execute_batch(Game& /* game */, const std::vector<Command*>& /* batch */) {
+	NEVER_HERE();
+}
+
+void Command::write_sync_entry(Game& game) const {
+	if (dynamic_cast<const GameLogicCommand*>(this) != nullptr) {
+		StreamWrite& ss = game.syncstream();
+		ss.unsigned_8(SyncEntry::kRunQueue);
+		ss.unsigned_32(duetime().get());
+		ss.unsigned_32(static_cast<uint32_t>(id()));
+	}
+}
+
 //
 // class Cmd_Queue
 //
-CmdQueue::CmdQueue(Game& game)
-   : game_(game),
-
-     cmds_(kCommandQueueBucketSize, std::priority_queue<CmdItem>()) {
+CmdQueue::CmdQueue(Game& game) : game_(game), buckets_(kCommandQueueBucketSize) {
 }
 
 CmdQueue::~CmdQueue() {
@@ -50,19 +64,19 @@ CmdQueue::~CmdQueue() {
 // TODO(unknown): ...but game loading while in game is not possible!
 // Note: Order of destruction of Items is not guaranteed
 void CmdQueue::flush() {
-	uint32_t cbucket = 0;
-	while ((ncmds_ != 0u) && cbucket < kCommandQueueBucketSize) {
-		std::priority_queue<CmdItem>& current_cmds = cmds_[cbucket];
-
-		while (!current_cmds.empty()) {
-			Command* cmd = current_cmds.top().cmd;
-			current_cmds.pop();
-			delete cmd;
-			--ncmds_;
-		}
-		++cbucket;
+	// Released nodes have no command, so we can simply delete everything in the pool
+	for (Node& node : nodes_) {
+		delete node.item.cmd;
+	}
+	nodes_.clear();
+	free_nodes_ = kNoNode;
+	std::fill(buckets_.begin(), buckets_.end(), Bucket());
+
+	while (!overflow_.empty()) {
+		delete overflow_.top().cmd;
+		overflow_.pop();
 	}
-	assert(ncmds_ == 0);
+	ncmds_ = 0;
 }
 
 /*
@@ -90,39 +104,158 @@ void CmdQueue::enqueue(Command* const cmd) {
 	}
 
 	assert(cmd->duetime() >= game_.get_gametime());
-	cmds_[cmd->duetime().get() % kCommandQueueBucketSize].push(ci);
+	push(ci);
+}
+
+void CmdQueue::push(const CmdItem& item) {
+	if (item.cmd->duetime().get() - game_.get_gametime().get() < kCommandQueueBucketSize) {
+		insert_into_bucket(item);
+	} else {
+		overflow_.push(item);
+	}
 	++ncmds_;
 }
 
+uint32_t CmdQueue::allocate_node(const CmdItem& item) {
+	uint32_t index = free_nodes_;
+	if (index == kNoNode) {
+		index = nodes_.size();
+		nodes_.push_back(Node{item, kNoNode});
+	} else {
+		free_nodes_ = nodes_[index].next;
+		nodes_[index] = Node{item, kNoNode};
+	}
+	return index;
+}
+
+void CmdQueue::release_node(uint32_t index) {
+	nodes_[index].item.cmd = nullptr;
+	nodes_[index].next = free_nodes_;
+	free_nodes_ = index;
+}
+
+void CmdQueue::insert_into_bucket(const CmdItem& item) {
+	const uint32_t index = allocate_node(item);
+	Bucket& bucket = buckets_[item.cmd->duetime().get() % kCommandQueueBucketSize];
+
+	if (bucket.head == kNoNode) {
+		bucket.head = index;
+		bucket.tail = index;
+	} else if (!node_runs_after(bucket.tail, item)) {
+		// Most commands are enqueued in order, so appending is the common case
+		nodes_[bucket.tail].next = index;
+		bucket.tail = index;
+	} else if (node_runs_after(bucket.head, item)) {
+		nodes_[index].next = bucket.head;
+		bucket.head = index;
+	} else {
+		uint32_t previous = bucket.head;
+		while (!node_runs_after(nodes_[previous].next, item)) {
+			previous = nodes_[previous].next;
+		}
+		nodes_[index].next = nodes_[previous].next;
+		nodes_[previous].next = index;
+	}
+}
+
+void CmdQueue::migrate_overflow(const Time& now) {
+	while (!overflow_.empty() &&
+	       overflow_.top().cmd->duetime().get() - now.get() < kCommandQueueBucketSize) {
+		insert_into_bucket(overflow_.top());
+		overflow_.pop();
+	}
+}
+
+std::vector<CmdQueue::CmdItem> CmdQueue::pending_commands() const {
+	std::vector<CmdItem> result;
+	result.reserve(ncmds_);
+
+	// Each bucket covers one gametime, starting with the current one
+	const uint32_t now = game_.get_gametime().get();
+	for (uint32_t i = 0; i < kCommandQueueBucketSize; ++i) {
+		for (uint32_t index = buckets_[(now + i) % kCommandQueueBucketSize].head; index != kNoNode;
+		     index = nodes_[index].next) {
+			result.push_back(nodes_[index].item);
+		}
+	}
+
+	// The overflow heap only holds commands after the end of the calendar
+	std::priority_queue<CmdItem> overflow = overflow_;
+	while (!overflow.empty()) {
+		result.push_back(overflow.top());
+		overflow.pop();
+	}
+
+	assert(result.size() == ncmds_);
+	return result;
+}
+
+Command& CmdQueue::pop_front(Bucket& bucket) {
+	const uint32_t index = bucket.head;
+	Command& c = *nodes_[index].item.cmd;
+	bucket.head = nodes_[index].next;
+	if (bucket.head == kNoNode) {
+		bucket.tail = kNoNode;
+	}
+	release_node(index);
+	--ncmds_;
+	return c;
+}
+
+void CmdQueue::run_batch(Command& first, Bucket& bucket) {
+	std::vector<Command*> batch(1, &first);
+	while (bucket.head != kNoNode && nodes_[bucket.head].item.cmd->id() == first.id()) {
+		batch.push_back(&pop_front(bucket));
+	}
+
+	if (SimulationProfiler::is_enabled()) {
+		const uint8_t type = static_cast<uint8_t>(first.id());
+		const auto start = std::chrono::steady_clock::now();
+		first.execute_batch(game_, batch);
+		const uint64_t elapsed = SimulationProfiler::elapsed_since(start);
+		for (size_t i = 0; i < batch.size(); ++i) {
+			SimulationProfiler::add_command(type, elapsed / batch.size());
+		}
+	} else {
+		first.execute_batch(game_, batch);
+	}
+
+	for (Command* c : batch) {
+		delete c;
+	}
+}
+
 void CmdQueue::run_queue(const Duration& interval, Time& game_time_var) {
 	const Time final_time = game_time_var + interval;
 
 	while (game_time_var < final_time) {
-		std::priority_queue<CmdItem>& current_cmds =
-		   cmds_[game_time_var.get() % kCommandQueueBucketSize];
-
-		while (!current_cmds.empty()) {
-			Command& c = *current_cmds.top().cmd;
-			if (game_time_var < c.duetime()) {
-				break;
-			}
+		Bucket& bucket = buckets_[game_time_var.get() % kCommandQueueBucketSize];
 
-			current_cmds.pop();
-			--ncmds_;
+		while (bucket.head != kNoNode) {
+			// Executing the command may enqueue new ones, which can reallocate the nodes
+			Command& c = pop_front(bucket);
 			assert(game_time_var == c.duetime());
 
-			if (dynamic_cast<GameLogicCommand*>(&c) != nullptr) {
-				StreamWrite& ss = game_.syncstream();
-				ss.unsigned_8(SyncEntry::kRunQueue);
-				ss.unsigned_32(c.duetime().get());
-				ss.unsigned_32(static_cast<uint32_t>(c.id()));
+			if (c.is_batchable()) {
+				run_batch(c, bucket);
+				continue;
 			}
 
-			c.execute(game_);
+			c.write_sync_entry(game_);
+
+			if (SimulationProfiler::is_enabled()) {
+				const uint8_t type = static_cast<uint8_t>(c.id());
+				const auto start = std::chrono::steady_clock::now();
+				c.execute(game_);
+				SimulationProfiler::add_command(type, SimulationProfiler::elapsed_since(start));
+			} else {
+				c.execute(game_);
+			}
 
 			delete &c;
 		}
 		game_time_var.increment();
+		migrate_overflow(game_time_var);
 	}
 
 	assert(final_time == game_time_var);
@@ -19,8 +19,11 @@
 #ifndef WL_LOGIC_CMD_QUEUE_H
 #define WL_LOGIC_CMD_QUEUE_H
 
+#include <limits>
 #include <queue>
+#include <vector>
 
+#include "base/small_object_pool.h"
 #include "base/times.h"
 #include "logic/queue_cmd_ids.h"
 
@@ -37,19 +40,15 @@ constexpr uint32_t kCommandQueueBucketSize = 65536;  // Make this a power of two
 // it needs to know nearly all modules.
 //
 // It used to be implemented as a priority_queue sorted by execution_time,
-// serial and type of commands. This proved to be a performance bottleneck on
-// big games. I then changed this to use a constant size hash_map[gametime] of
-// priority_queues. This allows for ~O(1) access by time and in my analyses,
-// practically all buckets were used, so there is not much memory overhead.
-// This removed the bottleneck for big games.
+// serial and type of commands, and later as a constant size vector of
+// priority_queues indexed by gametime. The latter needed one heap allocation
+// per bucket and had to traverse until no new command was found when saving.
 //
-// I first tried with unordered_map, but as expected, it grew beyond all
-// limits when accessed with gametime. Therefore I reverted back to a simple
-// vector.
-//
-// The price we pay is that when saving, we also have to traverse till we no
-// longer find any new command to write. This could theoretically take forever
-// but in my tests it was not noticeable.
+// It is now a calendar queue: every bucket covers exactly one gametime within
+// the next kCommandQueueBucketSize milliseconds, and holds a linked list of
+// commands that is kept sorted in execution order. The list nodes live in one
+// pooled vector. The few commands that are scheduled further into the future
+// wait in an overflow heap until their time falls within the calendar.
 
 /**
  * A command that is supposed to be executed at a certain gametime.
@@ -66,9 +65,34 @@ struct Command {
 	}
 	virtual ~Command() = default;
 
+	// Commands are created and deleted at a very high rate, so they are pooled
+	static void* operator new(std::size_t size) {
+		return SmallObjectPool::allocate(size);
+	}
+	static void operator delete(void* p, std::size_t size) {
+		SmallObjectPool::deallocate(p, size);
+	}
+
 	virtual void execute(Game&) = 0;
 	[[nodiscard]] virtual QueueCommandTypes id() const = 0;
 
+	/**
+	 * When several batchable commands of the same type are due at the same time
+	 * and directly follow each other in the queue, the queue calls execute_batch()
+	 * on the first of them with all of them, instead of execute() on each one.
+	 * This allows them to share work, e.g. by running parts of it in parallel.
+	 * The outcome must not depend on anything but the order of the batch.
+	 * execute_batch() has to call write_sync_entry() for every command of the
+	 * batch, in order, right before the game state changes that belong to it.
+	 */
+	[[nodiscard]] virtual bool is_batchable() const {
+		return false;
+	}
+	virtual void execute_batch(Game&, const std::vector<Command*>& batch);
+
+	// Marks the execution of this command in the syncstream.
+	void write_sync_entry(Game&) const;
+
 	[[nodiscard]] const Time& duetime() const {
 		return duetime_;
 	}
@@ -112,6 +136,8 @@ class CmdQueue {
 		int32_t category;
 		uint32_t serial;
 
+		// Note that this is reversed for use in std::priority_queue, so that the
+		// top item is the one that is executed first.
 		bool operator<(const CmdItem& c) const {
 			if (cmd->duetime() != c.cmd->duetime()) {
 				return cmd->duetime() > c.cmd->duetime();
@@ -139,11 +165,42 @@ public:
 	void flush();  // delete all commands in the queue now
 
 private:
+	static constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+
+	struct Node {
+		CmdItem item;
+		uint32_t next;
+	};
+	struct Bucket {
+		uint32_t head{kNoNode};
+		uint32_t tail{kNoNode};
+	};
+
+	// Add an item to the calendar or the overflow heap, depending on its duetime.
+	void push(const CmdItem&);
+	void insert_into_bucket(const CmdItem&);
+	uint32_t allocate_node(const CmdItem&);
+	void release_node(uint32_t index);
+	// Remove the first command from a bucket and return it.
+	Command& pop_front(Bucket&);
+	// Execute the given batchable command together with the ones that follow it.
+	void run_batch(Command& first, Bucket&);
+	// Whether the command in the node will be executed after the given item.
+	[[nodiscard]] bool node_runs_after(uint32_t index, const CmdItem& item) const {
+		return nodes_[index].item < item;
+	}
+	// Move all commands from the overflow heap that are now covered by the calendar.
+	void migrate_overflow(const Time& now);
+	// All commands in the order in which they will be executed.
+	[[nodiscard]] std::vector<CmdItem> pending_commands() const;
+
 	Game& game_;
 	uint32_t nextserial_{0};
 	uint32_t ncmds_{0};
-	using CommandsContainer = std::vector<std::priority_queue<CmdItem>>;
-	CommandsContainer cmds_;
+	std::vector<Node> nodes_;
+	uint32_t free_nodes_{kNoNode};
+	std::vector<Bucket> buckets_;
+	std::priority_queue<CmdItem> overflow_;
 };
 }  // namespace Widelands
 
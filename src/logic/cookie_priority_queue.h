@@ -104,6 +104,10 @@ struct CookiePriorityQueue : CookiePriorityQueueBase<CPQType> {
 	void decrease_key(CookieType* elt);
 	void increase_key(CookieType* elt);
 
+	/// Removes all elements but keeps the storage, so that the queue can be
+	/// reused for another search of the given type.
+	void reset(Widelands::WareWorker type);
+
 	[[nodiscard]] Widelands::WareWorker type() const {
 		return type_;
 	}
@@ -158,6 +162,15 @@ CookiePriorityQueue<t_T, t_Cw, t_CA>::~CookiePriorityQueue() {
 	}
 }
 
+template <typename t_T, typename t_Cw, typename t_CA>
+void CookiePriorityQueue<t_T, t_Cw, t_CA>::reset(Widelands::WareWorker wwtype) {
+	for (typename CookieTypeVector::iterator it = d.begin(); it != d.end(); ++it) {
+		cookie_pos(ca(*it, type_)) = bad_pos();
+	}
+	d.clear();
+	type_ = wwtype;
+}
+
 template <typename t_T, typename t_Cw, typename t_CA>
 typename CookiePriorityQueue<t_T, t_Cw, t_CA>::CookieSizeType
 CookiePriorityQueue<t_T, t_Cw, t_CA>::size() const {
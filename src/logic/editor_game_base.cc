@@ -679,7 +679,7 @@ void EditorGameBase::conquer_area(PlayerArea<Area<FCoords>> player_area,
 	do_conquer_area(player_area, true, 0, conquer_guarded_location);
 }
 
-void EditorGameBase::change_field_owner(const FCoords& fc, PlayerNumber const new_owner) const {
+void EditorGameBase::change_field_owner(const FCoords& fc, PlayerNumber const new_owner) {
 	const Field& first_field = map()[0];
 
 	PlayerNumber const old_owner = fc.field->get_owned_by();
@@ -692,7 +692,7 @@ void EditorGameBase::change_field_owner(const FCoords& fc, PlayerNumber const ne
 		   NoteFieldPossession(fc, NoteFieldPossession::Ownership::LOST, get_player(old_owner)));
 	}
 
-	fc.field->set_owned_by(new_owner);
+	map_.set_field_owner(*fc.field, new_owner);
 
 	// TODO(unknown): the player should do this when it gets the NoteFieldPossession.
 	// This means also sending a note when new_player = 0, i.e. the field is no
@@ -129,24 +129,6 @@ public:
 	[[nodiscard]] DescriptionIndex terrain_r() const {
 		return terrains.r;
 	}
-	void set_terrains(const Terrains& i) {
-		terrains = i;
-	}
-	void set_terrain(const TriangleIndex& t, DescriptionIndex const i)
-
-	{
-		if (t == TriangleIndex::D) {
-			set_terrain_d(i);
-		} else {
-			set_terrain_r(i);
-		}
-	}
-	void set_terrain_d(DescriptionIndex const i) {
-		terrains.d = i;
-	}
-	void set_terrain_r(DescriptionIndex const i) {
-		terrains.r = i;
-	}
 
 	[[nodiscard]] Bob* get_first_bob() const {
 		return bobs;
@@ -163,15 +145,6 @@ public:
 		return brightness;
 	}
 
-	/**
-	 * Does not change the border bit of this or neighbouring fields. That must
-	 * be done separately.
-	 */
-	void set_owned_by(const PlayerNumber n) {
-		assert(n <= kMaxPlayers);
-		owner_info_and_selections = n | (owner_info_and_selections & ~Player_Number_Bitmask);
-	}
-
 	[[nodiscard]] PlayerNumber get_owned_by() const {
 		assert((owner_info_and_selections & Player_Number_Bitmask) <= kMaxPlayers);
 		return owner_info_and_selections & Player_Number_Bitmask;
@@ -239,15 +212,33 @@ public:
 		return initial_res_amount;
 	}
 
+private:
+	// The setters of attributes that Map also keeps in its MapLayers. Use the
+	// Map::set_field_* functions instead.
+	void set_terrains(const Terrains& i) {
+		terrains = i;
+	}
+	void set_terrain(const TriangleIndex& t, DescriptionIndex const i) {
+		if (t == TriangleIndex::D) {
+			terrains.d = i;
+		} else {
+			terrains.r = i;
+		}
+	}
+	/**
+	 * Does not change the border bit of this or neighbouring fields. That must
+	 * be done separately.
+	 */
+	void set_owned_by(const PlayerNumber n) {
+		assert(n <= kMaxPlayers);
+		owner_info_and_selections = n | (owner_info_and_selections & ~Player_Number_Bitmask);
+	}
 	/// \note you must reset this field's + neighbor's brightness when you
-	/// change the height. Map::change_height does this. This function is not
-	/// private, because the loader will use them directly But realize, most of
-	/// the times you will need Map::set_field_height().
+	/// change the height. Map::set_height does this.
 	void set_height(Height const h) {
 		height = static_cast<int8_t>(h) < 0 ? 0 : MAX_FIELD_HEIGHT < h ? MAX_FIELD_HEIGHT : h;
 	}
 
-private:
 	/**
 	 * A field can be selected in one of 2 selections. This allows the user to
 	 * use selection tools to select a set of fields and then perform a command
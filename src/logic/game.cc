@@ -50,6 +50,7 @@
 #include "logic/cmd_luascript.h"
 #include "logic/filesystem_constants.h"
 #include "logic/game_settings.h"
+#include "logic/headless_game_controller.h"
 #include "logic/map_objects/tribes/carrier.h"
 #include "logic/map_objects/tribes/market.h"
 #include "logic/map_objects/tribes/militarysite.h"
@@ -60,6 +61,7 @@
 #include "logic/map_objects/tribes/warehouse.h"
 #include "logic/player.h"
 #include "logic/playercommand.h"
+#include "logic/playersmanager.h"
 #include "logic/replay.h"
 #include "logic/replay_game_controller.h"
 #include "logic/single_player_game_controller.h"
@@ -381,20 +383,27 @@ void Game::init_newgame(const GameSettings& settings) {
 		diplomacy_allowed_ = ((settings.flags & GameSettings::Flags::kForbidDiplomacy) == 0);
 		naval_warfare_allowed_ = ((settings.flags & GameSettings::Flags::kAllowNavalWarfare) != 0);
 		win_condition_duration_ = settings.win_condition_duration;
-		std::unique_ptr<LuaTable> table(lua().run_script(settings.win_condition_script));
-		table->do_not_warn_about_unaccessed_keys();
-		win_condition_displayname_ = table->get_string("name");
-		if (table->has_key<std::string>("init")) {
-			std::unique_ptr<LuaCoroutine> cr = table->get_coroutine("init");
-			cr->resume();
-		}
-		std::unique_ptr<LuaCoroutine> cr = table->get_coroutine("func");
-		enqueue_command(new CmdLuaCoroutine(get_gametime() + Duration(100), std::move(cr)));
+		init_win_condition(settings.win_condition_script);
 	} else {
 		win_condition_displayname_ = "Scenario";
 	}
 }
 
+/**
+ * Run the win condition's init function and schedule its main coroutine.
+ */
+void Game::init_win_condition(const std::string& script) {
+	std::unique_ptr<LuaTable> table(lua().run_script(script));
+	table->do_not_warn_about_unaccessed_keys();
+	win_condition_displayname_ = table->get_string("name");
+	if (table->has_key<std::string>("init")) {
+		std::unique_ptr<LuaCoroutine> cr = table->get_coroutine("init");
+		cr->resume();
+	}
+	std::unique_ptr<LuaCoroutine> cr = table->get_coroutine("func");
+	enqueue_command(new CmdLuaCoroutine(get_gametime() + Duration(100), std::move(cr)));
+}
+
 /**
  * Initialize the savegame based on the given settings.
  * At return the game is at the same state like a map loaded with Game::init()
@@ -547,7 +556,9 @@ std::string Game::active_training_wheel() const {
  */
 void Game::postload() {
 	EditorGameBase::postload();
-	get_ibase()->postload();
+	if (InteractiveBase* ibase = get_ibase()) {
+		ibase->postload();
+	}
 }
 
 /**
@@ -801,6 +812,95 @@ bool Game::run_replay(const std::string& filename, const std::string& script_to_
 	return run(Widelands::Game::StartGameType::kSaveGame, script_to_run, "replay");
 }
 
+void Game::init_headless(const std::string& filename,
+                         const std::string& win_condition_script,
+                         const Duration& step,
+                         bool const concurrent_ai) {
+	full_cleanup();
+
+	// Nobody would ever look at replays or autosaves of these games
+	set_write_replay(false);
+	savehandler_.set_allow_saving(false);
+
+	const bool is_savegame = FileSystem::filename_ext(filename) == kSavegameExtension;
+	if (is_savegame) {
+		GameLoader gl(filename, *this);
+		Widelands::GamePreloadPacket gpdp;
+		gl.preload_game(gpdp);
+		win_condition_displayname_ = gpdp.get_win_condition();
+		win_condition_duration_ = gpdp.get_win_condition_duration();
+		gl.load_game();
+		postload_addons();
+	} else {
+		std::unique_ptr<MapLoader> maploader(mutable_map()->get_correct_loader(filename));
+		if (!maploader) {
+			throw wexception("could not load \"%s\"", filename.c_str());
+		}
+		maploader->preload_map(false, &enabled_addons());
+		postload_addons_before_loading();
+
+		// Tribes are assigned round-robin rather than randomly so that the
+		// same map always results in the same game.
+		PlayerNumber const nr_players = map().get_nrplayers();
+		iterate_player_numbers(p, nr_players) {
+			std::string tribe = map().get_scenario_player_tribe(p);
+			if (tribe.empty()) {
+				tribe = all_tribes().at((p - 1) % all_tribes().size()).name;
+			}
+			add_player(p, 0, kPlayerColors[p - 1], tribe, map().get_scenario_player_name(p));
+		}
+		maploader->load_map_complete(*this, Widelands::MapLoader::LoadType::kGame);
+	}
+
+	iterate_players_existing(p, map().get_nrplayers(), *this, plr) {
+		if (plr->get_ai().empty()) {
+			plr->set_ai("normal");
+		}
+	}
+
+	set_game_controller(std::make_shared<HeadlessGameController>(*this, step, concurrent_ai));
+	postload();
+
+	if (!is_savegame) {
+		iterate_players_existing(p, map().get_nrplayers(), *this, plr) {
+			plr->create_default_infrastructure();
+		}
+		mutable_map()->recalc_default_resources(descriptions());
+		init_win_condition(win_condition_script);
+		enqueue_command(new CmdCalculateStatistics(get_gametime() + Duration(1)));
+	}
+
+	sync_reset();
+	state_ = gs_running;
+}
+
+void Game::run_headless(const Time& end_time) {
+	assert(state_ == gs_running);
+	assert(get_ibase() == nullptr);
+
+	while (get_gametime() < end_time && !all_players_finished()) {
+		think();
+	}
+
+	state_ = gs_ending;
+	cleanup_objects();
+	delete_pending_player_commands();
+	state_ = gs_notrunning;
+}
+
+/**
+ * Whether the win condition has reported a result for every player.
+ */
+bool Game::all_players_finished() {
+	const auto& end_status = player_manager()->get_all_players_end_status();
+	iterate_players_existing_novar(p, map().get_nrplayers(), *this) {
+		if (end_status.count(p) == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void Game::set_next_game_to_load(const std::string& file) {
 	next_game_to_load_ = file;
 }
@@ -987,12 +1087,31 @@ uint32_t Game::logic_rand() {
 	return result;
 }
 
+namespace {
+// Set by Game::ScopedCommandCollector
+thread_local std::vector<PlayerCommand*>* collected_player_commands = nullptr;
+}  // namespace
+
+Game::ScopedCommandCollector::ScopedCommandCollector(std::vector<PlayerCommand*>& commands)
+   : previous_(collected_player_commands) {
+	collected_player_commands = &commands;
+}
+
+Game::ScopedCommandCollector::~ScopedCommandCollector() {
+	collected_player_commands = previous_;
+}
+
 /**
  * All player-issued commands must enter the queue through this function.
  * It takes the appropriate action, i.e. either add to the cmd_queue or send
  * across the network.
  */
 void Game::send_player_command(PlayerCommand* pc) {
+	if (collected_player_commands != nullptr) {
+		collected_player_commands->push_back(pc);
+		return;
+	}
+
 	MutexLock m(MutexLock::ID::kCommands);
 	if (is_logic_thread()) {
 		do_send_player_command(pc);
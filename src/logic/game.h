@@ -205,6 +205,20 @@ public:
 
 	bool run_replay(const std::string& filename, const std::string& script_to_run);
 
+	// Load a map or savegame for a simulation without any user interface, sound or
+	// graphics. Every player is controlled by the AI, and each call to think()
+	// advances the game by `step` regardless of how much real time has passed.
+	// The win condition script is only used for maps; savegames keep their own.
+	// With `concurrent_ai`, the AIs think on several threads at once.
+	void init_headless(const std::string& filename,
+	                   const std::string& win_condition_script,
+	                   const Duration& step,
+	                   bool concurrent_ai = false);
+
+	// Advance a game that was prepared by init_headless() until `end_time` is
+	// reached or all players have an end result, then clean up.
+	void run_headless(const Time& end_time);
+
 #if 0  // TODO(Nordfriese): Re-add training wheels code after v1.0
 	bool acquire_training_wheel_lock(const std::string& objective);
 	void release_training_wheel_lock();
@@ -270,6 +284,18 @@ public:
 
 	void send_player_command(Widelands::PlayerCommand*);
 
+	/// While an instance exists, send_player_command() appends the commands sent
+	/// from the thread that created it to the given list instead of sending them.
+	/// The owner of the list must send or delete them later.
+	class ScopedCommandCollector {
+	public:
+		explicit ScopedCommandCollector(std::vector<PlayerCommand*>& commands);
+		~ScopedCommandCollector();
+
+	private:
+		std::vector<PlayerCommand*>* previous_;
+	};
+
 	void send_player_bulldoze(PlayerImmovable&, bool recurse = false);
 	void send_player_dismantle(PlayerImmovable&, bool keep_wares);
 	void send_player_build(int32_t, const Coords&, DescriptionIndex);
@@ -424,6 +450,9 @@ private:
 
 	void sync_reset();
 
+	void init_win_condition(const std::string& script);
+	bool all_players_finished();
+
 	MD5Checksum<StreamWrite> synchash_;
 
 	struct SyncWrapper : public StreamWrite {
@@ -19,9 +19,11 @@
 #include "logic/generic_save_handler.h"
 
 #include <memory>
+#include <optional>
 
 #include "base/i18n.h"
 #include "base/log.h"
+#include "base/mutex.h"
 #include "base/string.h"
 #include "base/time_string.h"
 #include "io/filesystem/filesystem.h"
@@ -125,8 +127,12 @@ void GenericSaveHandler::save_file() {
 
 GenericSaveHandler::Error GenericSaveHandler::save() {
 	// TODO(tothxa): kObjects before kLua is needed because of Panel::do_run() and plugin actions
-	MutexLock o(MutexLock::ID::kObjects);
-	MutexLock m(MutexLock::ID::kLua);
+	std::optional<MutexLock> o;
+	std::optional<MutexLock> m;
+	if (lock_game_state_) {
+		o.emplace(MutexLock::ID::kObjects);
+		m.emplace(MutexLock::ID::kLua);
+	}
 	try {  // everything additionally in one big try block
 		    // to catch any unexpected errors
 		clear();
@@ -54,12 +54,16 @@ public:
 	explicit GenericSaveHandler(std::function<void(FileSystem&)>
 	                               do_save,  // function that actually saves data to the filesystem
 	                            const std::string& complete_filename,
-	                            FileSystem::Type type)
+	                            FileSystem::Type type,
+	                            // whether do_save accesses the game state, which must not
+	                            // change while saving
+	                            bool lock_game_state = true)
 	   : do_save_(do_save),
 	     complete_filename_(complete_filename),
 	     dir_(FileSystem::fs_dirname(complete_filename)),
 	     filename_(FileSystem::fs_filename(complete_filename.c_str())),
 	     type_(type),
+	     lock_game_state_(lock_game_state),
 	     error_(static_cast<Error>(1132)) {
 	}
 
@@ -96,6 +100,7 @@ private:
 	std::string dir_;
 	std::string filename_;
 	FileSystem::Type type_;
+	bool lock_game_state_;
 
 	// Backup filename is automatically generated when saving but is also
 	// stored for generating messages containing backup-related things.
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "logic/headless_game_controller.h"
+
+#include "base/simulation_profiler.h"
+#include "logic/game.h"
+#include "logic/player.h"
+#include "logic/playercommand.h"
+#include "logic/playersmanager.h"
+
+HeadlessGameController::HeadlessGameController(Widelands::Game& game,
+                                               const Duration& step,
+                                               bool const concurrent_ai)
+   : game_(game), step_(step), concurrent_ai_(concurrent_ai) {
+	assert(step_.get() > 0);
+}
+
+void HeadlessGameController::think() {
+	if (!game_.is_loaded()) {
+		return;
+	}
+
+	const Widelands::PlayerNumber nr_players = game_.map().get_nrplayers();
+	std::vector<AI::ComputerPlayer*> thinking;
+	iterate_players_existing(p, nr_players, game_, plr) {
+		if (p > computerplayers_.size()) {
+			computerplayers_.resize(p);
+		}
+		if (computerplayers_[p - 1] == nullptr) {
+			computerplayers_[p - 1].reset(
+			   AI::ComputerPlayer::get_implementation(plr->get_ai())->instantiate(game_, p));
+		}
+		thinking.push_back(computerplayers_[p - 1].get());
+	}
+	SimulationProfiler::ScopedSample sample(SimulationProfiler::Section::kAiThink);
+	AI::ComputerPlayer::think_all(thinking, concurrent_ai_);
+}
+
+void HeadlessGameController::send_player_command(Widelands::PlayerCommand* pc) {
+	pc->set_cmdserial(++player_cmdserial_);
+	game_.enqueue_command(pc);
+}
+
+Duration HeadlessGameController::get_frametime() {
+	return step_;
+}
+
+GameController::GameType HeadlessGameController::get_game_type() {
+	return GameController::GameType::kSingleplayer;
+}
+
+uint32_t HeadlessGameController::real_speed() {
+	// There is no real time to relate the game speed to.
+	return 1000;
+}
+
+uint32_t HeadlessGameController::desired_speed() {
+	return 1000;
+}
+
+void HeadlessGameController::set_desired_speed(uint32_t /* speed */) {
+}
+
+bool HeadlessGameController::is_paused() {
+	return false;
+}
+
+void HeadlessGameController::set_paused(bool /* paused */) {
+}
+
+void HeadlessGameController::report_result(uint8_t p_nr,
+                                           Widelands::PlayerEndResult result,
+                                           const std::string& info) {
+	Widelands::PlayerEndStatus pes;
+	Widelands::Player* player = game_.get_player(p_nr);
+	assert(player != nullptr);
+	pes.player = player->player_number();
+	pes.time = game_.get_gametime();
+	pes.result = result;
+	pes.info = info;
+	game_.player_manager()->add_player_end_status(pes);
+}
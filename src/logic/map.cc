@@ -18,13 +18,18 @@
 
 #include "logic/map.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
+#include <functional>
 #include <memory>
 
 #include "base/log.h"
 #include "base/macros.h"
+#include "base/parallel_for.h"
 #include "base/scoped_timer.h"
+#include "base/simulation_profiler.h"
 #include "base/string.h"
 #include "base/wexception.h"
 #include "economy/flag.h"
@@ -41,6 +46,7 @@
 #include "logic/map_objects/tribes/soldier.h"
 #include "logic/map_objects/world/critter.h"
 #include "logic/map_objects/world/terrain_description.h"
+#include "logic/map_recalc.h"
 #include "logic/mapfringeregion.h"
 #include "logic/maphollowregion.h"
 #include "logic/mapregion.h"
@@ -79,6 +85,35 @@ const Map::OldWorldInfo& Map::get_old_world_info_by_new_name(const std::string&
 	NEVER_HERE();
 }
 
+void MapLayers::resize(size_t const size) {
+	// The same defaults as for a new Field
+	heights.assign(size, 0U);
+	caps.assign(size, CAPS_NONE);
+	max_caps.assign(size, CAPS_NONE);
+	terrains.assign(size, Field::Terrains{INVALID_INDEX, INVALID_INDEX});
+	owners.assign(size, neutral());
+	resources.assign(size, INVALID_INDEX);
+	resource_amounts.assign(size, 0U);
+}
+
+void MapObjectTiles::reset(int16_t const map_width, int16_t const map_height) {
+	columns = (map_width + kSize - 1) / kSize;
+	const size_t size = columns * ((map_height + kSize - 1) / kSize);
+	bobs.assign(size, 0U);
+	immovables.assign(size, 0U);
+	immovable_attributes.assign(size, 0U);
+}
+
+namespace {
+uint64_t attribute_mask(const BaseImmovable& imm) {
+	uint64_t mask = 0U;
+	for (const MapObjectDescr::AttributeIndex attribute : imm.descr().attributes()) {
+		mask |= MapObjectTiles::attribute_bit(attribute);
+	}
+	return mask;
+}
+}  // namespace
+
 FieldData::FieldData(const Field& field)
    : height(field.get_height()),
      resources(field.get_resources()),
@@ -156,6 +191,11 @@ void Map::recalc_border(const FCoords& fc) const {
 	fc.field->set_border(false);
 }
 
+// Work sizes for spreading node recalculations over several threads
+constexpr int16_t kBatchedRowsPerBand = 8;
+constexpr size_t kBatchedChunkSize = 256;
+constexpr uint32_t kBatchedAreaMinNodes = 4096;
+
 /*
 ===============
 Call this function whenever the field at fx/fy has changed in one of the ways:
@@ -174,6 +214,19 @@ void Map::recalc_for_field_area(const EditorGameBase& egbase, const Area<FCoords
 	assert(fields_.get() <= area.field);
 	assert(area.field < fields_.get() + max_index());
 
+	// Large areas that do not wrap around onto themselves are spread over
+	// several threads.
+	if (calc_area_size(area.radius) >= kBatchedAreaMinNodes &&
+	    2 * area.radius < std::min(width_, height_)) {
+		std::vector<FCoords> nodes;
+		MapRegion<Area<FCoords>> mr(*this, area);
+		do {
+			nodes.push_back(mr.location());
+		} while (mr.advance(*this));
+		recalc_nodes_batched(egbase, nodes);
+		return;
+	}
+
 	{  //  First pass.
 		MapRegion<Area<FCoords>> mr(*this, area);
 		do {
@@ -191,6 +244,49 @@ void Map::recalc_for_field_area(const EditorGameBase& egbase, const Area<FCoords
 	}
 }
 
+/*
+===============
+Recalculates brightness, border and nodecaps of the given nodes like
+recalc_for_field_area() does, but spreads the work over several threads.
+
+The first pass of each node only writes to that node. The second pass reads
+the walk, swim and flag caps of the neighbours, which it never changes itself,
+so its results are collected first and stored afterwards. The nodes must be
+distinct.
+===============
+*/
+void Map::recalc_nodes_batched(const EditorGameBase& egbase, const std::vector<FCoords>& nodes) {
+	const size_t nr_chunks = (nodes.size() + kBatchedChunkSize - 1) / kBatchedChunkSize;
+	auto for_each_node = [&nodes, nr_chunks](const std::function<void(size_t)>& fn) {
+		parallel_for(nr_chunks, [&nodes, &fn](size_t chunk) {
+			const size_t end = std::min(nodes.size(), (chunk + 1) * kBatchedChunkSize);
+			for (size_t i = chunk * kBatchedChunkSize; i < end; ++i) {
+				fn(i);
+			}
+		});
+	};
+
+	for_each_node([this, &egbase, &nodes](size_t i) {
+		recalc_brightness(nodes[i]);
+		recalc_border(nodes[i]);
+		recalc_nodecaps_pass1(egbase, nodes[i]);
+	});
+
+	std::vector<uint8_t> caps(nodes.size());
+	std::vector<uint8_t> max_caps(nodes.size());
+	for_each_node([this, &egbase, &nodes, &caps, &max_caps](size_t i) {
+		const FCoords& f = nodes[i];
+		const NodeSlopes slopes = calc_node_slopes(f);
+		caps[i] = calc_nodecaps_pass2(egbase, f, true, CAPS_NONE, &slopes);
+		max_caps[i] =
+		   calc_nodecaps_pass2(egbase, f, false, static_cast<NodeCaps>(f.field->max_caps), &slopes);
+	});
+
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		set_field_caps(*nodes[i].field, caps[i], max_caps[i]);
+	}
+}
+
 /*
 ===========
 
@@ -203,26 +299,97 @@ the overlays have completely changed.
 void Map::recalc_whole_map(const EditorGameBase& egbase) {
 	//  Post process the map in the necessary two passes to calculate
 	//  brightness and building caps
-	FCoords f;
+	if (!recalc_whole_map_batched(egbase)) {
+		FCoords f;
 
-	for (int16_t y = 0; y < height_; ++y) {
+		for (int16_t y = 0; y < height_; ++y) {
+			for (int16_t x = 0; x < width_; ++x) {
+				f = get_fcoords(Coords(x, y));
+				uint32_t radius = 0;
+				check_neighbour_heights(f, radius);
+				recalc_brightness(f);
+				recalc_border(f);
+				recalc_nodecaps_pass1(egbase, f);
+			}
+		}
+
+		for (int16_t y = 0; y < height_; ++y) {
+			for (int16_t x = 0; x < width_; ++x) {
+				f = get_fcoords(Coords(x, y));
+				recalc_nodecaps_pass2(egbase, f);
+			}
+		}
+	}
+	recalculate_allows_seafaring();
+}
+
+/*
+===========
+Does the work of recalc_whole_map() in bands of rows that are spread over
+several threads. Brightness and slopes are calculated a whole row at a time
+from the heights layer, see map_recalc.h.
+
+This only works if no heights need to be corrected by check_neighbour_heights(),
+which is the case for every map that has been saved by Widelands. Otherwise,
+nothing is changed and false is returned.
+===========
+*/
+bool Map::recalc_whole_map_batched(const EditorGameBase& egbase) {
+	const Field::Height* heights = layers_.heights.data();
+	const size_t nr_bands = (height_ + kBatchedRowsPerBand - 1) / kBatchedRowsPerBand;
+	auto for_each_row = [this, nr_bands](const std::function<void(int16_t)>& fn) {
+		parallel_for(nr_bands, [this, &fn](size_t band) {
+			const int16_t end = std::min<int>(height_, (band + 1) * kBatchedRowsPerBand);
+			for (int16_t y = band * kBatchedRowsPerBand; y < end; ++y) {
+				fn(y);
+			}
+		});
+	};
+
+	std::atomic<bool> heights_valid(true);
+	for_each_row([this, heights, &heights_valid](int16_t y) {
+		if (!row_heights_within(HeightRows(heights, width_, height_, y), max_field_height_diff())) {
+			heights_valid = false;
+		}
+	});
+	if (!heights_valid) {
+		return false;
+	}
+
+	std::vector<NodeSlopes> slopes(max_index());
+	for_each_row([this, &egbase, heights, &slopes](int16_t y) {
+		const HeightRows rows(heights, width_, height_, y);
+		const MapIndex row_start = get_index(Coords(0, y), width_);
+		std::vector<int8_t> brightness(width_);
+		calc_brightness_row(rows, brightness.data());
+		calc_slopes_row(rows, &slopes[row_start]);
 		for (int16_t x = 0; x < width_; ++x) {
-			f = get_fcoords(Coords(x, y));
-			uint32_t radius = 0;
-			check_neighbour_heights(f, radius);
-			recalc_brightness(f);
+			const FCoords f(Coords(x, y), &fields_[row_start + x]);
+			f.field->brightness = brightness[x];
 			recalc_border(f);
 			recalc_nodecaps_pass1(egbase, f);
 		}
-	}
+	});
 
-	for (int16_t y = 0; y < height_; ++y) {
+	// See recalc_nodes_batched() for why the second pass needs to store its
+	// results separately.
+	std::vector<uint8_t> caps(max_index());
+	std::vector<uint8_t> max_caps(max_index());
+	for_each_row([this, &egbase, &slopes, &caps, &max_caps](int16_t y) {
+		const MapIndex row_start = get_index(Coords(0, y), width_);
 		for (int16_t x = 0; x < width_; ++x) {
-			f = get_fcoords(Coords(x, y));
-			recalc_nodecaps_pass2(egbase, f);
+			const MapIndex i = row_start + x;
+			const FCoords f(Coords(x, y), &fields_[i]);
+			caps[i] = calc_nodecaps_pass2(egbase, f, true, CAPS_NONE, &slopes[i]);
+			max_caps[i] = calc_nodecaps_pass2(
+			   egbase, f, false, static_cast<NodeCaps>(f.field->max_caps), &slopes[i]);
 		}
+	});
+
+	for (MapIndex i = 0; i < max_index(); ++i) {
+		set_field_caps(fields_[i], caps[i], max_caps[i]);
 	}
-	recalculate_allows_seafaring();
+	return true;
 }
 
 void Map::recalc_whole_map_brightness() {
@@ -441,10 +608,10 @@ size_t Map::count_all_fields_excluding_caps(NodeCaps caps) {
 	verb_log_info("Collecting valuable fields ... ");
 	ScopedTimer timer(" → took %ums", true);
 
+	const std::vector<uint8_t>& all_caps = layers_.caps;
 	for (MapIndex i = 0; i < max_index(); ++i) {
-		Field& field = fields_[i];
-		if ((field.nodecaps() & caps) == 0) {
-			valuable_fields_.insert(get_fcoords(field));
+		if ((all_caps[i] & caps) == 0) {
+			valuable_fields_.insert(get_fcoords(fields_[i]));
 		}
 	}
 
@@ -482,6 +649,8 @@ void Map::cleanup() {
 	width_ = height_ = 0;
 
 	fields_.reset();
+	layers_.resize(0);
+	object_tiles_.reset(0, 0);
 
 	starting_pos_.clear();
 	scenario_tribes_.clear();
@@ -530,8 +699,8 @@ void Map::create_empty_map(const EditorGameBase& egbase,
 		for (int16_t y = 0; y < height_; ++y) {
 			for (int16_t x = 0; x < width_; ++x) {
 				auto f = get_fcoords(Coords(x, y));
-				f.field->set_height(10);
-				f.field->set_terrains(default_terrains);
+				set_field_height(*f.field, 10);
+				set_field_terrains(*f.field, default_terrains);
 				clear_resources(f);
 			}
 		}
@@ -574,6 +743,7 @@ void Map::set_origin(const Coords& new_origin) {
 	}
 	// Now that we restructured the fields, we just overwrite the old order
 	fields_ = std::move(new_field_order);
+	refresh_layers();
 
 	//  Inform immovables and bobs about their new coordinates.
 	for (FCoords c(Coords(0, 0), fields_.get()); c.y < height_; ++c.y) {
@@ -729,6 +899,7 @@ void Map::resize(EditorGameBase& egbase, const Coords split, const int32_t w, co
 	width_ = w;
 	height_ = h;
 	fields_ = std::move(new_fields);
+	refresh_layers();
 
 	// Always call allocate_player_maps() while changing the map's size.
 	// Forgetting to do so will result in random crashes.
@@ -789,6 +960,8 @@ void Map::set_to(EditorGameBase& egbase, ResizeHistory rh) {
 	width_ = rh.size.w;
 	height_ = rh.size.h;
 	fields_.reset(new Field[static_cast<uint64_t>(width_) * height_]);
+	layers_.resize(max_index());
+	object_tiles_.reset(width_, height_);
 	egbase.allocate_player_maps();
 
 	// Overwrite starting locations and port spaces
@@ -799,11 +972,9 @@ void Map::set_to(EditorGameBase& egbase, ResizeHistory rh) {
 	for (MapIndex i = max_index(); i != 0u; --i) {
 		const FieldData& fd = rh.fields.front();
 		Field& f = fields_[i - 1];
-		f.set_terrains(fd.terrains);
-		f.set_height(fd.height);
-		f.resources = fd.resources;
-		f.initial_res_amount = fd.resource_amount;
-		f.res_amount = fd.resource_amount;
+		set_field_terrains(f, fd.terrains);
+		set_field_height(f, fd.height);
+		set_field_resources(f, fd.resources, fd.resource_amount, fd.resource_amount);
 		rh.fields.pop_front();
 	}
 	// Calculate nodecaps and stuff
@@ -837,10 +1008,80 @@ void Map::set_size(const uint32_t w, const uint32_t h) {
 	const uint32_t field_size = w * h;
 
 	fields_.reset(new Field[field_size]());
+	layers_.resize(field_size);
+	object_tiles_.reset(w, h);
 
 	pathfieldmgr_->set_size(field_size);
 }
 
+void Map::refresh_layers() {
+	const MapIndex size = max_index();
+	layers_.resize(size);
+	for (MapIndex i = 0; i < size; ++i) {
+		const Field& f = fields_[i];
+		layers_.heights[i] = f.get_height();
+		layers_.caps[i] = f.caps;
+		layers_.max_caps[i] = f.max_caps;
+		layers_.terrains[i] = f.get_terrains();
+		layers_.owners[i] = f.get_owned_by();
+		layers_.resources[i] = f.get_resources();
+		layers_.resource_amounts[i] = f.get_resources_amount();
+	}
+
+	object_tiles_.reset(width_, height_);
+	for (FCoords c(Coords(0, 0), fields_.get()); c.y < height_; ++c.y) {
+		for (c.x = 0; c.x < width_; ++c.x, ++c.field) {
+			if (const BaseImmovable* imm = c.field->get_immovable()) {
+				add_immovable_to_tile(c, *imm);
+			}
+			for (Bob* bob = c.field->get_first_bob(); bob != nullptr; bob = bob->get_next_bob()) {
+				add_bob_to_tile(c);
+			}
+		}
+	}
+}
+
+void Map::add_bob_to_tile(const Coords& c) {
+	++object_tiles_.bobs[object_tiles_.tile(c)];
+}
+
+void Map::remove_bob_from_tile(const Coords& c) {
+	const size_t tile = object_tiles_.tile(c);
+	assert(object_tiles_.bobs[tile] > 0);
+	--object_tiles_.bobs[tile];
+}
+
+void Map::add_immovable_to_tile(const Coords& c, const BaseImmovable& imm) {
+	const size_t tile = object_tiles_.tile(c);
+	++object_tiles_.immovables[tile];
+	object_tiles_.immovable_attributes[tile] |= attribute_mask(imm);
+}
+
+void Map::remove_immovable_from_tile(const Coords& c) {
+	const size_t tile = object_tiles_.tile(c);
+	assert(object_tiles_.immovables[tile] > 0);
+	if (--object_tiles_.immovables[tile] == 0) {
+		object_tiles_.immovable_attributes[tile] = 0U;
+		return;
+	}
+
+	// The remaining immovables might still have the removed one's attributes
+	uint64_t mask = 0U;
+	const int16_t x0 = c.x - c.x % MapObjectTiles::kSize;
+	const int16_t y0 = c.y - c.y % MapObjectTiles::kSize;
+	const int16_t x1 = std::min<int16_t>(x0 + MapObjectTiles::kSize, width_);
+	const int16_t y1 = std::min<int16_t>(y0 + MapObjectTiles::kSize, height_);
+	for (int16_t y = y0; y < y1; ++y) {
+		const Field* f = &fields_[get_index(Coords(x0, y), width_)];
+		for (int16_t x = x0; x < x1; ++x, ++f) {
+			if (const BaseImmovable* imm = f->get_immovable()) {
+				mask |= attribute_mask(*imm);
+			}
+		}
+	}
+	object_tiles_.immovable_attributes[tile] = mask;
+}
+
 const std::string& Map::minimum_required_widelands_version() const {
 	return map_version_.minimum_required_widelands_version;
 }
@@ -1080,6 +1321,11 @@ BaseImmovable* Map::get_immovable(const Coords& coord) const {
 	return operator[](coord).get_immovable();
 }
 
+PathfieldManager& Map::pathfields_for_this_thread() const {
+	PathfieldManager* const manager = PathfieldManager::for_this_thread();
+	return manager != nullptr ? *manager : *pathfieldmgr_;
+}
+
 /*
 ===============
 Call the functor for every field that can be reached from coord without moving
@@ -1093,8 +1339,10 @@ void Map::find_reachable(const EditorGameBase& egbase,
                          const Area<FCoords>& area,
                          const CheckStep& checkstep,
                          functorT& functor) const {
-	MutexLock m(MutexLock::ID::kPathfinding);
-	std::shared_ptr<Pathfields> pathfields = pathfieldmgr_->allocate();
+	// Threads with their own pathfields do not need to wait for each other
+	MutexLock m(PathfieldManager::for_this_thread() != nullptr ? MutexLock::ID::kNone :
+	                                                             MutexLock::ID::kPathfinding);
+	std::shared_ptr<Pathfields> pathfields = pathfields_for_this_thread().allocate();
 
 	std::vector<Coords> queue;
 	queue.push_back(area);
@@ -1143,6 +1391,56 @@ void Map::find(const EditorGameBase& egbase, const Area<FCoords>& area, functorT
 	} while (mr.advance(*this));
 }
 
+template <typename functorT, typename occupiedT>
+void Map::find_on_tiles(const EditorGameBase& egbase,
+                        const Area<FCoords>& area,
+                        const occupiedT& occupied,
+                        functorT& functor) const {
+	// Visit the rows of the area in the same order as MapRegion, so that the
+	// objects are found in the same order as with find()
+	for_each_area_run(*this, area, [&](MapIndex const first, MapIndex const count) {
+		const int16_t y = first / width_;
+		const MapIndex row_start = static_cast<MapIndex>(y) * width_;
+		const size_t row_tiles = static_cast<size_t>(y / MapObjectTiles::kSize) *
+		                         object_tiles_.columns;
+		const MapIndex end = first + count;
+		for (MapIndex i = first; i < end;) {
+			const int16_t tile_x = (i - row_start) / MapObjectTiles::kSize;
+			const MapIndex tile_end =
+			   std::min<MapIndex>(end, row_start + (tile_x + 1) * MapObjectTiles::kSize);
+			if (occupied(row_tiles + tile_x)) {
+				for (; i < tile_end; ++i) {
+					functor(egbase, FCoords(Coords(i - row_start, y), &fields_[i]));
+				}
+			} else {
+				i = tile_end;
+			}
+		}
+	});
+}
+
+template <typename occupiedT>
+bool Map::any_tile(const Area<FCoords>& area, const occupiedT& occupied) const {
+	bool result = false;
+	for_each_area_run(*this, area, [&](MapIndex const first, MapIndex const count) {
+		if (result) {
+			return;
+		}
+		const int16_t y = first / width_;
+		const int16_t x = first - static_cast<MapIndex>(y) * width_;
+		const size_t row_tiles = static_cast<size_t>(y / MapObjectTiles::kSize) *
+		                         object_tiles_.columns;
+		const int16_t last_tile_x = (x + count - 1) / MapObjectTiles::kSize;
+		for (int16_t tile_x = x / MapObjectTiles::kSize; tile_x <= last_tile_x; ++tile_x) {
+			if (occupied(row_tiles + tile_x)) {
+				result = true;
+				return;
+			}
+		}
+	});
+	return result;
+}
+
 /*
 ===============
 FindBobsCallback
@@ -1190,8 +1488,10 @@ uint32_t Map::find_bobs(const EditorGameBase& egbase,
                         std::vector<Bob*>* const list,
                         const FindBob& functor) const {
 	FindBobsCallback cb(list, functor);
+	const std::vector<uint32_t>& bobs = object_tiles_.bobs;
 
-	find(egbase, area, cb);
+	find_on_tiles(
+	   egbase, area, [&bobs](size_t const tile) { return bobs[tile] != 0; }, cb);
 
 	return cb.found_;
 }
@@ -1214,8 +1514,11 @@ uint32_t Map::find_reachable_bobs(const EditorGameBase& egbase,
                                   const CheckStep& checkstep,
                                   const FindBob& functor) const {
 	FindBobsCallback cb(list, functor);
+	const std::vector<uint32_t>& bobs = object_tiles_.bobs;
 
-	find_reachable(egbase, area, checkstep, cb);
+	if (any_tile(area, [&bobs](size_t const tile) { return bobs[tile] != 0; })) {
+		find_reachable(egbase, area, checkstep, cb);
+	}
 
 	return cb.found_;
 }
@@ -1256,6 +1559,25 @@ struct FindImmovablesCallback {
 	uint32_t found_{0U};
 };
 
+/// Whether a tile might contain immovables that the functor accepts
+struct OccupiedImmovableTiles {
+	OccupiedImmovableTiles(const MapObjectTiles& tiles, const FindImmovable& functor)
+	   : tiles_(tiles),
+	     attribute_(functor.required_attribute() < 0 ?
+	                   0U :
+	                   MapObjectTiles::attribute_bit(functor.required_attribute())) {
+	}
+
+	bool operator()(size_t const tile) const {
+		return attribute_ == 0U ? tiles_.immovables[tile] != 0 :
+		                          (tiles_.immovable_attributes[tile] & attribute_) != 0U;
+	}
+
+private:
+	const MapObjectTiles& tiles_;
+	uint64_t attribute_;
+};
+
 /*
 ===============
 Find all immovables in the given area for which functor returns true
@@ -1270,7 +1592,7 @@ uint32_t Map::find_immovables(const EditorGameBase& egbase,
                               const FindImmovable& functor) const {
 	FindImmovablesCallback cb(list, functor);
 
-	find(egbase, area, cb);
+	find_on_tiles(egbase, area, OccupiedImmovableTiles(object_tiles_, functor), cb);
 
 	return cb.found_;
 }
@@ -1292,7 +1614,9 @@ uint32_t Map::find_reachable_immovables(const EditorGameBase& egbase,
                                         const FindImmovable& functor) const {
 	FindImmovablesCallback cb(list, functor);
 
-	find_reachable(egbase, area, checkstep, cb);
+	if (any_tile(area, OccupiedImmovableTiles(object_tiles_, functor))) {
+		find_reachable(egbase, area, checkstep, cb);
+	}
 
 	return cb.found_;
 }
@@ -1475,8 +1799,8 @@ above recalc_brightness.
 ===============
 */
 void Map::recalc_nodecaps_pass1(const EditorGameBase& egbase, const FCoords& f) {
-	f.field->caps = calc_nodecaps_pass1(egbase, f, true);
-	f.field->max_caps = calc_nodecaps_pass1(egbase, f, false);
+	set_field_caps(
+	   *f.field, calc_nodecaps_pass1(egbase, f, true), calc_nodecaps_pass1(egbase, f, false));
 }
 
 NodeCaps
@@ -1624,15 +1948,16 @@ Important: flag buildability has already been checked in the first pass.
 ===============
 */
 void Map::recalc_nodecaps_pass2(const EditorGameBase& egbase, const FCoords& f) {
-	f.field->caps = calc_nodecaps_pass2(egbase, f, true);
-	f.field->max_caps =
-	   calc_nodecaps_pass2(egbase, f, false, static_cast<NodeCaps>(f.field->max_caps));
+	set_field_caps(
+	   *f.field, calc_nodecaps_pass2(egbase, f, true),
+	   calc_nodecaps_pass2(egbase, f, false, static_cast<NodeCaps>(f.field->max_caps)));
 }
 
 NodeCaps Map::calc_nodecaps_pass2(const EditorGameBase& egbase,
                                   const FCoords& f,
                                   bool consider_mobs,
-                                  NodeCaps initcaps) const {
+                                  NodeCaps initcaps,
+                                  const NodeSlopes* slopes) const {
 	uint8_t caps = consider_mobs ? f.field->caps : static_cast<uint8_t>(initcaps);
 
 	// NOTE  This dependency on the bottom-right neighbour is the reason
@@ -1688,24 +2013,18 @@ NodeCaps Map::calc_nodecaps_pass2(const EditorGameBase& egbase,
 			caps |= BUILDCAPS_MINE;
 		}
 	} else {
-		Field::Height const f_height = f.field->get_height();
+		const NodeSlopes node_slopes = slopes != nullptr ? *slopes : calc_node_slopes(f);
 
 		// Reduce building size based on slope of direct neighbours:
 		//  - slope >= 4: can't build anything here -> return
 		//  - slope >= 3: maximum size is small
-		{
-			MapFringeRegion<Area<FCoords>> mr(*this, Area<FCoords>(f, 1));
-			do {
-				uint16_t const slope = abs(mr.location().field->get_height() - f_height);
-				if (slope >= 4) {
-					return static_cast<NodeCaps>(caps);
-				}
-				if (slope >= 3) {
-					buildsize = BaseImmovable::SMALL;
-				}
-			} while (mr.advance(*this));
+		if (node_slopes.first_order >= 4) {
+			return static_cast<NodeCaps>(caps);
+		}
+		if (node_slopes.first_order >= 3) {
+			buildsize = BaseImmovable::SMALL;
 		}
-		if (abs(br.field->get_height() - f_height) >= 2) {
+		if (node_slopes.bottom_right >= 2) {
 			return static_cast<NodeCaps>(caps);
 		}
 
@@ -1714,15 +2033,8 @@ NodeCaps Map::calc_nodecaps_pass2(const EditorGameBase& egbase,
 		// order neighbour is >= 3, we can only build a small house here.
 		// Additionally, we can potentially build a port on this field
 		// if one of the second order neighbours is swimmable.
-		if (buildsize >= BaseImmovable::MEDIUM) {
-			MapFringeRegion<Area<FCoords>> mr(*this, Area<FCoords>(f, 2));
-
-			do {
-				if (abs(mr.location().field->get_height() - f_height) >= 3) {
-					buildsize = BaseImmovable::SMALL;
-					break;
-				}
-			} while (mr.advance(*this));
+		if (buildsize >= BaseImmovable::MEDIUM && node_slopes.second_order >= 3) {
+			buildsize = BaseImmovable::SMALL;
 		}
 
 		if ((buildsize == BaseImmovable::BIG) && is_port_space(f) &&
@@ -1735,6 +2047,27 @@ NodeCaps Map::calc_nodecaps_pass2(const EditorGameBase& egbase,
 	return static_cast<NodeCaps>(caps);
 }
 
+NodeSlopes Map::calc_node_slopes(const FCoords& f) const {
+	NodeSlopes slopes;
+	const int f_height = f.field->get_height();
+	{
+		MapFringeRegion<Area<FCoords>> mr(*this, Area<FCoords>(f, 1));
+		do {
+			slopes.first_order = std::max<int>(
+			   slopes.first_order, std::abs(mr.location().field->get_height() - f_height));
+		} while (mr.advance(*this));
+	}
+	slopes.bottom_right = std::abs(br_n(f).field->get_height() - f_height);
+	{
+		MapFringeRegion<Area<FCoords>> mr(*this, Area<FCoords>(f, 2));
+		do {
+			slopes.second_order = std::max<int>(
+			   slopes.second_order, std::abs(mr.location().field->get_height() - f_height));
+		} while (mr.advance(*this));
+	}
+	return slopes;
+}
+
 /**
  * Return the size of immovable that is supposed to be buildable on \p f,
  * based on immovables on \p f and its neighbours.
@@ -2216,6 +2549,61 @@ std::unique_ptr<MapLoader> Map::get_correct_loader(const std::string& filename)
 	return result;
 }
 
+namespace {
+// Indexes the pathfields of the nodes within a square around a node, row by
+// row. A search that cannot leave the square then touches far less memory than
+// with the pathfields for the whole map. Along an axis that the square would
+// wrap around, it covers the whole map instead.
+class PathfieldWindow {
+public:
+	PathfieldWindow(const Map& map, const Coords& center, int32_t const radius)
+	   : map_width_(map.get_width()), map_height_(map.get_height()) {
+		const int32_t size = 2 * radius + 1;
+		if (size < map_width_) {
+			width_ = size;
+			left_ = center.x - radius < 0 ? center.x - radius + map_width_ : center.x - radius;
+		} else {
+			width_ = map_width_;
+			left_ = 0;
+		}
+		if (size < map_height_) {
+			height_ = size;
+			top_ = center.y - radius < 0 ? center.y - radius + map_height_ : center.y - radius;
+		} else {
+			height_ = map_height_;
+			top_ = 0;
+		}
+	}
+
+	[[nodiscard]] bool is_whole_map() const {
+		return width_ == map_width_ && height_ == map_height_;
+	}
+	[[nodiscard]] uint32_t size() const {
+		return static_cast<uint32_t>(width_) * height_;
+	}
+
+	[[nodiscard]] uint32_t index(const Coords& c) const {
+		const int32_t x = c.x < left_ ? c.x - left_ + map_width_ : c.x - left_;
+		const int32_t y = c.y < top_ ? c.y - top_ + map_height_ : c.y - top_;
+		assert(x < width_ && y < height_);
+		return y * width_ + x;
+	}
+	[[nodiscard]] Coords coords(uint32_t const index) const {
+		const int32_t x = left_ + index % width_;
+		const int32_t y = top_ + index / width_;
+		return Coords(x < map_width_ ? x : x - map_width_, y < map_height_ ? y : y - map_height_);
+	}
+
+private:
+	const int32_t map_width_;
+	const int32_t map_height_;
+	int32_t left_;
+	int32_t top_;
+	int32_t width_;
+	int32_t height_;
+};
+}  // namespace
+
 /**
  * Finds a path from start to end for a MapObject with the given movecaps.
  *
@@ -2250,6 +2638,7 @@ int32_t Map::findpath(Coords instart,
                       uint32_t const flags,
                       uint32_t const caps_sensitivity,
                       WareWorker type) const {
+	SimulationProfiler::ScopedSample sample(SimulationProfiler::Section::kPathfinding);
 	FCoords start;
 	FCoords end;
 	int32_t upper_cost_limit;
@@ -2281,11 +2670,23 @@ int32_t Map::findpath(Coords instart,
 		upper_cost_limit = persist * calc_cost_estimate(start, end);
 	}
 
+	// Every step costs at least as much as walking downhill, so with a cost
+	// limit the search never gets further from the start than this
+	const PathfieldWindow window(
+	   *this, start,
+	   upper_cost_limit == 0 ? width_ + height_ :
+	                           upper_cost_limit / calc_cost(-SLOPE_COST_STEPS) + 1);
+
 	// Actual pathfinding
-	MutexLock m(MutexLock::ID::kPathfinding);
-	std::shared_ptr<Pathfields> pathfields = pathfieldmgr_->allocate();
-	Pathfield::Queue Open(type);
-	Pathfield* curpf = &pathfields->fields[start.field - fields_.get()];
+	MutexLock m(PathfieldManager::for_this_thread() != nullptr ? MutexLock::ID::kNone :
+	                                                             MutexLock::ID::kPathfinding);
+	PathfieldManager& manager = pathfields_for_this_thread();
+	std::shared_ptr<Pathfields> pathfields =
+	   window.is_whole_map() ? manager.allocate() : manager.allocate_window(window.size());
+	Pathfield::Queue& Open = pathfields->open;
+	Open.reset(type);
+	uint64_t nodes_expanded = 0U;
+	Pathfield* curpf = &pathfields->fields[window.index(start)];
 	curpf->cycle = pathfields->cycle;
 	curpf->real_cost = 0;
 	curpf->estim_cost = calc_cost_lowerbound(start, end);
@@ -2295,13 +2696,14 @@ int32_t Map::findpath(Coords instart,
 
 	for (;;) {
 		if (Open.empty()) {  // there simply is no path
+			PathfieldManager::add_search(!window.is_whole_map(), nodes_expanded);
 			return -1;
 		}
 		curpf = Open.top();
 		Open.pop(curpf);
+		++nodes_expanded;
 
-		cur.field = fields_.get() + (curpf - pathfields->fields.get());
-		get_coords(*cur.field, cur);
+		cur = get_fcoords(window.coords(curpf - pathfields->fields.get()));
 
 		if ((upper_cost_limit != 0) && curpf->real_cost > upper_cost_limit) {
 			break;  // upper cost limit reached, give up
@@ -2321,7 +2723,7 @@ int32_t Map::findpath(Coords instart,
 			int32_t cost;
 
 			get_neighbour(cur, *direction, &neighb);
-			Pathfield& neighbpf = pathfields->fields[neighb.field - fields_.get()];
+			Pathfield& neighbpf = pathfields->fields[window.index(neighb)];
 
 			// Is the field Closed already?
 			if (neighbpf.cycle == pathfields->cycle && !neighbpf.heap_cookie.is_active()) {
@@ -2365,6 +2767,8 @@ int32_t Map::findpath(Coords instart,
 		}
 	}
 
+	PathfieldManager::add_search(!window.is_whole_map(), nodes_expanded);
+
 	// Now unwind the taken route (even if we couldn't find a complete one!)
 	int32_t const result = cur == end ? curpf->real_cost : -1;
 
@@ -2378,7 +2782,7 @@ int32_t Map::findpath(Coords instart,
 
 		// Reverse logic! (WALK_NW needs to find the SE neighbour)
 		get_neighbour(cur, get_reverse_dir(curpf->backlink), &cur);
-		curpf = &pathfields->fields[cur.field - fields_.get()];
+		curpf = &pathfields->fields[window.index(cur)];
 	}
 
 	return result;
@@ -2406,7 +2810,7 @@ bool Map::can_reach_by_water(const Coords& field) const {
 int32_t Map::change_terrain(const EditorGameBase& egbase,
                             TCoords<FCoords> const c,
                             DescriptionIndex const terrain) {
-	c.node.field->set_terrain(c.t, terrain);
+	set_field_terrain(*c.node.field, c.t, terrain);
 
 	// remove invalid resources if necessary
 	// check vertex to which the triangle belongs
@@ -2492,9 +2896,7 @@ void Map::initialize_resources(const FCoords& c,
 	if (resource_type == Widelands::kNoResource) {
 		amount = 0;
 	}
-	c.field->resources = resource_type;
-	c.field->initial_res_amount = amount;
-	c.field->res_amount = amount;
+	set_field_resources(*c.field, resource_type, amount, amount);
 }
 
 void Map::set_resources(const FCoords& c, ResourceAmount amount) {
@@ -2502,7 +2904,7 @@ void Map::set_resources(const FCoords& c, ResourceAmount amount) {
 	if (c.field->resources == Widelands::kNoResource) {
 		return;
 	}
-	c.field->res_amount = amount;
+	set_field_resources(*c.field, c.field->resources, c.field->initial_res_amount, amount);
 }
 
 void Map::clear_resources(const FCoords& c) {
@@ -2513,7 +2915,7 @@ uint32_t Map::set_height(const EditorGameBase& egbase, const FCoords fc, uint8_t
 	assert(new_value <= MAX_FIELD_HEIGHT);
 	assert(fields_.get() <= fc.field);
 	assert(fc.field < fields_.get() + max_index());
-	fc.field->height = new_value;
+	set_field_height(*fc.field, new_value);
 	uint32_t radius = 2;
 	check_neighbour_heights(fc, radius);
 	recalc_for_field_area(egbase, Area<FCoords>(fc, radius));
@@ -2531,13 +2933,14 @@ uint32_t Map::change_height(const EditorGameBase& egbase,
 				continue;
 			}
 
-			if (difference < 0 && mr.location().field->height < static_cast<uint8_t>(-difference)) {
-				mr.location().field->height = 0;
+			Field& f = *mr.location().field;
+			if (difference < 0 && f.height < static_cast<uint8_t>(-difference)) {
+				set_field_height(f, 0);
 			} else if (static_cast<int16_t>(MAX_FIELD_HEIGHT) - difference <
-			           static_cast<int16_t>(mr.location().field->height)) {
-				mr.location().field->height = MAX_FIELD_HEIGHT;
+			           static_cast<int16_t>(f.height)) {
+				set_field_height(f, MAX_FIELD_HEIGHT);
 			} else {
-				mr.location().field->height += difference;
+				set_field_height(f, f.height + difference);
 			}
 		} while (mr.advance(*this));
 	}
@@ -2566,10 +2969,11 @@ uint32_t Map::set_height(const EditorGameBase& egbase,
 				continue;
 			}
 
-			if (mr.location().field->height < height_interval.min) {
-				mr.location().field->height = height_interval.min;
-			} else if (height_interval.max < mr.location().field->height) {
-				mr.location().field->height = height_interval.max;
+			Field& f = *mr.location().field;
+			if (f.height < height_interval.min) {
+				set_field_height(f, height_interval.min);
+			} else if (height_interval.max < f.height) {
+				set_field_height(f, height_interval.max);
 			}
 		} while (mr.advance(*this));
 	}
@@ -2586,11 +2990,12 @@ uint32_t Map::set_height(const EditorGameBase& egbase,
                                   height_interval.max + max_field_height_diff() :
                                   MAX_FIELD_HEIGHT;
 			do {
-				if (mr.location().field->height < height_interval.min) {
-					mr.location().field->height = height_interval.min;
+				Field& f = *mr.location().field;
+				if (f.height < height_interval.min) {
+					set_field_height(f, height_interval.min);
 					changed = true;
-				} else if (height_interval.max < mr.location().field->height) {
-					mr.location().field->height = height_interval.max;
+				} else if (height_interval.max < f.height) {
+					set_field_height(f, height_interval.max);
 					changed = true;
 				}
 			} while (mr.advance(*this));
@@ -2627,12 +3032,12 @@ void Map::check_neighbour_heights(FCoords coords, uint32_t& area) {
 		const int32_t diff = height - f.get_height();
 		if (diff > max_field_height_diff()) {
 			++area;
-			f.set_height(height - max_field_height_diff());
+			set_field_height(f, height - max_field_height_diff());
 			check[i] = true;
 		}
 		if (diff < -max_field_height_diff()) {
 			++area;
-			f.set_height(height + max_field_height_diff());
+			set_field_height(f, height + max_field_height_diff());
 			check[i] = true;
 		}
 	}
@@ -47,6 +47,7 @@ class CritterDescr;
 class EditorGameBase;
 class MapLoader;
 struct MapGenerator;
+struct NodeSlopes;
 struct PathfieldManager;
 class Descriptions;
 
@@ -155,6 +156,58 @@ struct ResizeHistory {
 	std::vector<Coords> starting_positions;
 };
 
+/**
+ * The attributes of all nodes that whole-map passes read most often, stored as
+ * separate arrays that are indexed by MapIndex. A pass that only looks at e.g.
+ * the heights then streams through one byte per node, instead of pulling whole
+ * Fields through the cache.
+ *
+ * The Fields remain the interface for single nodes. Map keeps the layers in
+ * sync with them, so all changes to these attributes must go through Map.
+ */
+struct MapLayers {
+	void resize(size_t size);
+
+	std::vector<Field::Height> heights;
+	std::vector<uint8_t> caps;      ///< NodeCaps, considering mobile objects
+	std::vector<uint8_t> max_caps;  ///< NodeCaps, ignoring mobile objects
+	std::vector<Field::Terrains> terrains;
+	std::vector<PlayerNumber> owners;
+	std::vector<DescriptionIndex> resources;
+	std::vector<Field::ResourceAmount> resource_amounts;
+};
+
+/**
+ * A coarse index of the bobs and immovables on the map. The map is divided into
+ * tiles of kSize × kSize nodes, and for every tile we count the bobs and the
+ * immovables on its nodes. Area searches for objects can then skip all nodes of
+ * empty tiles without looking at their Fields.
+ *
+ * For immovables, we also keep a mask of the attributes that they have, with
+ * attribute id i mapped to bit i % 64, so that searches for an attribute can
+ * skip tiles without any immovable that might have it.
+ *
+ * Map keeps the index in sync whenever an object is linked to or unlinked from
+ * a Field.
+ */
+struct MapObjectTiles {
+	static constexpr int16_t kSize = 8;
+
+	void reset(int16_t map_width, int16_t map_height);
+
+	[[nodiscard]] size_t tile(const Coords& c) const {
+		return static_cast<size_t>(c.y / kSize) * columns + c.x / kSize;
+	}
+	[[nodiscard]] static uint64_t attribute_bit(uint32_t attribute) {
+		return uint64_t(1) << (attribute % 64);
+	}
+
+	size_t columns{0U};
+	std::vector<uint32_t> bobs;
+	std::vector<uint32_t> immovables;
+	std::vector<uint64_t> immovable_attributes;
+};
+
 // Minimum distance between two starting positions
 constexpr uint16_t kMinSpaceAroundPlayers = 24;
 
@@ -236,6 +289,9 @@ public:
 	void recalc_whole_map_brightness();
 	void recalc_for_field_area(const EditorGameBase&, Area<FCoords>);
 
+	/// The height differences around 'f' that limit the size of buildings on it.
+	[[nodiscard]] NodeSlopes calc_node_slopes(const FCoords& f) const;
+
 	/**
 	 *  If the valuable fields are empty, calculates all fields that could be conquered by a player
 	 * throughout a game. Useful for territorial win conditions. Returns the amount of valuable
@@ -489,6 +545,31 @@ public:
 	 */
 	[[nodiscard]] bool can_reach_by_water(const Coords&) const;
 
+	/// The hot node attributes as separate arrays, for whole-map passes.
+	[[nodiscard]] const MapLayers& layers() const {
+		return layers_;
+	}
+
+	/// The number of objects per tile, for area searches.
+	[[nodiscard]] const MapObjectTiles& object_tiles() const {
+		return object_tiles_;
+	}
+	/// Keep the object tiles in sync. Bob and BaseImmovable call these whenever
+	/// they link themselves to or unlink themselves from a Field.
+	void add_bob_to_tile(const Coords&);
+	void remove_bob_from_tile(const Coords&);
+	void add_immovable_to_tile(const Coords&, const BaseImmovable&);
+	void remove_immovable_from_tile(const Coords&);
+
+	/// Raw setters for node attributes that are also stored in the layers. Use
+	/// these instead of the Field's own setters, which are private to Map.
+	/// Unlike set_height() and change_terrain(), they do not recalculate
+	/// brightness, nodecaps or resources.
+	void set_field_height(Field&, Field::Height);
+	void set_field_terrains(Field&, const Field::Terrains&);
+	void set_field_terrain(Field&, TriangleIndex, DescriptionIndex);
+	void set_field_owner(Field&, PlayerNumber);
+
 	/// Sets the height to a value. Recalculates brightness. Changes the
 	/// surrounding nodes if necessary. Returns the radius that covers all
 	/// changes that were made.
@@ -638,6 +719,10 @@ protected:
 	void calculate_minimum_required_widelands_version(bool is_post_one_world);
 
 private:
+	/// The map's pathfields, or the ones of this thread if it has its own
+	/// (see PathfieldManager::ScopedThreadPathfields).
+	[[nodiscard]] PathfieldManager& pathfields_for_this_thread() const;
+
 	void recalc_border(const FCoords&) const;
 	void recalc_brightness(const FCoords&) const;
 	void recalc_nodecaps_pass1(const EditorGameBase&, const FCoords&);
@@ -647,8 +732,29 @@ private:
 	[[nodiscard]] NodeCaps calc_nodecaps_pass2(const EditorGameBase&,
 	                                           const FCoords&,
 	                                           bool consider_mobs = true,
-	                                           NodeCaps initcaps = CAPS_NONE) const;
+	                                           NodeCaps initcaps = CAPS_NONE,
+	                                           const NodeSlopes* slopes = nullptr) const;
+	bool recalc_whole_map_batched(const EditorGameBase&);
+	void recalc_nodes_batched(const EditorGameBase&, const std::vector<FCoords>& nodes);
 	void check_neighbour_heights(FCoords, uint32_t& area);
+	void set_field_caps(Field&, uint8_t caps, uint8_t max_caps);
+	void set_field_resources(Field&,
+	                         DescriptionIndex resource_type,
+	                         ResourceAmount initial_amount,
+	                         ResourceAmount amount);
+	/// Copies the mirrored attributes of all fields into the layers, and counts
+	/// the objects on all fields for the object tiles.
+	void refresh_layers();
+	/// Calls 'functor' for the nodes of the area like find() does, but skips
+	/// the nodes of all tiles for which 'occupied(tile)' returns false.
+	template <typename functorT, typename occupiedT>
+	void find_on_tiles(const EditorGameBase&,
+	                   const Area<FCoords>&,
+	                   const occupiedT& occupied,
+	                   functorT&) const;
+	/// Whether 'occupied(tile)' returns true for any tile that overlaps the area.
+	template <typename occupiedT>
+	[[nodiscard]] bool any_tile(const Area<FCoords>&, const occupiedT& occupied) const;
 	int calc_buildsize(const EditorGameBase&,
 	                   const FCoords& f,
 	                   bool avoidnature,
@@ -684,6 +790,8 @@ private:
 
 	int max_field_height_diff_{kDefaultMaxFieldHeightDiff};
 	std::unique_ptr<Field[]> fields_;
+	MapLayers layers_;
+	MapObjectTiles object_tiles_;
 
 	std::unique_ptr<PathfieldManager> pathfieldmgr_;
 	std::vector<std::string> scenario_tribes_;
@@ -770,6 +878,41 @@ inline void Map::get_coords(Field& f, Coords& c) const {
 	c = get_fcoords(f);
 }
 
+inline void Map::set_field_height(Field& f, Field::Height const h) {
+	f.set_height(h);
+	layers_.heights[&f - fields_.get()] = f.height;
+}
+inline void Map::set_field_terrains(Field& f, const Field::Terrains& t) {
+	f.set_terrains(t);
+	layers_.terrains[&f - fields_.get()] = t;
+}
+inline void Map::set_field_terrain(Field& f, TriangleIndex const t, DescriptionIndex const i) {
+	f.set_terrain(t, i);
+	layers_.terrains[&f - fields_.get()] = f.get_terrains();
+}
+inline void Map::set_field_owner(Field& f, PlayerNumber const n) {
+	f.set_owned_by(n);
+	layers_.owners[&f - fields_.get()] = n;
+}
+inline void Map::set_field_caps(Field& f, uint8_t const caps, uint8_t const max_caps) {
+	const MapIndex i = &f - fields_.get();
+	f.caps = caps;
+	f.max_caps = max_caps;
+	layers_.caps[i] = caps;
+	layers_.max_caps[i] = max_caps;
+}
+inline void Map::set_field_resources(Field& f,
+                                     DescriptionIndex const resource_type,
+                                     ResourceAmount const initial_amount,
+                                     ResourceAmount const amount) {
+	const MapIndex i = &f - fields_.get();
+	f.resources = resource_type;
+	f.initial_res_amount = initial_amount;
+	f.res_amount = amount;
+	layers_.resources[i] = resource_type;
+	layers_.resource_amounts[i] = amount;
+}
+
 /** get_ln, get_rn, get_tln, get_trn, get_bln, get_brn
  *
  * Calculate the coordinates and Field pointer of a neighboring field.
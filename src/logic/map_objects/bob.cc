@@ -132,6 +132,7 @@ void Bob::cleanup(EditorGameBase& egbase) {
 	set_owner(nullptr);  // implicitly remove ourselves from owner's map
 
 	if (position_.field != nullptr) {
+		egbase.mutable_map()->remove_bob_from_tile(position_);
 		position_.field = nullptr;
 		*linkpprev_ = linknext_;
 		if (linknext_ != nullptr) {
@@ -160,7 +161,7 @@ void Bob::act(Game& game, uint32_t const data) {
 	actscheduled_ = false;
 
 	if (stack_.empty()) {
-		signal_ = "";
+		signal_ = BobSignal::kNone;
 		init_auto_task(game);
 
 		if (stack_.empty()) {
@@ -312,7 +313,7 @@ Bob::State const* Bob::get_state(const Task& task) const {
 void Bob::signal_handled() {
 	assert(in_act_);
 
-	signal_.clear();
+	signal_ = BobSignal::kNone;
 }
 
 /**
@@ -325,10 +326,10 @@ void Bob::signal_handled() {
  * This function also calls all tasks' signal_immediate() function immediately.
  *
  * \param g the \ref Game object
- * \param sig the signal string
+ * \param sig the signal, must not be \ref BobSignal::kNone
  */
-void Bob::send_signal(Game& game, char const* const sig) {
-	assert(*sig);  //  use set_signal() for signal removal
+void Bob::send_signal(Game& game, const BobSignal sig) {
+	assert(sig != BobSignal::kNone);  //  use signal_handled() for signal removal
 
 	for (State& state : stack_) {
 		if (state.task->signal_immediate != nullptr) {
@@ -351,7 +352,7 @@ void Bob::reset_tasks(Game& game) {
 		do_pop_task(game);
 	}
 
-	signal_.clear();
+	signal_ = BobSignal::kNone;
 
 	++actid_;
 	schedule_act(game, Duration(10));
@@ -388,7 +389,7 @@ void Bob::start_task_idle(Game& game, uint32_t const anim, int32_t const timeout
 }
 
 void Bob::idle_update(Game& game, State& state) {
-	if ((state.ivar1 == 0) || !get_signal().empty()) {
+	if ((state.ivar1 == 0) || get_signal() != BobSignal::kNone) {
 		return pop_task(game);
 	}
 
@@ -636,7 +637,7 @@ bool Bob::start_task_movepath(Game& game,
 }
 
 void Bob::movepath_update(Game& game, State& state) {
-	if (!get_signal().empty()) {
+	if (get_signal() != BobSignal::kNone) {
 		return pop_task(game);
 	}
 
@@ -704,7 +705,7 @@ void Bob::start_task_move(Game& game,
 	int32_t const tdelta =
 	   start_walk(game, static_cast<WalkingDir>(dir), anims.get_animation(dir), forcemove);
 	if (tdelta < 0) {
-		return send_signal(game, tdelta == -2 ? "blocked" : "fail");
+		return send_signal(game, tdelta == -2 ? BobSignal::kBlocked : BobSignal::kFail);
 	}
 	push_task(game, taskMove, Duration(tdelta));
 }
@@ -921,15 +922,18 @@ void Bob::set_owner(Player* const player) {
  */
 void Bob::set_position(EditorGameBase& egbase, const Coords& coords) {
 	FCoords oldposition = position_;
+	Map* map = egbase.mutable_map();
 
 	if (position_.field != nullptr) {
 		*linkpprev_ = linknext_;
 		if (linknext_ != nullptr) {
 			linknext_->linkpprev_ = linkpprev_;
 		}
+		map->remove_bob_from_tile(position_);
 	}
 
-	position_ = egbase.map().get_fcoords(coords);
+	position_ = map->get_fcoords(coords);
+	map->add_bob_to_tile(position_);
 
 	linknext_ = position_.field->bobs;
 	linkpprev_ = &position_.field->bobs;
@@ -977,7 +981,7 @@ void Bob::log_general_info(const EditorGameBase& egbase) const {
 	molog(egbase.get_gametime(), "WalkingStart: %i\n", walkstart_.get());
 	molog(egbase.get_gametime(), "WalkEnd: %i\n", walkend_.get());
 
-	molog(egbase.get_gametime(), "Signal: %s\n", signal_.c_str());
+	molog(egbase.get_gametime(), "Signal: %s\n", to_string(signal_));
 
 	molog(egbase.get_gametime(), "Stack size: %" PRIuS "\n", stack_.size());
 
@@ -1077,7 +1081,7 @@ void Bob::Loader::load(FileRead& fr) {
 			}
 
 			bob.actid_ = fr.unsigned_32();
-			bob.signal_ = fr.c_string();
+			bob.signal_ = bob_signal_from_string(fr.c_string());
 
 			uint32_t stacksize = fr.unsigned_32();
 			bob.stack_.resize(stacksize);
@@ -1205,7 +1209,7 @@ void Bob::save(EditorGameBase& eg, MapObjectSaver& mos, FileWrite& fw) {
 	}
 
 	fw.unsigned_32(actid_);
-	fw.c_string(signal_);
+	fw.c_string(to_string(signal_));
 
 	fw.unsigned_32(stack_.size());
 	for (const State& state : stack_) {
@@ -23,6 +23,7 @@
 #include "base/vector.h"
 #include "economy/route.h"
 #include "graphic/animation/diranimations.h"
+#include "logic/map_objects/bob_signal.h"
 #include "logic/map_objects/info_to_draw.h"
 #include "logic/map_objects/map_object.h"
 #include "logic/map_objects/map_object_program.h"
@@ -152,7 +153,7 @@ public:
 
 	struct State;
 	using Ptr = void (Bob::*)(Game&, State&);
-	using PtrSignal = void (Bob::*)(Game&, State&, const std::string&);
+	using PtrSignal = void (Bob::*)(Game&, State&, BobSignal);
 
 	/// \see struct Bob for in-depth explanation
 	struct Task {
@@ -261,7 +262,7 @@ public:
 	void reset_tasks(Game&);
 
 	// TODO(feature-Hasi50): correct (?) Send a signal that may switch to some other \ref Task
-	void send_signal(Game&, char const*);
+	void send_signal(Game&, BobSignal);
 	void start_task_idle(Game&, uint32_t anim, int32_t timeout, Vector2i offset = Vector2i::zero());
 	[[nodiscard]] bool is_idle() const;
 
@@ -303,7 +304,7 @@ public:
 		return stack_.size();
 	}
 
-	[[nodiscard]] std::string get_signal() const {
+	[[nodiscard]] BobSignal get_signal() const {
 		return signal_;
 	}
 	[[nodiscard]] State* get_state(const Task&);
@@ -388,7 +389,7 @@ private:
 	 */
 	bool actscheduled_{false};
 	bool in_act_{false};  ///< if do_act is currently running
-	std::string signal_;
+	BobSignal signal_{BobSignal::kNone};
 
 	// saving and loading
 protected:
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "logic/map_objects/bob_signal.h"
+
+#include "logic/game_data_error.h"
+
+namespace Widelands {
+
+namespace {
+// Indexed by BobSignal
+constexpr const char* kSignalNames[] = {
+   "",         "battle", "blocked", "cancel", "cancel_expedition", "endshipping", "fail", "location",
+   "road",     "row",    "sleep",   "transfer", "update",          "wakeup",      "ware",
+};
+constexpr size_t kNrSignals = sizeof(kSignalNames) / sizeof(kSignalNames[0]);
+static_assert(kNrSignals == static_cast<size_t>(BobSignal::kWare) + 1,
+              "kSignalNames is out of sync with BobSignal");
+}  // namespace
+
+const char* to_string(const BobSignal signal) {
+	const size_t index = static_cast<size_t>(signal);
+	return index < kNrSignals ? kSignalNames[index] : "";
+}
+
+BobSignal bob_signal_from_string(const std::string& name) {
+	for (size_t i = 0; i < kNrSignals; ++i) {
+		if (name == kSignalNames[i]) {
+			return static_cast<BobSignal>(i);
+		}
+	}
+	throw GameDataError("unknown bob signal '%s'", name.c_str());
+}
+
+}  // namespace Widelands
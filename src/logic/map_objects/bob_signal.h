@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WL_LOGIC_MAP_OBJECTS_BOB_SIGNAL_H
+#define WL_LOGIC_MAP_OBJECTS_BOB_SIGNAL_H
+
+#include <cstdint>
+#include <string>
+
+namespace Widelands {
+
+/**
+ * The signals that can be sent to a \ref Bob to interrupt its current \ref Task.
+ *
+ * Signals used to be passed around as strings; they are now plain integers so that
+ * sending and dispatching them does not allocate. The names are still what ends up
+ * in savegames and logs, see \ref to_string() and \ref bob_signal_from_string().
+ */
+enum class BobSignal : uint8_t {
+	kNone = 0,  ///< No pending signal
+	kBattle,
+	kBlocked,
+	kCancel,
+	kCancelExpedition,
+	kEndShipping,
+	kFail,
+	kLocation,
+	kRoad,
+	kRow,
+	kSleep,
+	kTransfer,
+	kUpdate,
+	kWakeup,
+	kWare,
+};
+
+/// The savegame name of the signal. Returns an empty string for \ref BobSignal::kNone.
+const char* to_string(BobSignal signal);
+
+/// Inverse of \ref to_string(). Throws a GameDataError for unknown names.
+BobSignal bob_signal_from_string(const std::string& name);
+
+}  // namespace Widelands
+
+#endif  // end of include guard: WL_LOGIC_MAP_OBJECTS_BOB_SIGNAL_H
@@ -57,6 +57,10 @@ bool FindImmovableType::accept(const BaseImmovable& imm) const {
 	return type == imm.descr().type();
 }
 
+FindImmovable::FindImmovable(const FindImmovableAttribute& op)
+   : capsule(new Capsule<FindImmovableAttribute>(op)), required_attribute_(op.attribute()) {
+}
+
 bool FindImmovableAttribute::accept(const BaseImmovable& imm) const {
 	return imm.has_attribute(attrib);
 }
@@ -26,6 +26,7 @@
 namespace Widelands {
 
 struct BaseImmovable;
+struct FindImmovableAttribute;
 class ImmovableDescr;
 class Player;
 
@@ -58,9 +59,10 @@ private:
 	};
 
 	BaseCapsule* capsule;
+	int32_t required_attribute_{-1};
 
 public:
-	FindImmovable(const FindImmovable& o) {
+	FindImmovable(const FindImmovable& o) : required_attribute_(o.required_attribute_) {
 		capsule = o.capsule;
 		capsule->addref();
 	}
@@ -75,12 +77,21 @@ public:
 		capsule->deref();
 		capsule = o.capsule;
 		capsule->addref();
+		required_attribute_ = o.required_attribute_;
 		return *this;
 	}
 
 	template <typename T> FindImmovable(const T& op) {  // NOLINT allow implicit conversion
 		capsule = new Capsule<T>(op);
 	}
+	// Also remembers the attribute, so that area searches can skip the map's object tiles
+	// without any immovable that has it
+	FindImmovable(const FindImmovableAttribute& op);  // NOLINT allow implicit conversion
+
+	/// The attribute that all accepted immovables have, or -1 if there is no such requirement
+	[[nodiscard]] int32_t required_attribute() const {
+		return required_attribute_;
+	}
 
 	// Return true if this node should be returned by find_fields()
 	[[nodiscard]] bool accept(const BaseImmovable& imm) const {
@@ -140,6 +151,10 @@ struct FindImmovableAttribute {
 
 	[[nodiscard]] bool accept(const BaseImmovable&) const;
 
+	[[nodiscard]] int32_t attribute() const {
+		return attrib;
+	}
+
 private:
 	int32_t attrib;
 };
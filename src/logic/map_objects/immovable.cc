@@ -87,6 +87,9 @@ void BaseImmovable::set_position(EditorGameBase& egbase, const Coords& c) {
 		f.field->immovable->remove(egbase);
 	}
 
+	if (f.field->immovable == nullptr) {
+		map->add_immovable_to_tile(f, *this);
+	}
 	f.field->immovable = this;
 
 	if (get_size() >= SMALL) {
@@ -126,7 +129,10 @@ void BaseImmovable::unset_position(EditorGameBase& egbase, const Coords& c) {
 		   f, map->get_index(f), NoteFieldTerrainChanged::Change::kImmovable});
 	}
 
-	f.field->immovable = nullptr;
+	if (f.field->immovable != nullptr) {
+		f.field->immovable = nullptr;
+		map->remove_immovable_from_tile(f);
+	}
 	egbase.inform_players_about_immovable(f.field - &(*map)[0], nullptr);
 
 	if (get_size() >= SMALL) {
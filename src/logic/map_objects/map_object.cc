@@ -150,7 +150,7 @@ void CmdAct::write(FileWrite& fw, EditorGameBase& egbase, MapObjectSaver& mos) {
 
 ObjectManager::~ObjectManager() {
 	// better not throw an exception in a destructor...
-	if (!objects_.empty()) {
+	if (nr_objects_ != 0) {
 		log_warn("ObjectManager: ouch! remaining objects\n");
 	}
 
@@ -166,30 +166,34 @@ void ObjectManager::cleanup(EditorGameBase& egbase) {
 	// If all wares (read: flags) of an economy are gone, but some workers remain,
 	// the economy is destroyed before workers detach. This can cause segfault.
 	// Destruction happens in correct order after this dirty quickie.
-	// Run at the end of game, algorithmic efficiency may be what it is.
 	const static std::vector<MapObjectType> killusfirst{
 	   MapObjectType::WARE,        MapObjectType::WATERWAY, MapObjectType::FERRY,
 	   MapObjectType::FERRY_FLEET, MapObjectType::SHIP,     MapObjectType::SHIP_FLEET,
 	   MapObjectType::PORTDOCK,    MapObjectType::WORKER,   MapObjectType::CARRIER,
 	   MapObjectType::SOLDIER,
 	};
+	// Removing an object can remove others as well and free their pages, so the
+	// objects are checked one by one rather than iterated over.
 	for (auto moi : killusfirst) {
-		while (!objects_.empty()) {
-			MapObjectMap::iterator it = objects_.begin();
-			while (it != objects_.end() && (moi) != it->second->descr_->type()) {
-				++it;
-			}
-			if (it == objects_.end()) {
-				break;
+		for (size_t page = 0; page < pages_.size(); ++page) {
+			for (Serial i = 0; i < kPageSize && pages_[page] != nullptr; ++i) {
+				MapObject* obj = pages_[page]->objects[i];
+				if (obj != nullptr && moi == obj->descr_->type()) {
+					obj->remove(egbase);
+				}
 			}
-			it->second->remove(egbase);
 		}
 	}
-	while (!objects_.empty()) {
-		MapObjectMap::iterator it = objects_.begin();
-		it->second->remove(egbase);
+	for (size_t page = 0; page < pages_.size(); ++page) {
+		for (Serial i = 0; i < kPageSize && pages_[page] != nullptr; ++i) {
+			if (MapObject* obj = pages_[page]->objects[i]; obj != nullptr) {
+				obj->remove(egbase);
+			}
+		}
 	}
+	assert(nr_objects_ == 0);
 
+	pages_.clear();
 	lastserial_ = 0;
 	is_cleaning_up_ = false;
 }
@@ -198,17 +202,49 @@ void ObjectManager::cleanup(EditorGameBase& egbase) {
  * Insert the given MapObject into the object manager
  */
 void ObjectManager::insert(MapObject* obj) {
+	const Serial last_page = lastserial_ >> kPageBits;
 	++lastserial_;
 	assert(lastserial_);
 	obj->serial_ = lastserial_;
-	objects_[lastserial_] = obj;
+
+	const Serial page = lastserial_ >> kPageBits;
+	if (page != last_page) {
+		// Nobody will be added to the previous page any more
+		release_page_if_empty(last_page);
+	}
+	if (page >= pages_.size()) {
+		pages_.resize(page + 1);
+	}
+	if (pages_[page] == nullptr) {
+		pages_[page] = std::make_unique<Page>();
+	}
+	pages_[page]->objects[lastserial_ & kPageMask] = obj;
+	++pages_[page]->nr_objects;
+	++nr_objects_;
 }
 
 /**
  * Remove the MapObject from the manager
  */
 void ObjectManager::remove(MapObject& obj) {
-	objects_.erase(obj.serial_);
+	const Serial page = obj.serial_ >> kPageBits;
+	if (page >= pages_.size() || pages_[page] == nullptr ||
+	    pages_[page]->objects[obj.serial_ & kPageMask] != &obj) {
+		return;
+	}
+	pages_[page]->objects[obj.serial_ & kPageMask] = nullptr;
+	--pages_[page]->nr_objects;
+	--nr_objects_;
+	// The current page is kept for the next objects
+	if (page != lastserial_ >> kPageBits) {
+		release_page_if_empty(page);
+	}
+}
+
+void ObjectManager::release_page_if_empty(Serial page) {
+	if (page < pages_.size() && pages_[page] != nullptr && pages_[page]->nr_objects == 0) {
+		pages_[page].reset();
+	}
 }
 
 /*
@@ -216,13 +252,20 @@ void ObjectManager::remove(MapObject& obj) {
  */
 std::vector<Serial> ObjectManager::all_object_serials_ordered() const {
 	std::vector<Serial> rv;
+	rv.reserve(nr_objects_);
 
-	for (const auto& o : objects_) {
-		rv.push_back(o.first);
+	// Pages and the objects in them are ordered by serial
+	for (size_t page = 0; page < pages_.size(); ++page) {
+		if (pages_[page] == nullptr) {
+			continue;
+		}
+		for (Serial i = 0; i < kPageSize; ++i) {
+			if (pages_[page]->objects[i] != nullptr) {
+				rv.push_back(static_cast<Serial>(page << kPageBits) | i);
+			}
+		}
 	}
 
-	std::sort(rv.begin(), rv.end());
-
 	return rv;
 }
 
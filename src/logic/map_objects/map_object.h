@@ -19,7 +19,9 @@
 #ifndef WL_LOGIC_MAP_OBJECTS_MAP_OBJECT_H
 #define WL_LOGIC_MAP_OBJECTS_MAP_OBJECT_H
 
+#include <array>
 #include <atomic>
+#include <memory>
 
 #include "base/macros.h"
 #include "graphic/animation/animation.h"
@@ -148,8 +150,8 @@ private:
  * buildings, animals, decorations, etc... most of the time, however, you'll
  * deal with one of the derived classes, BaseImmovable or Bob.
  *
- * Every MapObject has a unique serial number. This serial number is used as
- * key in the ObjectManager map, and in the safe ObjectPointer.
+ * Every MapObject has a unique serial number. This serial number is used to
+ * look the object up in the ObjectManager, and in the safe ObjectPointer.
  *
  * Unless you're perfectly sure about when an object can be destroyed you
  * should use an ObjectPointer or, better yet, the type safe OPtr template.
@@ -386,18 +388,31 @@ inline int32_t get_reverse_dir(int32_t const dir) {
 /**
  *
  * Keeps the list of all objects currently in the game.
+ *
+ * Serials are handed out in increasing order and never reused, so comparing
+ * serials compares the order in which the objects were created. Games that
+ * are loaded from a savegame create their objects in the saved order, so they
+ * order their objects the same way as the game that was saved.
+ *
+ * The objects are looked up in pages of consecutive serials. A page is freed
+ * as soon as all of its objects are gone, so the index only grows with the
+ * objects that are alive rather than with all objects that were ever created.
+ *
+ * Serials are only valid for the current game session. Savegames refer to
+ * objects by the file indices assigned by MapObjectSaver and MapObjectLoader.
  */
 struct ObjectManager {
-	using MapObjectMap = std::unordered_map<Serial, MapObject*>;
-
 	ObjectManager() = default;
 	~ObjectManager();
 
 	void cleanup(EditorGameBase&);
 
 	MapObject* get_object(Serial const serial) const {
-		const MapObjectMap::const_iterator it = objects_.find(serial);
-		return it != objects_.end() ? it->second : nullptr;
+		const Serial page = serial >> kPageBits;
+		if (page >= pages_.size() || pages_[page] == nullptr) {
+			return nullptr;
+		}
+		return pages_[page]->objects[serial & kPageMask];
 	}
 
 	void insert(MapObject*);
@@ -409,13 +424,31 @@ struct ObjectManager {
 	 */
 	std::vector<Serial> all_object_serials_ordered() const;
 
+	/// The number of objects currently in the game.
+	[[nodiscard]] size_t size() const {
+		return nr_objects_;
+	}
+
 	bool is_cleaning_up() const {
 		return is_cleaning_up_;
 	}
 
 private:
+	static constexpr unsigned kPageBits = 10;
+	static constexpr Serial kPageSize = Serial(1) << kPageBits;
+	static constexpr Serial kPageMask = kPageSize - 1;
+
+	struct Page {
+		std::array<MapObject*, kPageSize> objects{};
+		/// Number of objects in 'objects' that are not nullptr
+		uint32_t nr_objects{0U};
+	};
+
+	void release_page_if_empty(Serial page);
+
 	Serial lastserial_{0U};
-	MapObjectMap objects_;
+	size_t nr_objects_{0U};
+	std::vector<std::unique_ptr<Page>> pages_;
 
 	bool is_cleaning_up_{false};
 
@@ -180,7 +180,7 @@ void Battle::get_battle_work(Game& game, Soldier& soldier) {
 		opponent(soldier)->get_owner()->count_kill();
 		soldier.start_task_die(game);
 		molog(game.get_gametime(), "[battle] waking up winner %d\n", opponent(soldier)->serial());
-		opponent(soldier)->send_signal(game, "wakeup");
+		opponent(soldier)->send_signal(game, BobSignal::kWakeup);
 		return schedule_destroy(game);
 	}
 
@@ -235,7 +235,7 @@ void Battle::get_battle_work(Game& game, Soldier& soldier) {
 		calculate_round(game);
 
 		// Wake up opponent, so he could update his animation
-		opponent(soldier)->send_signal(game, "wakeup");
+		opponent(soldier)->send_signal(game, BobSignal::kWakeup);
 	}
 
 	if (roundFought) {
@@ -54,23 +54,23 @@ void Carrier::start_task_road(Game& game) {
  * Called by Road code when the road is split.
  */
 void Carrier::update_task_road(Game& game) {
-	send_signal(game, "road");
+	send_signal(game, BobSignal::kRoad);
 }
 
 void Carrier::road_update(Game& game, State& state) {
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (signal == "road" || signal == "ware") {
+	if (signal == BobSignal::kRoad || signal == BobSignal::kWare) {
 		// The road changed under us or we're supposed to pick up some ware
 		signal_handled();
-	} else if (signal == "blocked") {
+	} else if (signal == BobSignal::kBlocked) {
 		// Blocked by an ongoing battle
 		signal_handled();
 		set_animation(game, descr().get_animation("idle", this));
 		return schedule_act(game, Duration(250));
-	} else if (!signal.empty()) {
+	} else if (signal != BobSignal::kNone) {
 		// Something else happened (probably a location signal)
-		molog(game.get_gametime(), "[road]: Terminated by signal '%s'\n", signal.c_str());
+		molog(game.get_gametime(), "[road]: Terminated by signal '%s'\n", to_string(signal));
 		return pop_task(game);
 	}
 
@@ -146,17 +146,17 @@ void Carrier::start_task_transport(Game& game, int32_t const fromflag) {
 }
 
 void Carrier::transport_update(Game& game, State& state) {
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (signal == "road") {
+	if (signal == BobSignal::kRoad) {
 		signal_handled();
-	} else if (signal == "blocked") {
+	} else if (signal == BobSignal::kBlocked) {
 		// Blocked by an ongoing battle
 		signal_handled();
 		set_animation(game, descr().get_animation("idle", this));
 		return schedule_act(game, Duration(250));
-	} else if (!signal.empty()) {
-		molog(game.get_gametime(), "[transport]: Interrupted by signal '%s'\n", signal.c_str());
+	} else if (signal != BobSignal::kNone) {
+		molog(game.get_gametime(), "[transport]: Interrupted by signal '%s'\n", to_string(signal));
 		return pop_task(game);
 	}
 
@@ -170,7 +170,7 @@ void Carrier::transport_update(Game& game, State& state) {
 		RoadBase* road = dynamic_cast<RoadBase*>(get_location(game));
 		if (road == nullptr) {
 			molog(game.get_gametime(), "[transport]: Road was deleted, cancel");
-			send_signal(game, "cancel");
+			send_signal(game, BobSignal::kCancel);
 			return pop_task(game);
 		}
 		// If the ware should go to the building attached to our flag, walk
@@ -418,9 +418,9 @@ bool Carrier::notify_ware(Game& game, int32_t const flag) {
 	promised_pickup_to_ = flag;
 
 	if (state.task == &taskRoad) {
-		send_signal(game, "ware");
+		send_signal(game, BobSignal::kWare);
 	} else if (state.task == &taskWaitforcapacity) {
-		send_signal(game, "wakeup");
+		send_signal(game, BobSignal::kWakeup);
 	}
 	return true;
 }
@@ -68,10 +68,10 @@ void Ferry::start_task_unemployed(Game& game) {
 constexpr Duration kUnemployedLifetime(1000 * 60 * 10);  // 10 minutes
 
 void Ferry::unemployed_update(Game& game, State& /* state */) {
-	if (!get_signal().empty()) {
+	if (get_signal() != BobSignal::kNone) {
 		molog(
-		   game.get_gametime(), "[unemployed]: interrupted by signal '%s'\n", get_signal().c_str());
-		if (get_signal() == "row") {
+		   game.get_gametime(), "[unemployed]: interrupted by signal '%s'\n", to_string(get_signal()));
+		if (get_signal() == BobSignal::kRow) {
 			assert(destination_);
 			signal_handled();
 			unemployed_since_ = Time(0);
@@ -175,7 +175,7 @@ void Ferry::start_task_row(Game& game, const Waterway& ww) {
 	// Our new destination is the middle of the waterway
 	destination_.reset(
 	   new Coords(CoordPath(game.map(), ww.get_path()).get_coords()[ww.get_idle_index()]));
-	send_signal(game, "row");
+	send_signal(game, BobSignal::kRow);
 }
 
 void Ferry::row_update(Game& game, State& /* state */) {
@@ -185,17 +185,18 @@ void Ferry::row_update(Game& game, State& /* state */) {
 
 	const Map& map = game.map();
 
-	const std::string& signal = get_signal();
-	if (!signal.empty()) {
-		if (signal == "road" || signal == "fail" || signal == "row" || signal == "wakeup") {
-			molog(game.get_gametime(), "[row]: Got signal '%s' -> recalculate\n", signal.c_str());
+	const BobSignal signal = get_signal();
+	if (signal != BobSignal::kNone) {
+		if (signal == BobSignal::kRoad || signal == BobSignal::kFail || signal == BobSignal::kRow ||
+		    signal == BobSignal::kWakeup) {
+			molog(game.get_gametime(), "[row]: Got signal '%s' -> recalculate\n", to_string(signal));
 			signal_handled();
-		} else if (signal == "blocked") {
+		} else if (signal == BobSignal::kBlocked) {
 			molog(game.get_gametime(), "[row]: Blocked by a battle\n");
 			signal_handled();
 			return start_task_idle(game, descr().get_animation("idle", this), 900);
 		} else {
-			molog(game.get_gametime(), "[row]: Cancel due to signal '%s'\n", signal.c_str());
+			molog(game.get_gametime(), "[row]: Cancel due to signal '%s'\n", to_string(signal));
 			return pop_task(game);
 		}
 	}
@@ -277,7 +278,7 @@ void Ferry::set_destination(Game& game, Waterway* ww) {
 	if (ww != nullptr) {
 		start_task_row(game, *ww);
 	} else {
-		send_signal(game, "cancel");
+		send_signal(game, BobSignal::kCancel);
 	}
 }
 
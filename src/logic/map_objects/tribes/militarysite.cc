@@ -697,7 +697,7 @@ bool MilitarySite::get_building_work(Game& game, Worker& worker, bool /*success*
 				if (opponent->get_battle() == nullptr) {
 					soldier->start_task_defense(game, stayhome);
 					if (stayhome) {
-						opponent->send_signal(game, "sleep");
+						opponent->send_signal(game, BobSignal::kSleep);
 					}
 					return true;
 				}
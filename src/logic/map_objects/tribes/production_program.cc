@@ -909,7 +909,8 @@ void ProductionProgram::ActCall::execute(Game& game, ProductionSite& ps) const {
 	ProgramResult const program_result = ps.top_state().phase;
 
 	if (program_result == ProgramResult::kNone) {  //  The program has not yet been called.
-		return ps.program_start(game, program_name_);
+		assert(program_ != nullptr);
+		return ps.program_start(game, *program_);
 	}
 
 	switch (handling_methods_[program_result_index(program_result)]) {
@@ -2248,9 +2249,9 @@ const Buildcost& ProductionProgram::recruited_workers() const {
 	return recruited_workers_;
 }
 
-void ProductionProgram::validate_calls(const ProductionSiteDescr& descr) const {
+void ProductionProgram::validate_calls(const ProductionSiteDescr& descr) {
 	for (const auto& action : actions_) {
-		if (upcast(const ActCall, act_call, action.get())) {
+		if (upcast(ActCall, act_call, action.get())) {
 			const std::string& program_name = act_call->program_name();
 			if (name() == program_name) {
 				throw GameDataError("Production program '%s' in %s is calling itself",
@@ -2262,6 +2263,7 @@ void ProductionProgram::validate_calls(const ProductionSiteDescr& descr) const {
 				throw GameDataError("Trying to call unknown program '%s' in %s", program_name.c_str(),
 				                    descr.name().c_str());
 			}
+			act_call->set_program(*it->second);
 		}
 	}
 }
@@ -301,9 +301,17 @@ struct ProductionProgram : public MapObjectProgram {
 		[[nodiscard]] const std::string& program_name() const {
 			return program_name_;
 		}
+		[[nodiscard]] const ProductionProgram* program() const {
+			return program_;
+		}
+		/// Remember the called program, so that it need not be looked up by name when executing.
+		void set_program(const ProductionProgram& program) {
+			program_ = &program;
+		}
 
 	private:
 		std::string program_name_;
+		const ProductionProgram* program_{nullptr};
 		ProgramResultHandlingMethod handling_methods_[3];
 	};
 
@@ -585,8 +593,9 @@ struct ProductionProgram : public MapObjectProgram {
 	[[nodiscard]] uint8_t train_to_level() const {
 		return train_to_level_;
 	}
-	// Throws a GameDataError if we're trying to call an unknown program
-	void validate_calls(const ProductionSiteDescr& descr) const;
+	// Throws a GameDataError if we're trying to call an unknown program, and resolves the called
+	// programs otherwise
+	void validate_calls(const ProductionSiteDescr& descr);
 
 private:
 	std::string descname_;
@@ -199,10 +199,7 @@ ProductionSiteDescr::ProductionSiteDescr(const std::string& init_descname,
 		   "%s: Error in productionsite programs: no 'main' program defined", name().c_str());
 	}
 
-	// Check ActCall
-	for (const auto& caller : programs_) {
-		caller.second->validate_calls(*this);
-	}
+	resolve_program_calls();
 
 	if (table.has_key("indicate_workarea_overlaps")) {
 		log_warn("The \"indicate_workarea_overlaps\" table in %s has been deprecated and can be "
@@ -217,6 +214,22 @@ ProductionSiteDescr::ProductionSiteDescr(const std::string& init_descname,
    : ProductionSiteDescr(init_descname, MapObjectType::PRODUCTIONSITE, table, descriptions) {
 }
 
+void ProductionSiteDescr::resolve_program_calls() {
+	// Check ActCall
+	for (const auto& caller : programs_) {
+		caller.second->validate_calls(*this);
+	}
+	const Programs::const_iterator it = programs_.find(MapObjectProgram::kMainProgram);
+	main_program_ = it != programs_.end() ? it->second.get() : nullptr;
+}
+
+const ProductionProgram& ProductionSiteDescr::main_program() const {
+	if (main_program_ == nullptr) {
+		throw wexception("%s has no program '%s'", name().c_str(), MapObjectProgram::kMainProgram);
+	}
+	return *main_program_;
+}
+
 /**
  * Get the program of the given name.
  */
@@ -888,7 +901,7 @@ bool ProductionSite::has_forced_state() const {
 }
 
 void ProductionSite::find_and_start_next_program(Game& game) {
-	program_start(game, MapObjectProgram::kMainProgram);
+	program_start(game, descr().main_program());
 }
 
 /**
@@ -1101,9 +1114,16 @@ void ProductionSite::program_start(Game& game,
                                    const std::string& program_name,
                                    bool force,
                                    MapObject* extra_data) {
+	program_start(game, *descr().get_program(program_name), force, extra_data);
+}
+
+void ProductionSite::program_start(Game& game,
+                                   const ProductionProgram& program,
+                                   bool force,
+                                   MapObject* extra_data) {
 	State state;
 
-	state.program = descr().get_program(program_name);
+	state.program = &program;
 	state.ip = 0;
 	state.phase = ProgramResult::kNone;
 	state.objvar = extra_data;
@@ -1119,7 +1139,7 @@ void ProductionSite::program_start(Game& game,
 
 	program_timer_ = true;
 	Duration tdelta(10);
-	FailedSkippedPrograms::const_iterator i = failed_skipped_programs_.find(program_name);
+	FailedSkippedPrograms::const_iterator i = failed_skipped_programs_.find(program.name());
 	if (i != failed_skipped_programs_.end()) {
 		const Time& gametime = game.get_gametime();
 		const Time& earliest_allowed_start_time = i->second + Duration(10000);
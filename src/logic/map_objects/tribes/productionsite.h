@@ -189,6 +189,11 @@ public:
 	[[nodiscard]] Programs& mutable_programs() {
 		return programs_;
 	}
+	/// The program that is started whenever no other program is running. Throws if there is none.
+	[[nodiscard]] const ProductionProgram& main_program() const;
+	/// Checks the programs' calls and resolves them to the called programs. Needs to be called
+	/// again when programs were replaced via mutable_programs().
+	void resolve_program_calls();
 
 	[[nodiscard]] bool is_infinite_production_useful() const {
 		return is_infinite_production_useful_;
@@ -311,6 +316,7 @@ private:
 	std::set<std::string> collected_immovables_;
 	std::set<std::string> created_immovables_;
 	Programs programs_;
+	const ProductionProgram* main_program_{nullptr};
 	bool is_infinite_production_useful_;
 	std::string out_of_resource_title_;
 	std::string out_of_resource_heading_;
@@ -504,6 +510,10 @@ protected:
 	                   const std::string& program_name,
 	                   bool force = false,
 	                   MapObject* extra_data = nullptr);
+	void program_start(Game&,
+	                   const ProductionProgram& program,
+	                   bool force = false,
+	                   MapObject* extra_data = nullptr);
 	virtual void program_end(Game&, ProgramResult);
 	virtual void train_workers(Game&);
 	void init_yard_interfaces(EditorGameBase& egbase);
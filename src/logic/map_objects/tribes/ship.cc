@@ -365,17 +365,17 @@ void Ship::start_task_ship(Game& game) {
 
 void Ship::ship_wakeup(Game& game) {
 	if (get_state(taskShip) != nullptr) {
-		send_signal(game, "wakeup");
+		send_signal(game, BobSignal::kWakeup);
 	}
 }
 
 void Ship::ship_update(Game& game, Bob::State& state) {
 	// Handle signals
-	std::string signal = get_signal();
-	if (!signal.empty()) {
-		if (signal == "wakeup") {
+	const BobSignal signal = get_signal();
+	if (signal != BobSignal::kNone) {
+		if (signal == BobSignal::kWakeup) {
 			signal_handled();
-		} else if (signal == "cancel_expedition") {
+		} else if (signal == BobSignal::kCancelExpedition) {
 			pop_task(game);
 			PortDock* dst = fleet_->get_arbitrary_dock();
 			// TODO(sirver): What happens if there is no port anymore?
@@ -386,7 +386,7 @@ void Ship::ship_update(Game& game, Bob::State& state) {
 			signal_handled();
 			return;
 		} else {
-			send_signal(game, "fail");
+			send_signal(game, BobSignal::kFail);
 			pop_task(game);
 			return;
 		}
@@ -1075,7 +1075,7 @@ void Ship::refit(Game& game, const ShipType type) {
 	}
 
 	if (get_destination_port(game) != nullptr) {
-		send_signal(game, "wakeup");
+		send_signal(game, BobSignal::kWakeup);
 	} else if (PortDock* dest = find_nearest_port(game); dest != nullptr) {
 		set_destination(game, dest);
 	} else {
@@ -1292,7 +1292,7 @@ void Ship::start_battle(Game& game, Battle new_battle, bool immediately) {
 		battles_.emplace_front(new_battle);
 	}
 
-	send_signal(game, "wakeup");
+	send_signal(game, BobSignal::kWakeup);
 
 	if (!new_battle.is_first) {
 		return;
@@ -1910,7 +1910,7 @@ void Ship::ship_update_idle(Game& game, Bob::State& state) {
 			send_message(game, _("Port Lost!"), _("New port construction site is gone"),
 			             _("Unloading of wares failed, expedition is cancelled now."),
 			             "images/wui/ship/menu_ship_cancel_expedition.png");
-			send_signal(game, "cancel_expedition");
+			send_signal(game, BobSignal::kCancelExpedition);
 		}
 
 		set_ship_state_and_notify(ShipStates::kTransport, NoteShip::Action::kDestinationChanged);
@@ -2039,7 +2039,7 @@ void Ship::set_destination(EditorGameBase& egbase, MapObject* dest, bool is_play
 	send_message_at_destination_ = is_playercommand;
 
 	if (upcast(Game, g, &egbase)) {
-		send_signal(*g, "wakeup");
+		send_signal(*g, BobSignal::kWakeup);
 	}
 
 	if (is_playercommand) {
@@ -2064,7 +2064,7 @@ void Ship::set_destination(EditorGameBase& egbase,
 	send_message_at_destination_ = is_playercommand;
 
 	if (upcast(Game, g, &egbase)) {
-		send_signal(*g, "wakeup");
+		send_signal(*g, BobSignal::kWakeup);
 	}
 
 	if (is_playercommand) {
@@ -2352,7 +2352,7 @@ void Ship::exp_cancel(Game& game) {
 	assert(get_economy(wwWARE) && get_economy(wwWARE) != expedition_->ware_economy);
 	assert(get_economy(wwWORKER) && get_economy(wwWORKER) != expedition_->worker_economy);
 
-	send_signal(game, "cancel_expedition");
+	send_signal(game, BobSignal::kCancelExpedition);
 
 	// Delete the expedition and the economy it created.
 	expedition_.reset(nullptr);
@@ -783,7 +783,7 @@ bool Soldier::can_be_challenged() {
 void Soldier::set_battle(Game& game, Battle* const battle) {
 	if (battle_ != battle) {
 		battle_ = battle;
-		send_signal(game, "battle");
+		send_signal(game, BobSignal::kBattle);
 	}
 }
 
@@ -839,17 +839,18 @@ void Soldier::start_task_attack(Game& game, Building& building, CombatFlags flag
 }
 
 void Soldier::attack_update(Game& game, State& state) {
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 	uint32_t defenders = 0;
 
-	if (!signal.empty()) {
-		if (signal == "battle" || signal == "wakeup" || signal == "sleep") {
+	if (signal != BobSignal::kNone) {
+		if (signal == BobSignal::kBattle || signal == BobSignal::kWakeup ||
+		    signal == BobSignal::kSleep) {
 			state.ivar3 = 0;
 			signal_handled();
-		} else if (signal == "blocked") {
+		} else if (signal == BobSignal::kBlocked) {
 			state.ivar3++;
 			signal_handled();
-		} else if (signal == "fail") {
+		} else if (signal == BobSignal::kFail) {
 			state.ivar3 = 0;
 			signal_handled();
 			if (state.objvar1.get(game) != nullptr) {
@@ -859,7 +860,7 @@ void Soldier::attack_update(Game& game, State& state) {
 				molog(game.get_gametime(), "[attack] unexpected fail\n");
 				return pop_task(game);
 			}
-		} else if (signal == "location") {
+		} else if (signal == BobSignal::kLocation) {
 			molog(game.get_gametime(), "[attack] Location destroyed\n");
 			state.ivar3 = 0;
 			signal_handled();
@@ -867,8 +868,8 @@ void Soldier::attack_update(Game& game, State& state) {
 				state.ivar2 = 1;
 			}
 		} else {
-			molog(
-			   game.get_gametime(), "[attack] cancelled by unexpected signal '%s'\n", signal.c_str());
+			molog(game.get_gametime(), "[attack] cancelled by unexpected signal '%s'\n",
+			      to_string(signal));
 			return pop_task(game);
 		}
 	} else {
@@ -878,7 +879,7 @@ void Soldier::attack_update(Game& game, State& state) {
 
 	//  We are at enemy building flag, and a defender is coming, sleep until he
 	// "wake up"s me
-	if (signal == "sleep") {
+	if (signal == BobSignal::kSleep) {
 		return start_task_idle(game, descr().get_animation("idle", this), -1);
 	}
 
@@ -979,7 +980,7 @@ void Soldier::attack_update(Game& game, State& state) {
 		return start_task_battle(game);
 	}
 
-	if (signal == "blocked") {
+	if (signal == BobSignal::kBlocked) {
 		// Wait before we try again. Note that this must come *after*
 		// we check for a battle
 		// Note that we *should* be woken via send_space_signals,
@@ -1161,13 +1162,14 @@ struct SoldierDistance {
 };
 
 void Soldier::defense_update(Game& game, State& state) {
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (!signal.empty()) {
-		if (signal == "blocked" || signal == "battle" || signal == "wakeup") {
+	if (signal != BobSignal::kNone) {
+		if (signal == BobSignal::kBlocked || signal == BobSignal::kBattle ||
+		    signal == BobSignal::kWakeup) {
 			signal_handled();
 		} else {
-			molog(game.get_gametime(), "[defense] cancelled by signal '%s'\n", signal.c_str());
+			molog(game.get_gametime(), "[defense] cancelled by signal '%s'\n", to_string(signal));
 			return pop_task(game);
 		}
 	}
@@ -1189,7 +1191,7 @@ void Soldier::defense_update(Game& game, State& state) {
 		return start_task_battle(game);
 	}
 
-	if (signal == "blocked") {
+	if (signal == BobSignal::kBlocked) {
 		// Wait before we try again. Note that this must come *after*
 		// we check for a battle
 		// Note that we *should* be woken via send_space_signals,
@@ -1417,20 +1419,21 @@ void Soldier::start_task_battle(Game& game) {
 }
 
 void Soldier::battle_update(Game& game, State& /* state */) {
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 	molog(game.get_gametime(), "[battle] update for player %u's soldier: signal = \"%s\"\n",
-	      owner().player_number(), signal.c_str());
+	      owner().player_number(), to_string(signal));
 
-	if (!signal.empty()) {
-		if (signal == "blocked") {
+	if (signal != BobSignal::kNone) {
+		if (signal == BobSignal::kBlocked) {
 			signal_handled();
 			return start_task_idle(game, descr().get_animation("idle", this), 5000);
 		}
-		if (signal == "location" || signal == "battle" || signal == "wakeup") {
+		if (signal == BobSignal::kLocation || signal == BobSignal::kBattle ||
+		    signal == BobSignal::kWakeup) {
 			signal_handled();
 		} else {
 			molog(game.get_gametime(), "[battle] interrupted by unexpected signal '%s'\n",
-			      signal.c_str());
+			      to_string(signal));
 			return pop_task(game);
 		}
 	}
@@ -1477,7 +1480,7 @@ void Soldier::battle_update(Game& game, State& /* state */) {
 			return skip_act();  //  we will get a signal via set_battle()
 		}
 		if (combat_walking_ != CD_COMBAT_E) {
-			opponent.send_signal(game, "wakeup");
+			opponent.send_signal(game, BobSignal::kWakeup);
 			return start_task_move_in_battle(game, CD_WALK_E);
 		}
 	} else {
@@ -1553,13 +1556,13 @@ void Soldier::battle_update(Game& game, State& /* state */) {
 			if (battle_->first()->serial() == serial()) {
 				if (combat_walking_ != CD_COMBAT_W) {
 					molog(game.get_gametime(), "[battle]: Moving west\n");
-					opponent.send_signal(game, "wakeup");
+					opponent.send_signal(game, BobSignal::kWakeup);
 					return start_task_move_in_battle(game, CD_WALK_W);
 				}
 			} else {
 				if (combat_walking_ != CD_COMBAT_E) {
 					molog(game.get_gametime(), "[battle]: Moving east\n");
-					opponent.send_signal(game, "wakeup");
+					opponent.send_signal(game, BobSignal::kWakeup);
 					return start_task_move_in_battle(game, CD_WALK_E);
 				}
 			}
@@ -1591,11 +1594,11 @@ void Soldier::start_task_die(Game& game) {
 }
 
 void Soldier::die_update(Game& game, State& state) {
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 	molog(game.get_gametime(), "[die] update for player %u's soldier: signal = \"%s\"\n",
-	      owner().player_number(), signal.c_str());
+	      owner().player_number(), to_string(signal));
 
-	if (!signal.empty()) {
+	if (signal != BobSignal::kNone) {
 		signal_handled();
 	}
 
@@ -1631,8 +1634,8 @@ void Soldier::start_task_naval_invasion(Game& game, const Coords& coords) {
 }
 
 void Soldier::naval_invasion_update(Game& game, State& state) {
-	std::string signal = get_signal();
-	if (!signal.empty()) {
+	const BobSignal signal = get_signal();
+	if (signal != BobSignal::kNone) {
 		signal_handled();
 	}
 
@@ -1924,7 +1927,7 @@ void Soldier::send_space_signals(Game& game) {
 	for (Bob* temp_soldier : soldiers) {
 		if (upcast(Soldier, soldier, temp_soldier)) {
 			if (soldier != this) {
-				soldier->send_signal(game, "wakeup");
+				soldier->send_signal(game, BobSignal::kWakeup);
 			}
 		}
 	}
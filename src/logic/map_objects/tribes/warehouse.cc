@@ -112,7 +112,7 @@ AttackTarget::AttackResult Warehouse::AttackTarget::attack(Soldier* enemy) const
 		Soldier& defender =
 		   dynamic_cast<Soldier&>(warehouse_->launch_worker(game, soldier_index, noreq));
 		defender.start_task_defense(game, true);
-		enemy->send_signal(game, "sleep");
+		enemy->send_signal(game, BobSignal::kSleep);
 		return AttackTarget::AttackResult::DefenderLaunched;
 	}
 
@@ -108,7 +108,7 @@ bool Worker::run_mine(Game& game, State& state, const Action& action) {
 	Map* map = game.mutable_map();
 
 	// Make sure that the specified resource is available in this world
-	DescriptionIndex const res = game.descriptions().resource_index(action.sparam1);
+	DescriptionIndex const res = action.dparam1;
 	if (res == Widelands::INVALID_INDEX) {
 		throw GameDataError("should mine resource %s, which does not exist", action.sparam1.c_str());
 	}
@@ -149,7 +149,7 @@ bool Worker::run_mine(Game& game, State& state, const Action& action) {
 
 	if (totalres == 0) {
 		molog(game.get_gametime(), "  Run out of resources\n");
-		send_signal(game, "fail");  //  mine empty, abort program
+		send_signal(game, BobSignal::kFail);  //  mine empty, abort program
 		pop_task(game);
 		return true;
 	}
@@ -178,7 +178,7 @@ bool Worker::run_mine(Game& game, State& state, const Action& action) {
 
 	if (pick >= 0) {
 		molog(game.get_gametime(), "  Not successful this time\n");
-		send_signal(game, "fail");  //  not successful, abort program
+		send_signal(game, BobSignal::kFail);  //  not successful, abort program
 		pop_task(game);
 		return true;
 	}
@@ -211,7 +211,7 @@ bool Worker::run_breed(Game& game, State& state, const Action& action) {
 	Map* map = game.mutable_map();
 
 	// Make sure that the specified resource is available in this world
-	DescriptionIndex const res = game.descriptions().resource_index(action.sparam1);
+	DescriptionIndex const res = action.dparam1;
 	if (res == Widelands::INVALID_INDEX) {
 		throw GameDataError(
 		   "should breed resource type %s, which does not exist", action.sparam1.c_str());
@@ -253,7 +253,7 @@ bool Worker::run_breed(Game& game, State& state, const Action& action) {
 
 	if (totalres == 0) {
 		molog(game.get_gametime(), "  All resources full\n");
-		send_signal(game, "fail");  //  no space for more, abort program
+		send_signal(game, BobSignal::kFail);  //  no space for more, abort program
 		pop_task(game);
 		return true;
 	}
@@ -285,7 +285,7 @@ bool Worker::run_breed(Game& game, State& state, const Action& action) {
 
 	if (pick >= 0) {
 		molog(game.get_gametime(), "  Not successful this time\n");
-		send_signal(game, "fail");  //  not successful, abort program
+		send_signal(game, BobSignal::kFail);  //  not successful, abort program
 		pop_task(game);
 		return true;
 	}
@@ -316,6 +316,7 @@ bool Worker::run_breed(Game& game, State& state, const Action& action) {
  *
  * iparam1 = radius predicate
  * iparam2 = attribute predicate (if >= 0)
+ * iparam4 = whether to look for immovables
  * sparam1 = type
  */
 bool Worker::run_findobject(Game& game, State& state, const Action& action) {
@@ -324,7 +325,7 @@ bool Worker::run_findobject(Game& game, State& state, const Action& action) {
 	const Map& map = game.map();
 
 	// First try to look for immovables that were marked for removal by our player
-	if (action.sparam1 == "immovable") {
+	if (action.iparam4 != 0) {
 		std::vector<ImmovableFound> list;
 		Area<FCoords> area(map.get_fcoords(get_position()), action.iparam1);
 		if (action.iparam2 < 0) {
@@ -355,7 +356,7 @@ bool Worker::run_findobject(Game& game, State& state, const Action& action) {
 
 	for (;; ++area.radius) {
 		if (action.iparam1 < area.radius) {
-			send_signal(game, "fail");  //  no object found, cannot run program
+			send_signal(game, BobSignal::kFail);  //  no object found, cannot run program
 			pop_task(game);
 			if (upcast(ProductionSite, productionsite, get_location(game))) {
 				if (found_reserved) {
@@ -366,7 +367,7 @@ bool Worker::run_findobject(Game& game, State& state, const Action& action) {
 			}
 			return true;
 		}
-		if (action.sparam1 == "immovable") {
+		if (action.iparam4 != 0) {
 			if (upcast(ProductionSite, productionsite, get_location(game))) {
 				productionsite->unnotify_player();
 			}
@@ -587,7 +588,6 @@ private:
 bool Worker::run_findspace(Game& game, State& state, const Action& action) {
 	std::vector<Coords> list;
 	const Map& map = game.map();
-	const Descriptions& descriptions = game.descriptions();
 
 	CheckStepDefault cstep(descr().movecaps());
 
@@ -598,9 +598,9 @@ bool Worker::run_findspace(Game& game, State& state, const Action& action) {
 	functor.add(FindNodeSize(findnodesize));
 	if (!action.sparam1.empty()) {
 		if (action.iparam4 != 0) {
-			functor.add(FindNodeResourceBreedable(descriptions.resource_index(action.sparam1)));
+			functor.add(FindNodeResourceBreedable(action.dparam1));
 		} else {
-			functor.add(FindNodeResource(descriptions.resource_index(action.sparam1)));
+			functor.add(FindNodeResource(action.dparam1));
 		}
 	}
 
@@ -628,8 +628,8 @@ bool Worker::run_findspace(Game& game, State& state, const Action& action) {
 			// We need to create create another functor that will look for nodes full of fish
 			FindNodeAnd functorAnyFull;
 			functorAnyFull.add(FindNodeSize(static_cast<FindNodeSize::Size>(action.iparam2)));
-			functorAnyFull.add(FindNodeResourceBreedable(
-			   descriptions.resource_index(action.sparam1), AnimalBreedable::kAnimalFull));
+			functorAnyFull.add(
+			   FindNodeResourceBreedable(action.dparam1, AnimalBreedable::kAnimalFull));
 
 			if (action.iparam5 > -1) {
 				functorAnyFull.add(FindNodeImmovableAttribute(action.iparam5), true);
@@ -659,7 +659,7 @@ bool Worker::run_findspace(Game& game, State& state, const Action& action) {
 			}
 		}
 
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		pop_task(game);
 		return true;
 	}
@@ -758,7 +758,7 @@ bool Worker::run_walk(Game& game, State& state, const Action& action) {
 		dest = state.coords;
 	}
 	if (!dest) {
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		pop_task(game);
 		return true;
 	}
@@ -773,7 +773,7 @@ bool Worker::run_walk(Game& game, State& state, const Action& action) {
 	if (!start_task_movepath(game, dest, 10, descr().get_right_walk_anims(does_carry_ware(), this),
 	                         forceonlast, max_steps)) {
 		molog(game.get_gametime(), "  could not find path\n");
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		pop_task(game);
 		return true;
 	}
@@ -819,7 +819,7 @@ bool Worker::run_callobject(Game& game, State& state, const Action& action) {
 	MapObject* const obj = state.objvar1.get(game);
 
 	if (obj == nullptr) {
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		pop_task(game);
 		return true;
 	}
@@ -871,7 +871,7 @@ bool Worker::run_plant(Game& game, State& state, const Action& action) {
 	if (BaseImmovable const* const imm = map[pos].get_immovable()) {
 		if (imm->get_size() >= BaseImmovable::SMALL) {
 			molog(game.get_gametime(), "  field no longer free\n");
-			send_signal(game, "fail");
+			send_signal(game, BobSignal::kFail);
 			pop_task(game);
 			return true;
 		}
@@ -902,18 +902,13 @@ bool Worker::run_plant(Game& game, State& state, const Action& action) {
 		}
 	};
 
-	if (action.sparamv.empty()) {
+	if (action.iparamv.empty()) {
 		throw GameDataError("plant needs at least one attrib:<attribute>.");
 	}
 
 	// Collect all world and tribe immovable types for all the attributes along with a suitability
 	// metric
-	for (const std::string& attrib : action.sparamv) {
-		if (attrib.empty()) {
-			throw GameDataError("plant has an empty attrib:<attribute>");
-		}
-		const uint32_t attribute_id = ImmovableDescr::get_attribute_id(attrib);
-
+	for (const uint32_t attribute_id : action.iparamv) {
 		// Add immovables
 		const DescriptionMaintainer<ImmovableDescr>& immovables = game.descriptions().immovables();
 		for (uint32_t i = 0; i < immovables.size(); ++i) {
@@ -923,7 +918,7 @@ bool Worker::run_plant(Game& game, State& state, const Action& action) {
 
 	if (best_suited_immovables_index.empty()) {
 		molog(game.get_gametime(), "  WARNING: No suitable immovable found!\n");
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		pop_task(game);
 		return true;
 	}
@@ -978,7 +973,7 @@ bool Worker::run_createbob(Game& game, State& state, const Action& action) {
 		const DescriptionIndex critter = game.descriptions().critter_index(bob);
 		if (critter == INVALID_INDEX) {
 			molog(game.get_gametime(), "  WARNING: Unknown bob %s\n", bob.c_str());
-			send_signal(game, "fail");
+			send_signal(game, BobSignal::kFail);
 			pop_task(game);
 			return true;
 		}
@@ -1033,7 +1028,7 @@ bool Worker::run_terraform(Game& game, State& state, const Action& a) {
 	}
 
 	if (triangles.empty()) {
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		pop_task(game);
 		return true;
 	}
@@ -1150,7 +1145,7 @@ bool Worker::run_construct(Game& game, State& state, const Action& /* action */)
 	Immovable* imm = dynamic_cast<Immovable*>(state.objvar1.get(game));
 	if (imm == nullptr) {
 		molog(game.get_gametime(), "run_construct: no objvar1 immovable set");
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		pop_task(game);
 		return true;
 	}
@@ -1159,7 +1154,7 @@ bool Worker::run_construct(Game& game, State& state, const Action& /* action */)
 	WareInstance* ware = get_carried_ware(game);
 	if (ware == nullptr) {
 		molog(game.get_gametime(), "run_construct: no ware being carried");
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		pop_task(game);
 		return true;
 	}
@@ -1167,7 +1162,7 @@ bool Worker::run_construct(Game& game, State& state, const Action& /* action */)
 	DescriptionIndex wareindex = ware->descr_index();
 	if (!imm->construct_ware(game, wareindex)) {
 		molog(game.get_gametime(), "run_construct: construct_ware failed");
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		pop_task(game);
 		return true;
 	}
@@ -1280,7 +1275,7 @@ void Worker::set_location(PlayerImmovable* const location) {
 
 			EditorGameBase& egbase = get_owner()->egbase();
 			if (upcast(Game, game, &egbase)) {
-				send_signal(*game, "location");
+				send_signal(*game, BobSignal::kLocation);
 			}
 		}
 	}
@@ -1421,7 +1416,7 @@ void Worker::incorporate(Game& game) {
 	}
 
 	// our location has been deleted from under us
-	send_signal(game, "fail");
+	send_signal(game, BobSignal::kFail);
 }
 
 /**
@@ -1524,7 +1519,7 @@ void Worker::start_task_transfer(Game& game, Transfer* t) {
 		assert(!transfer_);
 
 		transfer_ = t;
-		send_signal(game, "transfer");
+		send_signal(game, BobSignal::kTransfer);
 	} else {  //  just start a normal transfer
 		push_task(game, taskTransfer);
 		transfer_ = t;
@@ -1545,7 +1540,7 @@ void Worker::transfer_update(Game& game, State& /* state */) {
 	// We expect to always have a location at this point,
 	// but this assumption may fail when loading a corrupted savegame.
 	if (location == nullptr) {
-		send_signal(game, "location");
+		send_signal(game, BobSignal::kLocation);
 		return pop_task(game);
 	}
 
@@ -1553,28 +1548,30 @@ void Worker::transfer_update(Game& game, State& /* state */) {
 	if (transfer_ == nullptr) {
 		molog(game.get_gametime(), "[transfer]: Fail (without transfer)\n");
 
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		return pop_task(game);
 	}
 
 	// Signal handling
-	const std::string& signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (!signal.empty()) {
+	if (signal != BobSignal::kNone) {
 		// The caller requested a route update, or the previously calculated route
 		// failed.
 		// We will recalculate the route on the next update().
-		if (signal == "road" || signal == "fail" || signal == "transfer" || signal == "wakeup") {
-			molog(game.get_gametime(), "[transfer]: Got signal '%s' -> recalculate\n", signal.c_str());
+		if (signal == BobSignal::kRoad || signal == BobSignal::kFail ||
+		    signal == BobSignal::kTransfer || signal == BobSignal::kWakeup) {
+			molog(game.get_gametime(), "[transfer]: Got signal '%s' -> recalculate\n",
+			      to_string(signal));
 
 			signal_handled();
-		} else if (signal == "blocked") {
+		} else if (signal == BobSignal::kBlocked) {
 			molog(game.get_gametime(), "[transfer]: Blocked by a battle\n");
 
 			signal_handled();
 			return start_task_idle(game, descr().get_animation("idle", this), 500);
 		} else {
-			molog(game.get_gametime(), "[transfer]: Cancel due to signal '%s'\n", signal.c_str());
+			molog(game.get_gametime(), "[transfer]: Cancel due to signal '%s'\n", to_string(signal));
 			return pop_task(game);
 		}
 	}
@@ -1614,7 +1611,7 @@ void Worker::transfer_update(Game& game, State& /* state */) {
 
 			t->has_finished();
 		} else {
-			send_signal(game, "fail");
+			send_signal(game, BobSignal::kFail);
 			pop_task(game);
 
 			t->has_failed();
@@ -1714,7 +1711,7 @@ void Worker::transfer_update(Game& game, State& /* state */) {
  */
 void Worker::cancel_task_transfer(Game& game) {
 	transfer_ = nullptr;
-	send_signal(game, "cancel");
+	send_signal(game, BobSignal::kCancel);
 }
 
 /**
@@ -1748,7 +1745,7 @@ void Worker::end_shipping(Game& game) {
 	set_ship_serial(0);
 	if (State* state = get_state(taskShipping); state != nullptr) {
 		state->ivar1 = 1;
-		send_signal(game, "endshipping");
+		send_signal(game, BobSignal::kEndShipping);
 	}
 }
 
@@ -1771,10 +1768,10 @@ void Worker::shipping_update(Game& game, State& state) {
 	PlayerImmovable* location = get_location(game);
 
 	// Signal handling
-	const std::string& signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (!signal.empty()) {
-		if (signal == "endshipping") {
+	if (signal != BobSignal::kNone) {
+		if (signal == BobSignal::kEndShipping) {
 			signal_handled();
 			if (dynamic_cast<Warehouse*>(location) == nullptr) {
 				molog(game.get_gametime(),
@@ -1783,7 +1780,7 @@ void Worker::shipping_update(Game& game, State& state) {
 				return;
 			}
 		}
-		if (signal == "transfer" || signal == "wakeup") {
+		if (signal == BobSignal::kTransfer || signal == BobSignal::kWakeup) {
 			signal_handled();
 		}
 	}
@@ -1823,13 +1820,13 @@ void Worker::start_task_buildingwork(Game& game) {
 
 void Worker::buildingwork_update(Game& game, State& state) {
 	// Reset any signals that are not related to location
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 	signal_handled();
 
 	upcast(Building, building, get_location(game));
 
 	if (state.ivar1 == 1) {
-		state.ivar1 = static_cast<int>(signal == "fail") * 2;
+		state.ivar1 = static_cast<int>(signal == BobSignal::kFail) * 2;
 	}
 
 	// Return to building, if necessary
@@ -1865,7 +1862,7 @@ void Worker::update_task_buildingwork(Game& game) {
 	// still be called, so we need to take into account that 'state' may be 'nullptr' here.
 	const State* const state = get_state();
 	if ((state != nullptr) && state->task == &taskBuildingwork) {
-		send_signal(game, "update");
+		send_signal(game, BobSignal::kUpdate);
 	}
 }
 
@@ -1888,12 +1885,12 @@ void Worker::start_task_carry_trade_item(Game& game,
 // wares, and return.
 void Worker::carry_trade_item_update(Game& game, State& state) {
 	// Reset any signals that are not related to location
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 	signal_handled();
-	if (!signal.empty()) {
+	if (signal != BobSignal::kNone) {
 		// TODO(sirver,trading): Remove once signals are correctly handled.
 		log_dbg_time(
-		   game.get_gametime(), "carry_trade_item_update: signal received: %s\n", signal.c_str());
+		   game.get_gametime(), "carry_trade_item_update: signal received: %s\n", to_string(signal));
 	}
 
 	// First of all, make sure we're outside
@@ -1947,7 +1944,7 @@ void Worker::carry_trade_item_update(Game& game, State& state) {
 
 void Worker::update_task_carry_trade_item(Game& game) {
 	if (top_state().task == &taskCarryTradeItem) {
-		send_signal(game, "update");
+		send_signal(game, BobSignal::kUpdate);
 	}
 }
 
@@ -2019,10 +2016,10 @@ void Worker::start_task_return(Game& game, bool const dropware) {
 }
 
 void Worker::return_update(Game& game, State& state) {
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (signal == "location") {
-		molog(game.get_gametime(), "[return]: Interrupted by signal '%s'\n", signal.c_str());
+	if (signal == BobSignal::kLocation) {
+		molog(game.get_gametime(), "[return]: Interrupted by signal '%s'\n", to_string(signal));
 		return pop_task(game);
 	}
 
@@ -2115,21 +2112,20 @@ void Worker::start_task_program(Game& game, const std::string& programname) {
 }
 
 void Worker::program_update(Game& game, State& state) {
-	if (!get_signal().empty()) {
-		molog(game.get_gametime(), "[program]: Interrupted by signal '%s'\n", get_signal().c_str());
+	if (get_signal() != BobSignal::kNone) {
+		molog(game.get_gametime(), "[program]: Interrupted by signal '%s'\n", to_string(get_signal()));
 		return pop_task(game);
 	}
 
 	if (state.program == nullptr) {
 		// This might happen as fallout of some save game compatibility fix
 		molog(game.get_gametime(), "[program]: No program active\n");
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		return pop_task(game);
 	}
 
+	const WorkerProgram& program = dynamic_cast<const WorkerProgram&>(*state.program);
 	for (;;) {
-		const WorkerProgram& program = dynamic_cast<const WorkerProgram&>(*state.program);
-
 		if ((state.ivar1 >= 0) && (static_cast<uint32_t>(state.ivar1) >= program.get_size())) {
 			return pop_task(game);
 		}
@@ -2180,22 +2176,22 @@ void Worker::gowarehouse_update(Game& game, State& /* state */) {
 	PlayerImmovable* const location = get_location(game);
 
 	if (location == nullptr) {
-		send_signal(game, "location");
+		send_signal(game, BobSignal::kLocation);
 		return pop_task(game);
 	}
 
 	// Signal handling
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (!signal.empty()) {
+	if (signal != BobSignal::kNone) {
 		// if routing has failed, try a different warehouse/route on next update()
-		if (signal == "fail" || signal == "cancel") {
-			molog(game.get_gametime(), "[gowarehouse]: caught '%s'\n", signal.c_str());
+		if (signal == BobSignal::kFail || signal == BobSignal::kCancel) {
+			molog(game.get_gametime(), "[gowarehouse]: caught '%s'\n", to_string(signal));
 			signal_handled();
-		} else if (signal == "transfer") {
+		} else if (signal == BobSignal::kTransfer) {
 			signal_handled();
 		} else {
-			molog(game.get_gametime(), "[gowarehouse]: cancel for signal '%s'\n", signal.c_str());
+			molog(game.get_gametime(), "[gowarehouse]: cancel for signal '%s'\n", to_string(signal));
 			return pop_task(game);
 		}
 	}
@@ -2244,8 +2240,8 @@ void Worker::gowarehouse_update(Game& game, State& /* state */) {
 
 void Worker::gowarehouse_signalimmediate(Game& /* game */,
                                          State& /* state */,
-                                         const std::string& signal) {
-	if (signal == "transfer") {
+                                         const BobSignal signal) {
+	if (signal == BobSignal::kTransfer) {
 		// We are assigned a transfer, make sure our supply disappears immediately
 		// Otherwise, we might receive two transfers in a row.
 		delete supply_;
@@ -2278,10 +2274,10 @@ void Worker::start_task_dropoff(Game& game, WareInstance& ware) {
 }
 
 void Worker::dropoff_update(Game& game, State& /* state */) {
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (!signal.empty()) {
-		molog(game.get_gametime(), "[dropoff]: Interrupted by signal '%s'\n", signal.c_str());
+	if (signal != BobSignal::kNone) {
+		molog(game.get_gametime(), "[dropoff]: Interrupted by signal '%s'\n", to_string(signal));
 		return pop_task(game);
 	}
 
@@ -2380,9 +2376,9 @@ void Worker::start_task_fetchfromflag(Game& game) {
 }
 
 void Worker::fetchfromflag_update(Game& game, State& state) {
-	std::string signal = get_signal();
-	if (!signal.empty()) {
-		if (signal == "location") {
+	const BobSignal signal = get_signal();
+	if (signal != BobSignal::kNone) {
+		if (signal == BobSignal::kLocation) {
 			molog(game.get_gametime(), "[fetchfromflag]: Building disappeared, become fugitive\n");
 			return pop_task(game);
 		}
@@ -2499,10 +2495,10 @@ bool Worker::start_task_waitforcapacity(Game& game, Flag& flag) {
 }
 
 void Worker::waitforcapacity_update(Game& game, State& /* state */) {
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (!signal.empty()) {
-		if (signal == "wakeup") {
+	if (signal != BobSignal::kNone) {
+		if (signal == BobSignal::kWakeup) {
 			signal_handled();
 		}
 		return pop_task(game);
@@ -2529,7 +2525,7 @@ bool Worker::wakeup_flag_capacity(Game& game, Flag& flag) {
 			if (state->objvar1.get(game) != &flag) {
 				throw wexception("MO(%u): wakeup_flag_capacity: Flags do not match.", serial());
 			}
-			send_signal(game, "wakeup");
+			send_signal(game, BobSignal::kWakeup);
 			return true;
 		}
 	}
@@ -2560,11 +2556,11 @@ void Worker::start_task_leavebuilding(Game& game, bool const changelocation) {
 }
 
 void Worker::leavebuilding_update(Game& game, State& state) {
-	const std::string& signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (signal == "wakeup") {
+	if (signal == BobSignal::kWakeup) {
 		signal_handled();
-	} else if (!signal.empty()) {
+	} else if (signal != BobSignal::kNone) {
 		return pop_task(game);
 	}
 
@@ -2631,7 +2627,7 @@ bool Worker::wakeup_leave_building(Game& game, Building& building) {
 			if (state->objvar1.get(game) != &building) {
 				throw wexception("MO(%u): [waitleavebuilding]: buildings do not match", serial());
 			}
-			send_signal(game, "wakeup");
+			send_signal(game, BobSignal::kWakeup);
 			return true;
 		}
 	}
@@ -2652,8 +2648,9 @@ void Worker::start_task_fugitive(Game& game) {
 }
 
 void Worker::fugitive_update(Game& game, State& state) {
-	if (!get_signal().empty()) {
-		molog(game.get_gametime(), "[fugitive]: interrupted by signal '%s'\n", get_signal().c_str());
+	if (get_signal() != BobSignal::kNone) {
+		molog(
+		   game.get_gametime(), "[fugitive]: interrupted by signal '%s'\n", to_string(get_signal()));
 		return pop_task(game);
 	}
 
@@ -2779,13 +2776,13 @@ void Worker::start_task_geologist(Game& game,
 void Worker::geologist_update(Game& game, State& state) {
 	const uint32_t resource_indicator_attribute = MapObjectDescr::get_attribute_id("resi", false);
 
-	std::string signal = get_signal();
+	const BobSignal signal = get_signal();
 
-	if (signal == "fail") {
-		molog(game.get_gametime(), "[geologist]: Caught signal '%s'\n", signal.c_str());
+	if (signal == BobSignal::kFail) {
+		molog(game.get_gametime(), "[geologist]: Caught signal '%s'\n", to_string(signal));
 		signal_handled();
-	} else if (!signal.empty()) {
-		molog(game.get_gametime(), "[geologist]: Interrupted by signal '%s'\n", signal.c_str());
+	} else if (signal != BobSignal::kNone) {
+		molog(game.get_gametime(), "[geologist]: Interrupted by signal '%s'\n", to_string(signal));
 		return pop_task(game);
 	}
 
@@ -2863,7 +2860,7 @@ void Worker::geologist_update(Game& game, State& state) {
 				       game, target, 0, descr().get_right_walk_anims(does_carry_ware(), this))) {
 
 					molog(game.get_gametime(), "[geologist]: Bug: could not find path\n");
-					send_signal(game, "fail");
+					send_signal(game, BobSignal::kFail);
 					return pop_task(game);
 				}
 				return;
@@ -2880,7 +2877,7 @@ void Worker::geologist_update(Game& game, State& state) {
 	if (!start_task_movepath(
 	       game, owner_area, 0, descr().get_right_walk_anims(does_carry_ware(), this))) {
 		molog(game.get_gametime(), "[geologist]: could not find path home\n");
-		send_signal(game, "fail");
+		send_signal(game, BobSignal::kFail);
 		return pop_task(game);
 	}
 }
@@ -3225,11 +3222,11 @@ bool Worker::scout_lurk_around(Game& game, const Map& map, struct Worker::PlaceT
 }
 
 void Worker::scout_update(Game& game, State& state) {
-	const std::string& signal = get_signal();
+	const BobSignal signal = get_signal();
 	molog(game.get_gametime(), "  Update Scout (%i time)\n", state.ivar2);
 
-	if (!signal.empty()) {
-		molog(game.get_gametime(), "[scout]: Interrupted by signal '%s'\n", signal.c_str());
+	if (signal != BobSignal::kNone) {
+		molog(game.get_gametime(), "[scout]: Interrupted by signal '%s'\n", to_string(signal));
 		return pop_task(game);
 	}
 
@@ -69,6 +69,11 @@ class Worker : public Bob {
 		std::string sparam1;
 
 		std::vector<std::string> sparamv;
+
+		// Names from sparam1 and sparamv that are resolved when the program is parsed, so that
+		// running the action does not need to look them up.
+		DescriptionIndex dparam1{INVALID_INDEX};
+		std::vector<uint32_t> iparamv;
 	};
 
 public:
@@ -234,7 +239,7 @@ private:
 	void program_update(Game&, State&);
 	void program_pop(Game&, State&);
 	void gowarehouse_update(Game&, State&);
-	void gowarehouse_signalimmediate(Game&, State&, const std::string& signal);
+	void gowarehouse_signalimmediate(Game&, State&, const BobSignal signal);
 	void gowarehouse_pop(Game& game, State& state);
 	void dropoff_update(Game&, State&);
 	void releaserecruit_update(Game&, State&);
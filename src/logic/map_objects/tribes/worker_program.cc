@@ -203,6 +203,7 @@ mine
 /**
  * iparam1 = area
  * sparam1 = resource
+ * dparam1 = resource index
  */
 void WorkerProgram::parse_mine(Worker::Action* act, const std::vector<std::string>& cmd) {
 	if (cmd.size() != 2) {
@@ -225,6 +226,7 @@ void WorkerProgram::parse_mine(Worker::Action* act, const std::vector<std::strin
 
 	Notifications::publish(
 	   NoteMapObjectDescription(act->sparam1, NoteMapObjectDescription::LoadType::kObject));
+	act->dparam1 = descriptions_.resource_index(act->sparam1);
 }
 
 /* RST
@@ -251,6 +253,7 @@ breed
 /**
  * iparam1 = area
  * sparam1 = resource
+ * dparam1 = resource index
  */
 void WorkerProgram::parse_breed(Worker::Action* act, const std::vector<std::string>& cmd) {
 	if (cmd.size() != 2) {
@@ -273,6 +276,7 @@ void WorkerProgram::parse_breed(Worker::Action* act, const std::vector<std::stri
 
 	Notifications::publish(
 	   NoteMapObjectDescription(act->sparam1, NoteMapObjectDescription::LoadType::kObject));
+	act->dparam1 = descriptions_.resource_index(act->sparam1);
 }
 
 /* RST
@@ -315,6 +319,7 @@ findobject
  * iparam1 = radius predicate
  * iparam2 = attribute predicate (if >= 0)
  * iparam3 = send message on failure (if != 0)
+ * iparam4 = whether to look for immovables (sparam1 == "immovable")
  * sparam1 = type
  */
 void WorkerProgram::parse_findobject(Worker::Action* act, const std::vector<std::string>& cmd) {
@@ -346,10 +351,11 @@ void WorkerProgram::parse_findobject(Worker::Action* act, const std::vector<std:
 		}
 	}
 
+	act->iparam4 = static_cast<int32_t>(act->sparam1 == "immovable");
+
 	if (act->iparam2 >= 0) {
-		needed_attributes_.insert(
-		   std::make_pair(act->sparam1 == "immovable" ? MapObjectType::IMMOVABLE : MapObjectType::BOB,
-		                  act->iparam2));
+		needed_attributes_.insert(std::make_pair(
+		   act->iparam4 != 0 ? MapObjectType::IMMOVABLE : MapObjectType::BOB, act->iparam2));
 	}
 
 	workarea_info_[act->iparam1].insert(" findobject");
@@ -441,6 +447,7 @@ findspace
  * iparam6 = Forester retries
  * sparam1 = Resource
  * sparamv = The terraform category (if any)
+ * dparam1 = Resource index
  */
 // TODO(Nordfriese): All boolean flags (space. breed, no_notify) should be placed in
 // just one iparam. Unfortunately there is no way to have saveloading versioning here.
@@ -510,6 +517,7 @@ void WorkerProgram::parse_findspace(Worker::Action* act, const std::vector<std::
 	if (!act->sparam1.empty()) {
 		Notifications::publish(
 		   NoteMapObjectDescription(act->sparam1, NoteMapObjectDescription::LoadType::kObject));
+		act->dparam1 = descriptions_.resource_index(act->sparam1);
 		if (act->iparam4 == 1) {
 			// breeds
 			created_resources_.insert(act->sparam1);
@@ -735,6 +743,7 @@ plant
 */
 /**
  * sparamv  list of attributes
+ * iparamv  ids of the attributes
  * iparam1  one of plantXXX
  */
 void WorkerProgram::parse_plant(Worker::Action* act, const std::vector<std::string>& cmd) {
@@ -764,8 +773,8 @@ void WorkerProgram::parse_plant(Worker::Action* act, const std::vector<std::stri
 		   NoteMapObjectDescription(attrib_name, NoteMapObjectDescription::LoadType::kAttribute));
 		act->sparamv.push_back(attrib_name);
 		// get_attribute_id will throw a GameDataError if the attribute doesn't exist.
-		created_attributes_.insert(
-		   std::make_pair(MapObjectType::IMMOVABLE, ImmovableDescr::get_attribute_id(attrib_name)));
+		act->iparamv.push_back(ImmovableDescr::get_attribute_id(attrib_name));
+		created_attributes_.insert(std::make_pair(MapObjectType::IMMOVABLE, act->iparamv.back()));
 	}
 }
 
@@ -217,8 +217,8 @@ void Critter::start_task_program(Game& game, const std::string& programname) {
 }
 
 void Critter::program_update(Game& game, State& state) {
-	if (!get_signal().empty()) {
-		molog(game.get_gametime(), "[program]: Interrupted by signal '%s'\n", get_signal().c_str());
+	if (get_signal() != BobSignal::kNone) {
+		molog(game.get_gametime(), "[program]: Interrupted by signal '%s'\n", to_string(get_signal()));
 		return pop_task(game);
 	}
 
@@ -259,7 +259,7 @@ constexpr uint32_t kMinCritterLifetime = 20 * 60 * 1000;
 constexpr uint32_t kMaxCritterLifetime = 10 * 60 * 60 * 1000;
 
 void Critter::roam_update(Game& game, State& state) {
-	if (!get_signal().empty()) {
+	if (get_signal() != BobSignal::kNone) {
 		return pop_task(game);
 	}
 
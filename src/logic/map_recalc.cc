@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "logic/map_recalc.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace Widelands {
+
+const float kFlatBrightness = calc_raw_brightness(0, 0, 0, 0, 0, 0);
+
+HeightRows::HeightRows(const Field::Height* heights,
+                       int16_t const width,
+                       int16_t const height,
+                       int16_t const y)
+   : width_(width),
+     stride_(width + 2 * kRadius),
+     odd_((y & 1) != 0),
+     data_(static_cast<size_t>(2 * kRadius + 1) * stride_) {
+	for (int dy = -kRadius; dy <= kRadius; ++dy) {
+		const Field::Height* source = heights + static_cast<size_t>((y + dy + height) % height) * width;
+		Field::Height* target = &data_[(dy + kRadius) * stride_];
+		for (int x = -kRadius; x < width + kRadius; ++x) {
+			target[x + kRadius] = source[(x + width) % width];
+		}
+	}
+}
+
+bool row_heights_within(const HeightRows& rows, int const max_diff) {
+	const Field::Height* here = rows.row(0);
+	const Field::Height* below = rows.adjacent_row(1);
+	int largest = 0;
+	for (int x = 0; x < rows.width(); ++x) {
+		const int h = here[x];
+		largest = std::max(largest, std::abs(h - here[x + 1]));
+		largest = std::max(largest, std::abs(h - below[x]));
+		largest = std::max(largest, std::abs(h - below[x + 1]));
+	}
+	return largest <= max_diff;
+}
+
+void calc_brightness_row(const HeightRows& rows, int8_t* brightness) {
+	const Field::Height* above = rows.adjacent_row(-1);
+	const Field::Height* here = rows.row(0);
+	const Field::Height* below = rows.adjacent_row(1);
+	for (int x = 0; x < rows.width(); ++x) {
+		const int32_t h = here[x];
+		brightness[x] = calc_brightness(h - here[x - 1], h - here[x + 1], h - above[x],
+		                                h - above[x + 1], h - below[x], h - below[x + 1]);
+	}
+}
+
+void calc_slopes_row(const HeightRows& rows, NodeSlopes* slopes) {
+	const Field::Height* above2 = rows.row(-2);
+	const Field::Height* above = rows.adjacent_row(-1);
+	const Field::Height* here = rows.row(0);
+	const Field::Height* below = rows.adjacent_row(1);
+	const Field::Height* below2 = rows.row(2);
+	for (int x = 0; x < rows.width(); ++x) {
+		const int h = here[x];
+
+		int first_order = std::abs(h - here[x - 1]);
+		first_order = std::max(first_order, std::abs(h - here[x + 1]));
+		first_order = std::max(first_order, std::abs(h - above[x]));
+		first_order = std::max(first_order, std::abs(h - above[x + 1]));
+		first_order = std::max(first_order, std::abs(h - below[x]));
+		first_order = std::max(first_order, std::abs(h - below[x + 1]));
+
+		// The ring of nodes two steps away: two in this row, two in each adjacent
+		// row and three in each of the rows two steps away.
+		int second_order = std::abs(h - here[x - 2]);
+		second_order = std::max(second_order, std::abs(h - here[x + 2]));
+		second_order = std::max(second_order, std::abs(h - above[x - 1]));
+		second_order = std::max(second_order, std::abs(h - above[x + 2]));
+		second_order = std::max(second_order, std::abs(h - below[x - 1]));
+		second_order = std::max(second_order, std::abs(h - below[x + 2]));
+		for (int dx = -1; dx <= 1; ++dx) {
+			second_order = std::max(second_order, std::abs(h - above2[x + dx]));
+			second_order = std::max(second_order, std::abs(h - below2[x + dx]));
+		}
+
+		slopes[x].first_order = first_order;
+		slopes[x].bottom_right = std::abs(h - below[x + 1]);
+		slopes[x].second_order = second_order;
+	}
+}
+
+}  // namespace Widelands
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WL_LOGIC_MAP_RECALC_H
+#define WL_LOGIC_MAP_RECALC_H
+
+#include <cstdint>
+#include <vector>
+
+#include "base/vector.h"
+#include "logic/field.h"
+#include "wui/mapviewpixelconstants.h"
+
+namespace Widelands {
+
+/**
+ * The brightness of a node from the slopes to its neighbours, before it is
+ * normalized and clamped. Slopes are the node's height minus the neighbour's
+ * height.
+ */
+inline float calc_raw_brightness(int32_t const left,
+                                 int32_t const right,
+                                 int32_t const topleft,
+                                 int32_t const topright,
+                                 int32_t const bottomleft,
+                                 int32_t const bottomright) {
+	constexpr float kVectorThird = 0.57735f;  // sqrt(1/3)
+	constexpr float kCos60 = 0.5f;
+	constexpr float kSin60 = 0.86603f;
+	constexpr float kLightFactor = -75.0f;
+
+	const Vector3f sun_vect(kVectorThird, -kVectorThird, -kVectorThird);  //  |sun_vect| = 1
+
+	// find normal
+	// more guessed than thought about
+	// but hey, results say I am good at guessing :)
+	// perhaps I will paint an explanation for this someday
+	// florian
+	Vector3f normal(0, 0, kTriangleWidth);
+	normal.x -= left * kHeightFactor;
+	normal.x += right * kHeightFactor;
+	normal.x -= topleft * kHeightFactorFloat * kCos60;
+	normal.y -= topleft * kHeightFactorFloat * kSin60;
+	normal.x += topright * kHeightFactorFloat * kCos60;
+	normal.y -= topright * kHeightFactorFloat * kSin60;
+	normal.x -= bottomleft * kHeightFactorFloat * kCos60;
+	normal.y += bottomleft * kHeightFactorFloat * kSin60;
+	normal.x += bottomright * kHeightFactorFloat * kCos60;
+	normal.y += bottomright * kHeightFactorFloat * kSin60;
+	normal.normalize();
+
+	return normal.dot(sun_vect) * kLightFactor;
+}
+
+/// HACK to normalize flat terrain to zero brightness
+extern const float kFlatBrightness;
+
+/// The brightness of a node from the slopes to its neighbours.
+inline int8_t calc_brightness(int32_t const left,
+                              int32_t const right,
+                              int32_t const topleft,
+                              int32_t const topright,
+                              int32_t const bottomleft,
+                              int32_t const bottomright) {
+	float b =
+	   calc_raw_brightness(left, right, topleft, topright, bottomleft, bottomright) - kFlatBrightness;
+
+	if (b > 0) {
+		b *= 1.5;
+	}
+
+	if (b < -128) {
+		b = -128;
+	} else if (b > 127) {
+		b = 127;
+	}
+	return static_cast<int8_t>(b);
+}
+
+/// The height differences around a node that limit the size of buildings on it.
+struct NodeSlopes {
+	uint8_t first_order{0U};   ///< Largest difference to a direct neighbour
+	uint8_t bottom_right{0U};  ///< Difference to the bottom right neighbour
+	uint8_t second_order{0U};  ///< Largest difference to a node two steps away
+};
+
+/**
+ * The heights of one row of the map and of the two rows above and below it,
+ * padded with the wrapped-around nodes at both ends.
+ *
+ * The row kernels below can then address all neighbours of a node with fixed
+ * offsets. Their loops have no branches for the map edges and no dependencies
+ * between iterations, so that the compiler can vectorize them.
+ */
+class HeightRows {
+public:
+	static constexpr int kRadius = 2;
+
+	/// 'heights' is the heights layer of a map with the given extent.
+	HeightRows(const Field::Height* heights, int16_t width, int16_t height, int16_t y);
+
+	/// Row y + dy, for dy in [-kRadius, kRadius]. Valid x are [-kRadius, width + kRadius).
+	[[nodiscard]] const Field::Height* row(int dy) const {
+		return &data_[(dy + kRadius) * stride_ + kRadius];
+	}
+	/// Row y + dy for odd dy, shifted so that index x is the left one of the two
+	/// nodes adjacent to node x of row y.
+	[[nodiscard]] const Field::Height* adjacent_row(int dy) const {
+		return row(dy) - (odd_ ? 0 : 1);
+	}
+
+	[[nodiscard]] int16_t width() const {
+		return width_;
+	}
+
+private:
+	const int16_t width_;
+	const int stride_;
+	const bool odd_;
+	std::vector<Field::Height> data_;
+};
+
+/// Whether every node of the row differs in height by at most 'max_diff' from its
+/// right, bottom left and bottom right neighbours. If this holds for all rows, then
+/// Map::check_neighbour_heights() will not change anything.
+[[nodiscard]] bool row_heights_within(const HeightRows& rows, int max_diff);
+
+/// Calculates the brightness of all nodes in the row, like Map::recalc_brightness().
+void calc_brightness_row(const HeightRows& rows, int8_t* brightness);
+
+/// Calculates the slopes of all nodes in the row, like Map::calc_node_slopes().
+void calc_slopes_row(const HeightRows& rows, NodeSlopes* slopes);
+
+}  // namespace Widelands
+
+#endif  // end of include guard: WL_LOGIC_MAP_RECALC_H
@@ -29,7 +29,11 @@ namespace Widelands {
 
 struct MapAStarBase {
 	explicit MapAStarBase(Map& m, WareWorker type)
-	   : map(m), pathfields(m.pathfieldmgr_->allocate()), queue(type) {
+	   : map(m), pathfields(m.pathfields_for_this_thread().allocate()), queue(pathfields->open) {
+		queue.reset(type);
+	}
+	~MapAStarBase() {
+		PathfieldManager::add_search(false, nodes_expanded);
 	}
 
 	[[nodiscard]] bool empty() const {
@@ -47,7 +51,8 @@ protected:
 
 	Map& map;
 	std::shared_ptr<Pathfields> pathfields;
-	Pathfield::Queue queue;
+	Pathfield::Queue& queue;
+	uint64_t nodes_expanded{0U};
 };
 
 struct StepEvalAStar {
@@ -155,6 +160,7 @@ template <typename StepEval> bool MapAStar<StepEval>::step(FCoords& cur, int32_t
 
 	Pathfield* curpf = queue.top();
 	queue.pop(curpf);
+	++nodes_expanded;
 
 	cur.field = &map[curpf - pathfields->fields.get()];
 	map.get_coords(*cur.field, cur);
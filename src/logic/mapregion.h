@@ -19,6 +19,9 @@
 #ifndef WL_LOGIC_MAPREGION_H
 #define WL_LOGIC_MAPREGION_H
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "logic/map.h"
 
 namespace Widelands {
@@ -78,6 +81,42 @@ private:
 	typename AreaType::RadiusType remaining_in_row_;
 	typename AreaType::RadiusType remaining_rows_;
 };
+
+/**
+ * Calls 'fn(first, count)' for every row of the area, where the nodes of the
+ * row have the consecutive map indices first, first + 1, ..., first + count - 1.
+ * A row that wraps around the map edge is split into several runs.
+ *
+ * This visits the same nodes as MapRegion, including the repetitions when the
+ * area overlaps itself, but lets the caller process a whole row in a tight loop.
+ */
+template <typename Fn> void for_each_area_run(const Map& map, const Area<FCoords>& area, Fn fn) {
+	const int32_t width = map.get_width();
+	FCoords left = area;
+	for (uint16_t r = area.radius; r > 0; --r) {
+		map.get_tln(left, &left);
+	}
+	const int32_t rows = 2 * area.radius + 1;
+	for (int32_t row = 0; row < rows; ++row) {
+		if (row > 0) {
+			if (row <= area.radius) {
+				map.get_bln(left, &left);
+			} else {
+				map.get_brn(left, &left);
+			}
+		}
+		const MapIndex row_start = left.field - &map[0] - left.x;
+		int32_t remaining = 2 * area.radius + 1 - std::abs(row - area.radius);
+		int32_t x = left.x;
+		while (remaining > 0) {
+			const int32_t count = std::min(remaining, width - x);
+			fn(row_start + x, static_cast<MapIndex>(count));
+			remaining -= count;
+			x = 0;
+		}
+	}
+}
+
 }  // namespace Widelands
 
 #endif  // end of include guard: WL_LOGIC_MAPREGION_H
@@ -24,9 +24,20 @@
 
 namespace Widelands {
 
-Pathfields::Pathfields(uint32_t const nrfields) : fields(new Pathfield[nrfields]) {
+Pathfields::Pathfields(uint32_t const n)
+   : fields(new Pathfield[n]), nrfields(n), open(wwWORKER) {
 }
 
+namespace {
+// Kept between the uses, so that the threads do not reallocate their pathfields
+thread_local PathfieldManager thread_pathfields;
+thread_local PathfieldManager* active_thread_pathfields = nullptr;
+}  // namespace
+
+std::atomic<uint64_t> PathfieldManager::searches_{0U};
+std::atomic<uint64_t> PathfieldManager::windowed_searches_{0U};
+std::atomic<uint64_t> PathfieldManager::nodes_expanded_{0U};
+
 void PathfieldManager::set_size(uint32_t const nrfields) {
 	if (nrfields_ != nrfields) {
 		list_.clear();
@@ -36,30 +47,84 @@ void PathfieldManager::set_size(uint32_t const nrfields) {
 }
 
 std::shared_ptr<Pathfields> PathfieldManager::allocate() {
-	for (std::shared_ptr<Pathfields>& pathfield : list_) {
+	std::shared_ptr<Pathfields> pf = find_unused(list_);
+	if (pf == nullptr) {
+		pf.reset(new Pathfields(nrfields_));
+		clear(*pf);
+		list_.push_back(pf);
+	}
+	return pf;
+}
+
+std::shared_ptr<Pathfields> PathfieldManager::allocate_window(uint32_t const nrfields) {
+	std::shared_ptr<Pathfields> pf = find_unused(windows_);
+	if (pf == nullptr) {
+		pf.reset(new Pathfields(nrfields));
+		clear(*pf);
+		windows_.push_back(pf);
+	} else if (pf->nrfields < nrfields) {
+		// The open list must not point into the old pathfields
+		pf->open.reset(wwWORKER);
+		pf->fields.reset(new Pathfield[nrfields]);
+		pf->nrfields = nrfields;
+		clear(*pf);
+	}
+	return pf;
+}
+
+std::shared_ptr<Pathfields> PathfieldManager::find_unused(List& list) {
+	for (std::shared_ptr<Pathfields>& pathfield : list) {
 		if (pathfield.use_count() == 1) {
 			++pathfield->cycle;
 			if (pathfield->cycle == 0u) {
-				clear(pathfield);
+				clear(*pathfield);
 			}
 			return pathfield;
 		}
 	}
 
-	if (list_.size() >= 8) {
+	if (list.size() >= 8) {
 		throw wexception("PathfieldManager::allocate: unbounded nesting?");
 	}
+	return nullptr;
+}
 
-	std::shared_ptr<Pathfields> pf(new Pathfields(nrfields_));
-	clear(pf);
-	list_.push_back(pf);
-	return pf;
+void PathfieldManager::clear(Pathfields& pf) {
+	for (uint32_t i = 0; i < pf.nrfields; ++i) {
+		pf.fields[i].cycle = 0;
+	}
+	pf.cycle = 1;
+}
+
+PathfieldManager::ScopedThreadPathfields::ScopedThreadPathfields(uint32_t const nrfields)
+   : previous_(active_thread_pathfields) {
+	thread_pathfields.set_size(nrfields);
+	active_thread_pathfields = &thread_pathfields;
+}
+
+PathfieldManager::ScopedThreadPathfields::~ScopedThreadPathfields() {
+	active_thread_pathfields = previous_;
+}
+
+PathfieldManager* PathfieldManager::for_this_thread() {
+	return active_thread_pathfields;
+}
+
+PathfieldManager::SearchStatistics PathfieldManager::search_statistics() {
+	return {searches_.load(), windowed_searches_.load(), nodes_expanded_.load()};
+}
+
+void PathfieldManager::reset_search_statistics() {
+	searches_ = 0U;
+	windowed_searches_ = 0U;
+	nodes_expanded_ = 0U;
 }
 
-void PathfieldManager::clear(const std::shared_ptr<Pathfields>& pf) const {
-	for (uint32_t i = 0; i < nrfields_; ++i) {
-		pf->fields[i].cycle = 0;
+void PathfieldManager::add_search(bool const windowed, uint64_t const nodes_expanded) {
+	searches_.fetch_add(1U, std::memory_order_relaxed);
+	if (windowed) {
+		windowed_searches_.fetch_add(1U, std::memory_order_relaxed);
 	}
-	pf->cycle = 1;
+	nodes_expanded_.fetch_add(nodes_expanded, std::memory_order_relaxed);
 }
 }  // namespace Widelands
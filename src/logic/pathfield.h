@@ -19,6 +19,7 @@
 #ifndef WL_LOGIC_PATHFIELD_H
 #define WL_LOGIC_PATHFIELD_H
 
+#include <atomic>
 #include <memory>
 
 #include "logic/cookie_priority_queue.h"
@@ -60,7 +61,11 @@ struct Pathfield {
 
 struct Pathfields {
 	std::unique_ptr<Pathfield[]> fields;
+	uint32_t nrfields;
 	uint16_t cycle{0U};
+	/// The open list of the searches that use these pathfields. It is kept
+	/// between searches, so that its storage does not have to be reallocated.
+	Pathfield::Queue open;
 
 	explicit Pathfields(uint32_t nrfields);
 };
@@ -75,15 +80,51 @@ struct PathfieldManager {
 	PathfieldManager() = default;
 
 	void set_size(uint32_t nrfields);
+	/// Pathfields for the whole map, indexed by MapIndex.
 	std::shared_ptr<Pathfields> allocate();
+	/// At least \p nrfields pathfields, for searches that stay within a part
+	/// of the map and index it themselves. These are much smaller than the
+	/// pathfields for the whole map, so a search touches less memory.
+	std::shared_ptr<Pathfields> allocate_window(uint32_t nrfields);
+
+	/// Search statistics, summed up over all maps. 'windowed' counts the
+	/// searches that used pathfields from \ref allocate_window.
+	struct SearchStatistics {
+		uint64_t searches;
+		uint64_t windowed;
+		uint64_t nodes_expanded;
+	};
+	static SearchStatistics search_statistics();
+	static void reset_search_statistics();
+	static void add_search(bool windowed, uint64_t nodes_expanded);
+
+	/// While an instance exists, searches in the thread that created it use
+	/// pathfields of that thread instead of the map's, so that several threads
+	/// can search the map at once while the game logic waits for them.
+	class ScopedThreadPathfields {
+	public:
+		explicit ScopedThreadPathfields(uint32_t nrfields);
+		~ScopedThreadPathfields();
+
+	private:
+		PathfieldManager* previous_;
+	};
+	/// The pathfields set up by ScopedThreadPathfields for this thread, or nullptr.
+	static PathfieldManager* for_this_thread();
 
 private:
-	void clear(const std::shared_ptr<Pathfields>& pf) const;
-
 	using List = std::vector<std::shared_ptr<Pathfields>>;
 
+	static void clear(Pathfields& pf);
+	static std::shared_ptr<Pathfields> find_unused(List& list);
+
 	uint32_t nrfields_{0U};
 	List list_;
+	List windows_;
+
+	static std::atomic<uint64_t> searches_;
+	static std::atomic<uint64_t> windowed_searches_;
+	static std::atomic<uint64_t> nodes_expanded_;
 };
 }  // namespace Widelands
 
@@ -18,6 +18,7 @@
 
 #include "logic/player.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cstdlib>
@@ -27,6 +28,7 @@
 #include "base/i18n.h"
 #include "base/log.h"
 #include "base/macros.h"
+#include "base/simulation_profiler.h"
 #include "base/string.h"
 #include "base/warning.h"
 #include "base/wexception.h"
@@ -121,6 +123,31 @@ void terraform_for_building(Widelands::EditorGameBase& egbase,
 		}
 	}
 }
+// Index of the lowest set bit of 'bits', which must not be 0.
+unsigned count_trailing_zeros(uint64_t bits) {
+	assert(bits != 0U);
+	unsigned result = 0;
+	for (; (bits & 1U) == 0U; bits >>= 1) {
+		++result;
+	}
+	return result;
+}
+
+// Calls 'fn(word, mask)' for each 64 bit word of a bitplane that the bits
+// first, ..., first + count - 1 fall into, with the mask of these bits in it.
+template <typename Fn>
+void for_each_bit_word(Widelands::MapIndex first, Widelands::MapIndex const count, Fn fn) {
+	const Widelands::MapIndex end = first + count;
+	while (first < end) {
+		const Widelands::MapIndex word = first / 64;
+		const unsigned offset = first % 64;
+		const unsigned bits = std::min<Widelands::MapIndex>(end - first, 64 - offset);
+		const uint64_t mask = (bits == 64 ? ~uint64_t(0) : ((uint64_t(1) << bits) - 1)) << offset;
+		fn(word, mask);
+		first += bits;
+	}
+}
+
 }  // namespace
 
 namespace Widelands {
@@ -272,6 +299,9 @@ void Player::allocate_map() {
 	assert(map.get_width());
 	assert(map.get_height());
 	fields_.reset(new Field[map.max_index()]);
+	const size_t words = (map.max_index() + 63) / 64;
+	seeing_bits_.assign(words, 0U);
+	team_seeing_bits_.assign(words, 0U);
 }
 
 bool Player::pick_custom_starting_position(const Coords& c) {
@@ -462,7 +492,7 @@ void Player::show_watch_window(Game& game, Bob& b) {
  * enabled.
  */
 void Player::play_message_sound(const Message* message) const {
-	if (g_sh->is_sound_enabled(SoundType::kMessage)) {
+	if (g_sh != nullptr && g_sh->is_sound_enabled(SoundType::kMessage)) {
 		FxId fx;
 		switch (message->type()) {
 		case Message::Type::kEconomySiteOccupied:
@@ -1492,6 +1522,7 @@ void Player::see_node(const MapIndex i) {
 	}
 	field.vision.increment_seers();
 	assert(field.vision.seers() > 0);
+	update_seeing_bit(i);
 	if (field.vision.is_hidden()) {
 		return;
 	}
@@ -1512,6 +1543,7 @@ void Player::unsee_node(MapIndex const i) {
 
 	assert(field.vision.seers() > 0);
 	field.vision.decrement_seers();
+	update_seeing_bit(i);
 	if (field.vision.is_hidden()) {
 		return;
 	}
@@ -1538,21 +1570,89 @@ void Player::unsee_node(MapIndex const i) {
 }
 
 void Player::see_area(const Area<FCoords>& area) {
+	SimulationProfiler::ScopedSample sample(SimulationProfiler::Section::kVision);
 	const Map& map = egbase().map();
-	const Widelands::Field& first_map_field = map[0];
-	MapRegion<Area<FCoords>> mr(map, area);
-	do {
-		see_node(mr.location().field - &first_map_field);
-	} while (mr.advance(map));
+	const bool has_team = !team_players_.empty();
+	vision_changed_nodes_.clear();
+	vision_team_nodes_.clear();
+
+	for_each_area_run(map, area, [this, has_team](MapIndex const first, MapIndex const count) {
+		for (MapIndex i = first; i < first + count; ++i) {
+			Vision& vision = fields_[i].vision;
+			if (!vision.is_visible() && !vision.is_hidden()) {
+				vision = VisibleState::kVisible;
+				vision_changed_nodes_.push_back(i);
+			}
+			vision.increment_seers();
+			if (has_team && !vision.is_hidden()) {
+				vision_team_nodes_.push_back(i);
+			}
+		}
+
+		// All nodes in the run are seen now
+		for_each_bit_word(first, count, [this](MapIndex const word, uint64_t const mask) {
+			const uint64_t newly_seen = mask & ~seeing_bits_[word];
+			if (newly_seen == 0U) {
+				return;
+			}
+			seeing_bits_[word] |= newly_seen;
+			for (PlayerNumber player_number : team_players_) {
+				if (Player* team_player = egbase().get_player(player_number)) {
+					team_player->team_seeing_bits_[word] |= newly_seen;
+				}
+			}
+		});
+	});
+
+	for (MapIndex i : vision_changed_nodes_) {
+		rediscover_node(map, map.get_fcoords(map[i]));
+	}
+	for (PlayerNumber player_number : team_players_) {
+		if (Player* team_player = egbase().get_player(player_number)) {
+			team_player->force_update_team_vision(vision_team_nodes_, true);
+		}
+	}
 }
 
 void Player::unsee_area(const Area<FCoords>& area) {
+	SimulationProfiler::ScopedSample sample(SimulationProfiler::Section::kVision);
 	const Map& map = egbase().map();
-	const Widelands::Field& first_map_field = map[0];
-	MapRegion<Area<FCoords>> mr(map, area);
-	do {
-		unsee_node(mr.location().field - &first_map_field);
-	} while (mr.advance(map));
+	const Time& gametime = egbase().get_gametime();
+	vision_changed_nodes_.clear();
+	vision_team_nodes_.clear();
+
+	for_each_area_run(map, area, [this, &gametime](MapIndex const first, MapIndex const count) {
+		for (MapIndex i = first; i < first + count; ++i) {
+			Field& field = fields_[i];
+			assert(field.vision.seers() > 0);
+			field.vision.decrement_seers();
+			if (field.vision.is_seen_by_us()) {
+				continue;
+			}
+			seeing_bits_[i / 64] &= ~(uint64_t(1) << (i % 64));
+			vision_team_nodes_.push_back(i);
+			if (field.vision.is_hidden()) {
+				continue;
+			}
+			assert(field.vision.is_visible());
+
+			if (!is_seen_by_team(i)) {
+				field.vision = VisibleState::kPreviouslySeen;
+				field.time_node_last_unseen = gametime;
+				vision_changed_nodes_.push_back(i);
+			}
+		}
+	});
+
+	for (MapIndex i : vision_changed_nodes_) {
+		rediscover_node(map, map.get_fcoords(map[i]));
+	}
+	for (PlayerNumber player_number : team_players_) {
+		if (Player* team_player = egbase().get_player(player_number)) {
+			team_player->recalc_team_seeing_bits(vision_team_nodes_);
+			team_player->force_update_team_vision(vision_changed_nodes_, false);
+		}
+	}
 }
 
 void Player::hide_or_reveal_field(const Coords& coords, HideOrRevealFieldMode mode) {
@@ -1574,6 +1674,7 @@ void Player::hide_or_reveal_field(const Coords& coords, HideOrRevealFieldMode mo
 		assert(field.vision.is_visible());
 		assert(!field.vision.is_revealed());
 		field.vision.set_revealed(true);
+		update_seeing_bit(i);
 		for (PlayerNumber player_number : team_players_) {
 			if (Player* team_player = egbase().get_player(player_number)) {
 				team_player->force_update_team_vision(i, true);
@@ -1588,6 +1689,7 @@ void Player::hide_or_reveal_field(const Coords& coords, HideOrRevealFieldMode mo
 			break;
 		}
 		field.vision.set_revealed(false);
+		update_seeing_bit(i);
 		assert(field.vision.is_visible());
 		assert(!field.vision.is_revealed());
 		if (!field.vision.is_seen_by_us()) {
@@ -1657,6 +1759,31 @@ void Player::force_update_team_vision(MapIndex const i, bool visible) {
 	}
 }
 
+void Player::force_update_team_vision(const std::vector<MapIndex>& nodes, bool const visible) {
+	const Map& map = egbase().map();
+	const Time& gametime = egbase().get_gametime();
+	vision_changed_nodes_.clear();
+
+	for (MapIndex i : nodes) {
+		Field& field = fields_[i];
+		if (field.vision.is_seen_by_us() || field.vision.is_hidden() ||
+		    field.vision.is_visible() == visible) {
+			continue;
+		}
+		if (visible) {
+			field.vision = VisibleState::kVisible;
+		} else {
+			field.time_node_last_unseen = gametime;
+			field.vision = VisibleState::kPreviouslySeen;
+		}
+		vision_changed_nodes_.push_back(i);
+	}
+
+	for (MapIndex i : vision_changed_nodes_) {
+		rediscover_node(map, map.get_fcoords(map[i]));
+	}
+}
+
 void Player::update_team_vision(MapIndex const i) {
 	const Map& map = egbase().map();
 	Field& field = fields_[i];
@@ -1670,13 +1797,8 @@ void Player::update_team_vision(MapIndex const i) {
 	if (field.vision.is_visible()) {
 		field.vision = VisibleState::kPreviouslySeen;
 	}
-	for (PlayerNumber player_number : team_players_) {
-		if (Player* team_player = egbase().get_player(player_number)) {
-			if (team_player->fields()[i].vision.is_seen_by_us()) {
-				field.vision = VisibleState::kVisible;
-				break;
-			}
-		}
+	if (is_seen_by_team(i)) {
+		field.vision = VisibleState::kVisible;
 	}
 
 	if (old_vision.is_visible() && !field.vision.is_visible()) {
@@ -1693,12 +1815,66 @@ void Player::update_team_vision_whole_map() {
 	if (!fields_ || egbase().objects().is_cleaning_up()) {
 		return;
 	}
-	const MapIndex max = egbase().map().max_index();
-	for (MapIndex i = 0; i < max; ++i) {
-		if (fields_[i].vision.is_seen_by_us() || fields_[i].vision.is_hidden()) {
-			continue;
+	std::vector<uint64_t> team_seeing(seeing_bits_.size(), 0U);
+	for (PlayerNumber player_number : team_players_) {
+		if (const Player* team_player = egbase().get_player(player_number)) {
+			for (size_t word = 0; word < team_seeing.size(); ++word) {
+				team_seeing[word] |= team_player->seeing_bits_[word];
+			}
 		}
-		update_team_vision(i);
+	}
+
+	// The vision of each field agrees with the old team bits, so only the
+	// fields whose bit changed need to be updated.
+	for (size_t word = 0; word < team_seeing.size(); ++word) {
+		uint64_t changed = team_seeing[word] ^ team_seeing_bits_[word];
+		team_seeing_bits_[word] = team_seeing[word];
+		for (; changed != 0U; changed &= changed - 1) {
+			update_team_vision(word * 64 + count_trailing_zeros(changed));
+		}
+	}
+}
+
+void Player::update_seeing_bit(MapIndex const i) {
+	const uint64_t mask = uint64_t(1) << (i % 64);
+	uint64_t& word = seeing_bits_[i / 64];
+	const bool seeing = fields_[i].vision.is_seen_by_us();
+	if (((word & mask) != 0U) == seeing) {
+		return;
+	}
+	word ^= mask;
+	for (PlayerNumber player_number : team_players_) {
+		if (Player* team_player = egbase().get_player(player_number)) {
+			if (seeing) {
+				team_player->team_seeing_bits_[i / 64] |= mask;
+			} else {
+				team_player->recalc_team_seeing_bit(i);
+			}
+		}
+	}
+}
+
+void Player::recalc_team_seeing_bit(MapIndex const i) {
+	const uint64_t mask = uint64_t(1) << (i % 64);
+	bool seen = false;
+	for (PlayerNumber player_number : team_players_) {
+		if (const Player* team_player = egbase().get_player(player_number)) {
+			if ((team_player->seeing_bits_[i / 64] & mask) != 0U) {
+				seen = true;
+				break;
+			}
+		}
+	}
+	if (seen) {
+		team_seeing_bits_[i / 64] |= mask;
+	} else {
+		team_seeing_bits_[i / 64] &= ~mask;
+	}
+}
+
+void Player::recalc_team_seeing_bits(const std::vector<MapIndex>& nodes) {
+	for (MapIndex i : nodes) {
+		recalc_team_seeing_bit(i);
 	}
 }
 
@@ -394,10 +394,13 @@ public:
 
 	/// Increment this player's vision for each node in the area.
 	/// Called when a building or bob starts seeing this area.
+	/// Same as calling see_node() for each node, but updates the whole area
+	/// row by row before rediscovering the nodes that became visible.
 	void see_area(const Area<FCoords>&);
 
 	/// Decrement this player's vision for each node in an area.
 	/// Called when a building or bob stops seeing this area.
+	/// Same as calling unsee_node() for each node, but batched like see_area().
 	void unsee_area(const Area<FCoords>&);
 
 	/// Explicitly hide or reveal the given field. The modes are as follows:
@@ -418,7 +421,8 @@ public:
 	void update_team_vision(MapIndex);
 
 	/// Update the team vision state of all fields on the map.
-	/// This is slow, so use sparingly.
+	/// Only the fields where the combined vision of the team players changed
+	/// since the last update are visited.
 	void update_team_vision_whole_map();
 
 	MilitaryInfluence military_influence(MapIndex const i) const {
@@ -651,6 +655,22 @@ private:
 	/// those of the 6 surrounding edges/triangles that are not seen from another node.
 	void rediscover_node(const Map&, const FCoords&);
 
+	/// Calls force_update_team_vision() for each of the nodes, but rediscovers
+	/// the nodes only after all of them have been updated.
+	void force_update_team_vision(const std::vector<MapIndex>& nodes, bool visible);
+
+	/// Whether any team player is seeing the node right now.
+	[[nodiscard]] bool is_seen_by_team(MapIndex const i) const {
+		return (team_seeing_bits_[i / 64] & (uint64_t(1) << (i % 64))) != 0;
+	}
+	/// Updates the bit in seeing_bits_ after the seers or the revealed state of
+	/// the node changed, and passes the change on to the team players.
+	void update_seeing_bit(MapIndex);
+	/// Recalculates the bits in team_seeing_bits_ for the nodes after a team
+	/// player stopped seeing them.
+	void recalc_team_seeing_bit(MapIndex);
+	void recalc_team_seeing_bits(const std::vector<MapIndex>& nodes);
+
 	using StatisticsMap = std::map<DescriptionIndex, std::vector<Quantity>>;
 
 	struct SoldierStatistics {
@@ -674,6 +694,17 @@ private:
 
 	std::unique_ptr<Field[]> fields_;
 
+	// Reused by see_area() and unsee_area(): the nodes whose vision changed, and
+	// the nodes whose vision needs to be passed on to the team players.
+	std::vector<MapIndex> vision_changed_nodes_;
+	std::vector<MapIndex> vision_team_nodes_;
+
+	// Bit i of these bitplanes is set if this player, respectively any of the
+	// team players, is seeing node i (Vision::is_seen_by_us()). Combining the
+	// vision of the team is then a bitwise OR of 64 nodes at a time.
+	std::vector<uint64_t> seeing_bits_;
+	std::vector<uint64_t> team_seeing_bits_;
+
 	std::vector<uint8_t> further_initializations_;   // used in shared kingdom mode
 	std::vector<uint8_t> further_shared_in_player_;  //  ''  ''   ''     ''     ''
 
@@ -18,9 +18,14 @@
 
 #include "logic/save_handler.h"
 
+#include <cassert>
+#include <chrono>
+
 #include <SDL_timer.h>
 
 #include "base/log.h"
+#include "base/macros.h"
+#include "base/mutex.h"
 #include "base/scoped_timer.h"
 #include "base/string.h"
 #include "base/time_string.h"
@@ -28,12 +33,17 @@
 #include "game_io/game_saver.h"
 #include "io/filesystem/filesystem.h"
 #include "io/filesystem/filesystem_exceptions.h"
+#include "io/filesystem/memory_filesystem.h"
 #include "logic/game.h"
 #include "logic/game_controller.h"
 #include "logic/generic_save_handler.h"
 #include "wlapplication_options.h"
 #include "wui/interactive_base.h"
 
+SaveHandler::~SaveHandler() {
+	finish_background_save(nullptr, true);
+}
+
 bool SaveHandler::roll_save_files(const std::string& filename, std::string* const error) const {
 	int32_t rolls = 0;
 	std::string filename_previous;
@@ -128,12 +138,18 @@ void SaveHandler::think(Widelands::Game& game) {
 	initialize(game, realtime);
 	bool force_skip = false;
 
+	// Wait until the last autosave has been written before starting a new one.
+	if (!finish_background_save(&game, false)) {
+		return;
+	}
+
 	// Are we saving now?
 	if (saving_next_tick_ || save_requested_) {
 		saving_next_tick_ = false;
 		bool save_success = true;
 		std::string error;
 		std::string filename = autosave_filename_;
+		const bool autosave = !save_requested_;
 		if (save_requested_) {
 			// Requested by user
 			if (!save_filename_.empty()) {
@@ -163,7 +179,16 @@ void SaveHandler::think(Widelands::Game& game) {
 		if (save_success && !force_skip) {
 			// Saving now (always overwrite file)
 			std::string complete_filename = create_file_name(kSaveDir, filename);
-			save_success = save_game(game, complete_filename, std::nullopt, &error);
+			if (autosave) {
+				save_success = start_background_save(game, complete_filename, realtime, &error);
+				if (save_success) {
+					// The rest is done by finish_background_save().
+					next_save_min_gametime_ = game.get_gametime() + autosave_gametime_interval_;
+					return;
+				}
+			} else {
+				save_success = save_game(game, complete_filename, std::nullopt, &error);
+			}
 		}
 		if (!save_success) {
 			log_err_time(game.get_gametime(), "Autosave: ERROR! - %s\n", error.c_str());
@@ -190,6 +215,97 @@ void SaveHandler::think(Widelands::Game& game) {
 	}
 }
 
+/**
+ * Write a snapshot of the game to memory, then save it to disk on another thread.
+ *
+ * Only the snapshot stops the game. The thread does not access any game data,
+ * but it does use the global filesystem.
+ *
+ * @return false if the snapshot could not be taken.
+ */
+bool SaveHandler::start_background_save(Widelands::Game& game,
+                                        const std::string& complete_filename,
+                                        uint32_t const realtime,
+                                        std::string* const error_str) {
+	assert(background_save_ == nullptr);
+	auto snapshot = std::make_shared<MemoryFileSystem>();
+	try {
+		ScopedTimer snapshot_timer("SaveHandler: autosave snapshot took %ums", true);
+		// TODO(tothxa): kObjects before kLua is needed because of Panel::do_run() and plugin actions
+		MutexLock o(MutexLock::ID::kObjects);
+		MutexLock m(MutexLock::ID::kLua);
+		Widelands::GameSaver gs(*snapshot, game);
+		gs.save();
+	} catch (const std::exception& e) {
+		if (error_str != nullptr) {
+			*error_str = format("Autosave: snapshot could not be taken: %s", e.what());
+		}
+		return false;
+	}
+	verb_log_info_time(game.get_gametime(), "Autosave: writing %" PRIuS " bytes in the background\n",
+	                   snapshot->total_size());
+
+	const FileSystem::Type fs_type = fs_type_;
+	background_save_.reset(new BackgroundSave{
+	   realtime, std::async(std::launch::async, [snapshot, complete_filename, fs_type]() {
+		   GenericSaveHandler gsh([snapshot](FileSystem& fs) { snapshot->copy_to(fs); },
+		                          complete_filename, fs_type, false);
+		   gsh.save();
+		   // Ignore it if only the temporary backup wasn't deleted
+		   // but save was successfull otherwise
+		   if (gsh.error() == GenericSaveHandler::Error::kSuccess ||
+		       gsh.error() == GenericSaveHandler::Error::kDeletingBackupFailed) {
+			   return std::string();
+		   }
+		   return gsh.error_message();
+	   })});
+	return true;
+}
+
+/**
+ * Report the result of the autosave that is being written in the background.
+ *
+ * @param game The game to report to, or nullptr to only log the result.
+ * @param wait Whether to wait for the save to finish.
+ * @return false if the save is still running.
+ */
+bool SaveHandler::finish_background_save(Widelands::Game* game, bool wait) {
+	if (background_save_ == nullptr) {
+		return true;
+	}
+	if (!wait &&
+	    background_save_->error.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+		return false;
+	}
+
+	const std::string error = background_save_->error.get();
+	const uint32_t start_realtime = background_save_->start_realtime;
+	background_save_.reset();
+
+	if (!error.empty()) {
+		log_err("Autosave: ERROR! - %s\n", error.c_str());
+		if (game != nullptr && game->get_ibase() != nullptr) {
+			game->get_ibase()->log_message(_("Saving failed!"));
+		}
+
+		// Wait 30 seconds until next save try
+		next_save_realtime_ = SDL_GetTicks() + 30000;
+		return true;
+	}
+
+	// Count save interval from end of save.
+	// This prevents us from going into endless autosave cycles if the save
+	// should take longer than the autosave interval.
+	last_save_realtime_ = SDL_GetTicks();
+	next_save_realtime_ = last_save_realtime_ + autosave_interval_in_ms_;
+
+	verb_log_info("Autosave: save took %d ms\n", last_save_realtime_ - start_realtime);
+	if (game != nullptr && game->get_ibase() != nullptr) {
+		game->get_ibase()->log_message(_("Game saved"));
+	}
+	return true;
+}
+
 /**
  * Lazy intialisation on first call.
  */
@@ -244,6 +360,8 @@ bool SaveHandler::save_game(Widelands::Game& game,
                             const std::string& complete_filename,
                             std::optional<FileSystem::Type> fstype,
                             std::string* const error_str) {
+	finish_background_save(&game, true);
+
 	ScopedTimer save_timer("SaveHandler::save_game() took %ums", true);
 
 	// save game via the GenericSaveHandler
@@ -20,6 +20,8 @@
 #define WL_LOGIC_SAVE_HANDLER_H
 
 #include <cstdint>
+#include <future>
+#include <memory>
 #include <optional>
 
 #include "base/times.h"
@@ -33,17 +35,23 @@ class Game;
 /**
  * Takes care of manual or autosave via think().
  *
+ * Autosaves only stop the game while a snapshot of it is written to memory.
+ * Compressing the snapshot and writing it to disk happens on a background
+ * thread, and think() reports the result once that is done.
+ *
  * Note that this handler is used for replays via the ReplayWriter, too.
  */
 class SaveHandler {
 public:
 	SaveHandler() = default;
+	~SaveHandler();
 
 	void think(Widelands::Game&);
 	[[nodiscard]] std::string create_file_name(const std::string& dir,
 	                                           const std::string& filename) const;
 
-	// Saves the game, overwrites file, handles errors
+	// Saves the game, overwrites file, handles errors.
+	// Waits for an autosave that is still being written first.
 	bool save_game(Widelands::Game&,
 	               const std::string& filename,
 	               std::optional<FileSystem::Type> fstype,
@@ -76,7 +84,20 @@ public:
 		return last_save_realtime_;
 	}
 
+	// Whether an autosave is still being written to disk
+	[[nodiscard]] bool is_saving_in_background() const {
+		return background_save_ != nullptr;
+	}
+
 private:
+	// An autosave whose snapshot is being written to disk
+	struct BackgroundSave {
+		uint32_t start_realtime;
+		// The error message, or an empty string if saving succeeded
+		std::future<std::string> error;
+	};
+	std::unique_ptr<BackgroundSave> background_save_;
+
 	uint32_t next_save_realtime_{0U};
 	uint32_t last_save_realtime_{0U};
 	Time next_save_min_gametime_;
@@ -97,6 +118,11 @@ private:
 	void initialize(Widelands::Game& game, uint32_t realtime);
 	bool roll_save_files(const std::string& filename, std::string* error) const;
 	bool check_next_tick(Widelands::Game& game, uint32_t realtime) const;
+	bool start_background_save(Widelands::Game& game,
+	                           const std::string& complete_filename,
+	                           uint32_t realtime,
+	                           std::string* error_str);
+	bool finish_background_save(Widelands::Game* game, bool wait);
 };
 
 #endif  // end of include guard: WL_LOGIC_SAVE_HANDLER_H
@@ -36,7 +36,8 @@ SinglePlayerGameController::SinglePlayerGameController(Widelands::Game& game,
      time_(game_.get_gametime()),
      speed_(get_config_natural("speed_of_new_game", 1000)),
 
-     local_(local) {
+     local_(local),
+     concurrent_ai_(get_config_bool("concurrent_ai", false)) {
 }
 
 SinglePlayerGameController::~SinglePlayerGameController() {
@@ -64,6 +65,7 @@ void SinglePlayerGameController::think() {
 
 	if (use_ai_ && game_.is_loaded()) {
 		const Widelands::PlayerNumber nr_players = game_.map().get_nrplayers();
+		std::vector<AI::ComputerPlayer*> thinking;
 		iterate_players_existing(p, nr_players, game_, plr) if (p != local_) {
 
 			if (p > computerplayers_.size()) {
@@ -73,8 +75,9 @@ void SinglePlayerGameController::think() {
 				computerplayers_[p - 1] =
 				   AI::ComputerPlayer::get_implementation(plr->get_ai())->instantiate(game_, p);
 			}
-			computerplayers_[p - 1]->think();
+			thinking.push_back(computerplayers_[p - 1]);
 		}
+		AI::ComputerPlayer::think_all(thinking, concurrent_ai_);
 	}
 }
 
@@ -51,6 +51,7 @@ private:
 	bool paused_{false};
 	uint32_t player_cmdserial_{0U};
 	Widelands::PlayerNumber local_;
+	const bool concurrent_ai_;  ///< whether the AIs think on several threads
 	std::vector<AI::ComputerPlayer*> computerplayers_;
 };
 
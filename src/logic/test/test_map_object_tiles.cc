@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/test.h"
+#include "io/filesystem/layered_filesystem.h"
+#include "logic/editor_game_base.h"
+#include "logic/map.h"
+#include "logic/map_objects/checkstep.h"
+#include "logic/map_objects/findimmovable.h"
+#include "logic/map_objects/immovable.h"
+
+namespace {
+
+struct TestImmovableDescr : public Widelands::MapObjectDescr {
+	TestImmovableDescr(const std::string& name, const std::string& attribute)
+	   : Widelands::MapObjectDescr(Widelands::MapObjectType::MAPOBJECT, name, name) {
+		add_attributes({attribute});
+	}
+};
+
+struct TestImmovable : public Widelands::BaseImmovable {
+	explicit TestImmovable(const TestImmovableDescr& descr) : Widelands::BaseImmovable(descr) {
+	}
+
+	int32_t get_size() const override {
+		return NONE;
+	}
+	bool get_passable() const override {
+		return true;
+	}
+	PositionList get_positions(const Widelands::EditorGameBase& /* egbase */) const override {
+		return PositionList(1, position_);
+	}
+	void draw(const Time& /* gametime */,
+	          InfoToDraw /* info_to_draw */,
+	          const Vector2f& /* point_on_dst */,
+	          const Widelands::Coords& /* coords */,
+	          float /* scale */,
+	          RenderTarget* /* dst */) override {
+	}
+
+	void place(Widelands::EditorGameBase& egbase, const Widelands::Coords& c) {
+		position_ = c;
+		set_position(egbase, c);
+	}
+	void take(Widelands::EditorGameBase& egbase) {
+		unset_position(egbase, position_);
+	}
+
+private:
+	Widelands::Coords position_;
+};
+
+// Odd map sizes, so that the last tiles of each row and column are only partly on the map
+constexpr int16_t kWidth = 37;
+constexpr int16_t kHeight = 23;
+
+struct WlTestFixture {
+	WlTestFixture() {
+		g_fs = new LayeredFileSystem();
+	}
+	~WlTestFixture() {
+		delete g_fs;
+		g_fs = nullptr;
+	}
+};
+
+struct ObjectTilesFixture : public WlTestFixture {
+	ObjectTilesFixture()
+	   : egbase(nullptr), tree_descr("test_tree", "test_tree"), rock_descr("test_rock", "test_rock") {
+		egbase.mutable_map()->set_size(kWidth, kHeight);
+	}
+
+	DISALLOW_COPY_AND_ASSIGN(ObjectTilesFixture);
+
+	[[nodiscard]] const Widelands::Map& map() const {
+		return egbase.map();
+	}
+	[[nodiscard]] const Widelands::MapObjectTiles& tiles() const {
+		return egbase.map().object_tiles();
+	}
+	[[nodiscard]] uint32_t immovables_at(int16_t x, int16_t y) const {
+		return tiles().immovables[tiles().tile(Widelands::Coords(x, y))];
+	}
+	[[nodiscard]] uint64_t attributes_at(int16_t x, int16_t y) const {
+		return tiles().immovable_attributes[tiles().tile(Widelands::Coords(x, y))];
+	}
+	[[nodiscard]] uint32_t attribute(const TestImmovableDescr& descr) const {
+		return descr.attributes().front();
+	}
+	[[nodiscard]] Widelands::Area<Widelands::FCoords> area(int16_t x,
+	                                                       int16_t y,
+	                                                       uint16_t radius) const {
+		return Widelands::Area<Widelands::FCoords>(map().get_fcoords(Widelands::Coords(x, y)),
+		                                           radius);
+	}
+
+	Widelands::EditorGameBase egbase;
+	TestImmovableDescr tree_descr;
+	TestImmovableDescr rock_descr;
+};
+
+}  // namespace
+
+TESTSUITE_START(map_object_tiles)
+
+TESTCASE(bobs_counted_across_tile_borders) {
+	ObjectTilesFixture f;
+	Widelands::Map& map = *f.egbase.mutable_map();
+	const Widelands::MapObjectTiles& tiles = f.tiles();
+	const Widelands::Coords left(7, 8);
+	const Widelands::Coords right(8, 8);
+	check_equal(tiles.tile(left) != tiles.tile(right), true);
+
+	// A bob walking from one tile onto the next
+	map.add_bob_to_tile(left);
+	check_equal(tiles.bobs[tiles.tile(left)], 1U);
+	map.remove_bob_from_tile(left);
+	map.add_bob_to_tile(right);
+	check_equal(tiles.bobs[tiles.tile(left)], 0U);
+	check_equal(tiles.bobs[tiles.tile(right)], 1U);
+	map.remove_bob_from_tile(right);
+	check_equal(tiles.bobs[tiles.tile(right)], 0U);
+}
+
+TESTCASE(immovables_counted_across_tile_borders) {
+	ObjectTilesFixture f;
+	TestImmovable a(f.tree_descr);
+	TestImmovable b(f.tree_descr);
+
+	a.place(f.egbase, Widelands::Coords(7, 3));
+	b.place(f.egbase, Widelands::Coords(8, 3));
+	check_equal(f.immovables_at(7, 3), 1U);
+	check_equal(f.immovables_at(8, 3), 1U);
+
+	// Move 'a' into the tile of 'b'
+	a.take(f.egbase);
+	a.place(f.egbase, Widelands::Coords(9, 4));
+	check_equal(f.immovables_at(7, 3), 0U);
+	check_equal(f.attributes_at(7, 3), 0U);
+	check_equal(f.immovables_at(8, 3), 2U);
+
+	// The last, partial tile of a row
+	b.take(f.egbase);
+	b.place(f.egbase, Widelands::Coords(kWidth - 1, kHeight - 1));
+	check_equal(f.immovables_at(8, 3), 1U);
+	check_equal(f.immovables_at(kWidth - 1, kHeight - 1), 1U);
+
+	a.take(f.egbase);
+	b.take(f.egbase);
+	check_equal(f.immovables_at(8, 3), 0U);
+	check_equal(f.immovables_at(kWidth - 1, kHeight - 1), 0U);
+	check_equal(f.attributes_at(kWidth - 1, kHeight - 1), 0U);
+}
+
+TESTCASE(attributes_recomputed_on_removal) {
+	ObjectTilesFixture f;
+	const uint64_t tree_bit = Widelands::MapObjectTiles::attribute_bit(f.attribute(f.tree_descr));
+	const uint64_t rock_bit = Widelands::MapObjectTiles::attribute_bit(f.attribute(f.rock_descr));
+	check_equal(tree_bit != rock_bit, true);
+
+	TestImmovable tree(f.tree_descr);
+	TestImmovable rock(f.rock_descr);
+	tree.place(f.egbase, Widelands::Coords(1, 1));
+	rock.place(f.egbase, Widelands::Coords(6, 6));
+	check_equal(f.attributes_at(1, 1), tree_bit | rock_bit);
+
+	// The rock is still on the tile, so only the tree's attribute goes away
+	tree.take(f.egbase);
+	check_equal(f.immovables_at(1, 1), 1U);
+	check_equal(f.attributes_at(1, 1), rock_bit);
+
+	std::vector<Widelands::ImmovableFound> found;
+	check_equal(f.map().find_immovables(f.egbase, f.area(3, 3, 4), &found,
+	                                    Widelands::FindImmovableAttribute(f.attribute(f.tree_descr))),
+	            0U);
+	check_equal(f.map().find_immovables(f.egbase, f.area(3, 3, 4), &found,
+	                                    Widelands::FindImmovableAttribute(f.attribute(f.rock_descr))),
+	            1U);
+	check_equal(found.front().object, static_cast<Widelands::BaseImmovable*>(&rock));
+
+	rock.take(f.egbase);
+}
+
+TESTCASE(searches_wrap_around) {
+	ObjectTilesFixture f;
+	TestImmovable tree(f.tree_descr);
+	const Widelands::Coords corner(kWidth - 1, kHeight - 1);
+	tree.place(f.egbase, corner);
+
+	// The area around the origin reaches the opposite corner of the map
+	std::vector<Widelands::ImmovableFound> found;
+	check_equal(f.map().find_immovables(f.egbase, f.area(0, 0, 2), &found), 1U);
+	check_equal(found.front().coords == corner, true);
+
+	// The flood fill may visit a node more than once
+	found.clear();
+	check_equal(f.map().find_reachable_immovables(f.egbase, f.area(0, 0, 2), &found,
+	                                              Widelands::CheckStepAlwaysTrue()) > 0U,
+	            true);
+	for (const Widelands::ImmovableFound& imf : found) {
+		check_equal(imf.coords == corner, true);
+	}
+
+	// Areas that do not reach the corner find nothing
+	check_equal(f.map().find_immovables(f.egbase, f.area(kWidth / 2, kHeight / 2, 2), nullptr), 0U);
+	check_equal(f.map().find_reachable_immovables(f.egbase, f.area(kWidth / 2, kHeight / 2, 2),
+	                                              nullptr, Widelands::CheckStepAlwaysTrue()),
+	            0U);
+
+	tree.take(f.egbase);
+}
+
+TESTSUITE_END()
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "base/test.h"
+#include "logic/map.h"
+#include "logic/map_recalc.h"
+
+namespace {
+
+// A map with pseudo-random heights. 'max_diff' limits the height difference
+// between neighbouring nodes in each row.
+void fill_heights(Widelands::Map& map, int16_t const width, int16_t const height, int max_diff) {
+	map.set_size(width, height);
+	std::srand(4711);
+	for (int16_t y = 0; y < height; ++y) {
+		int h = 20;
+		for (int16_t x = 0; x < width; ++x) {
+			h += std::rand() % (2 * max_diff + 1) - max_diff;
+			h = std::max(0, std::min<int>(MAX_FIELD_HEIGHT, h));
+			Widelands::Field& f = map[Widelands::Coords(x, y)];
+			map.set_field_height(f, h);
+		}
+	}
+}
+
+}  // namespace
+
+// Odd map sizes make sure that rows of both parities wrap around correctly.
+constexpr int16_t kWidth = 37;
+constexpr int16_t kHeight = 23;
+
+TESTSUITE_START(map_recalc)
+
+TESTCASE(brightness_row_matches_scalar) {
+	Widelands::Map map;
+	fill_heights(map, kWidth, kHeight, 5);
+	map.recalc_whole_map_brightness();
+
+	std::vector<int8_t> brightness(kWidth);
+	for (int16_t y = 0; y < kHeight; ++y) {
+		Widelands::calc_brightness_row(
+		   Widelands::HeightRows(map.layers().heights.data(), kWidth, kHeight, y), brightness.data());
+		for (int16_t x = 0; x < kWidth; ++x) {
+			check_equal(static_cast<int>(brightness[x]),
+			            static_cast<int>(map[Widelands::Coords(x, y)].get_brightness()));
+		}
+	}
+}
+
+TESTCASE(slopes_row_matches_scalar) {
+	Widelands::Map map;
+	fill_heights(map, kWidth, kHeight, 5);
+
+	std::vector<Widelands::NodeSlopes> slopes(kWidth);
+	for (int16_t y = 0; y < kHeight; ++y) {
+		Widelands::calc_slopes_row(
+		   Widelands::HeightRows(map.layers().heights.data(), kWidth, kHeight, y), slopes.data());
+		for (int16_t x = 0; x < kWidth; ++x) {
+			const Widelands::NodeSlopes expected =
+			   map.calc_node_slopes(map.get_fcoords(Widelands::Coords(x, y)));
+			check_equal(static_cast<int>(slopes[x].first_order),
+			            static_cast<int>(expected.first_order));
+			check_equal(static_cast<int>(slopes[x].bottom_right),
+			            static_cast<int>(expected.bottom_right));
+			check_equal(static_cast<int>(slopes[x].second_order),
+			            static_cast<int>(expected.second_order));
+		}
+	}
+}
+
+TESTCASE(heights_within_matches_scalar) {
+	for (int max_diff : {1, 3, 6}) {
+		Widelands::Map map;
+		fill_heights(map, kWidth, kHeight, max_diff);
+
+		for (int16_t y = 0; y < kHeight; ++y) {
+			bool expected = true;
+			for (int16_t x = 0; x < kWidth; ++x) {
+				const Widelands::FCoords f = map.get_fcoords(Widelands::Coords(x, y));
+				for (const Widelands::FCoords& n : {map.r_n(f), map.bl_n(f), map.br_n(f)}) {
+					if (std::abs(f.field->get_height() - n.field->get_height()) > 3) {
+						expected = false;
+					}
+				}
+			}
+			check_equal(Widelands::row_heights_within(
+			               Widelands::HeightRows(map.layers().heights.data(), kWidth, kHeight, y), 3),
+			            expected);
+		}
+	}
+}
+
+TESTSUITE_END()
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <map>
+
+#include "base/test.h"
+#include "logic/map.h"
+#include "logic/mapregion.h"
+
+TESTSUITE_START(mapregion)
+
+// Rows of odd maps wrap with both parities, and large radii make the area
+// overlap itself.
+TESTCASE(area_runs_match_map_region) {
+	for (const auto& size : {std::make_pair(16, 16), std::make_pair(37, 23), std::make_pair(7, 3)}) {
+		Widelands::Map map;
+		map.set_size(size.first, size.second);
+		for (uint16_t radius : {0, 1, 2, 5, 9}) {
+			for (int16_t y = 0; y < size.second; ++y) {
+				for (int16_t x = 0; x < size.first; ++x) {
+					const Widelands::Area<Widelands::FCoords> area(
+					   map.get_fcoords(Widelands::Coords(x, y)), radius);
+
+					std::map<Widelands::MapIndex, int> expected;
+					Widelands::MapRegion<Widelands::Area<Widelands::FCoords>> mr(map, area);
+					do {
+						++expected[mr.location().field - &map[0]];
+					} while (mr.advance(map));
+
+					std::map<Widelands::MapIndex, int> visited;
+					Widelands::for_each_area_run(
+					   map, area,
+					   [&map, &visited](Widelands::MapIndex const first, Widelands::MapIndex const count) {
+						   // A run never crosses a row boundary
+						   check_equal(first / map.get_width(), (first + count - 1) / map.get_width());
+						   for (Widelands::MapIndex i = first; i < first + count; ++i) {
+							   ++visited[i];
+						   }
+					   });
+					check_equal(visited == expected, true);
+				}
+			}
+		}
+	}
+}
+
+TESTSUITE_END()
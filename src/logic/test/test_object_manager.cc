@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include "base/test.h"
+#include "logic/map_objects/map_object.h"
+
+namespace {
+
+const Widelands::MapObjectDescr
+   test_descr(Widelands::MapObjectType::MAPOBJECT, "test_object", "Test Object");
+
+struct TestObject : public Widelands::MapObject {
+	TestObject() : Widelands::MapObject(&test_descr) {
+	}
+};
+
+}  // namespace
+
+TESTSUITE_START(object_manager)
+
+TESTCASE(lookup_and_remove) {
+	Widelands::ObjectManager objects;
+	TestObject a;
+	TestObject b;
+	objects.insert(&a);
+	objects.insert(&b);
+
+	check_equal(objects.size(), 2U);
+	check_equal(a.serial() != 0U, true);
+	check_equal(a.serial() != b.serial(), true);
+	check_equal(objects.get_object(a.serial()), static_cast<Widelands::MapObject*>(&a));
+	check_equal(objects.get_object(b.serial()), static_cast<Widelands::MapObject*>(&b));
+	check_equal(objects.get_object(0), static_cast<Widelands::MapObject*>(nullptr));
+
+	objects.remove(a);
+	check_equal(objects.size(), 1U);
+	check_equal(objects.get_object(a.serial()), static_cast<Widelands::MapObject*>(nullptr));
+	objects.remove(b);
+}
+
+TESTCASE(removed_serials_not_reused) {
+	Widelands::ObjectManager objects;
+	TestObject a;
+	TestObject b;
+	objects.insert(&a);
+	const Widelands::Serial old_serial = a.serial();
+	objects.remove(a);
+
+	// The old serial of 'a' must not resolve to 'b'.
+	objects.insert(&b);
+	check_equal(b.serial() > old_serial, true);
+	check_equal(objects.get_object(old_serial), static_cast<Widelands::MapObject*>(nullptr));
+	check_equal(objects.get_object(b.serial()), static_cast<Widelands::MapObject*>(&b));
+	objects.remove(b);
+}
+
+TESTCASE(lookup_across_freed_pages) {
+	Widelands::ObjectManager objects;
+	std::vector<std::unique_ptr<TestObject>> created;
+	for (int i = 0; i < 5000; ++i) {
+		created.push_back(std::make_unique<TestObject>());
+		objects.insert(created.back().get());
+	}
+	// Empty all but the last few pages, and keep one object in the middle
+	for (int i = 0; i < 4000; ++i) {
+		if (i != 2500) {
+			objects.remove(*created[i]);
+		}
+	}
+	check_equal(objects.size(), 1001U);
+	for (int i = 0; i < 5000; ++i) {
+		const bool alive = i >= 4000 || i == 2500;
+		check_equal(objects.get_object(created[i]->serial()),
+		            alive ? static_cast<Widelands::MapObject*>(created[i].get()) : nullptr);
+	}
+	check_equal(objects.all_object_serials_ordered().front(), created[2500]->serial());
+
+	objects.remove(*created[2500]);
+	for (int i = 4000; i < 5000; ++i) {
+		objects.remove(*created[i]);
+	}
+	check_equal(objects.size(), 0U);
+}
+
+TESTCASE(serials_ordered_by_creation) {
+	Widelands::ObjectManager objects;
+	std::vector<std::unique_ptr<TestObject>> created;
+	for (int i = 0; i < 4; ++i) {
+		created.push_back(std::make_unique<TestObject>());
+		objects.insert(created.back().get());
+	}
+	// Free the first slots and fill them again with newer objects.
+	objects.remove(*created[0]);
+	objects.remove(*created[1]);
+	for (int i = 0; i < 2; ++i) {
+		created.push_back(std::make_unique<TestObject>());
+		objects.insert(created.back().get());
+	}
+
+	const std::vector<Widelands::Serial> serials = objects.all_object_serials_ordered();
+	check_equal(serials.size(), 4U);
+	for (size_t i = 0; i < serials.size(); ++i) {
+		check_equal(serials[i], created[i + 2]->serial());
+	}
+	for (size_t i = 2; i < created.size(); ++i) {
+		objects.remove(*created[i]);
+	}
+}
+
+// A game that is saved and loaded again must order its objects in the same way
+// as the game that continued to run, because std::set<OPtr>, maps keyed by
+// Serial and several tie-breaks compare serials.
+TESTCASE(continued_and_reloaded_order_equal) {
+	Widelands::ObjectManager continued;
+	std::vector<std::unique_ptr<TestObject>> created;
+	for (int i = 0; i < 6; ++i) {
+		created.push_back(std::make_unique<TestObject>());
+		continued.insert(created.back().get());
+	}
+	continued.remove(*created[0]);
+	continued.remove(*created[3]);
+	for (int i = 0; i < 3; ++i) {
+		created.push_back(std::make_unique<TestObject>());
+		continued.insert(created.back().get());
+	}
+
+	// Loading a savegame creates the objects in the order in which they were saved
+	Widelands::ObjectManager reloaded;
+	std::vector<std::unique_ptr<TestObject>> loaded;
+	std::vector<Widelands::MapObject*> originals;
+	for (Widelands::Serial serial : continued.all_object_serials_ordered()) {
+		originals.push_back(continued.get_object(serial));
+		loaded.push_back(std::make_unique<TestObject>());
+		reloaded.insert(loaded.back().get());
+	}
+
+	// Both games continue with one more object
+	created.push_back(std::make_unique<TestObject>());
+	continued.insert(created.back().get());
+	originals.push_back(created.back().get());
+	loaded.push_back(std::make_unique<TestObject>());
+	reloaded.insert(loaded.back().get());
+
+	check_equal(originals.size(), loaded.size());
+	for (size_t i = 0; i < originals.size(); ++i) {
+		for (size_t j = 0; j < originals.size(); ++j) {
+			check_equal(originals[i]->serial() < originals[j]->serial(),
+			            loaded[i]->serial() < loaded[j]->serial());
+		}
+	}
+
+	for (Widelands::MapObject* object : originals) {
+		continued.remove(*object);
+	}
+	for (const auto& object : loaded) {
+		reloaded.remove(*object);
+	}
+}
+
+TESTSUITE_END()
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2024 by the Widelands Development Team
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+
+#include "base/test.h"
+#include "logic/pathfield.h"
+
+TESTSUITE_START(pathfield)
+
+TESTCASE(reused_pathfields_start_new_cycle) {
+	Widelands::PathfieldManager manager;
+	manager.set_size(16);
+	Widelands::Pathfields* first = nullptr;
+	uint16_t first_cycle = 0U;
+	{
+		std::shared_ptr<Widelands::Pathfields> pf = manager.allocate();
+		first = pf.get();
+		first_cycle = pf->cycle;
+		check_equal(pf->nrfields, 16U);
+	}
+	std::shared_ptr<Widelands::Pathfields> pf = manager.allocate();
+	check_equal(pf.get(), first);
+	check_equal(pf->cycle, static_cast<uint16_t>(first_cycle + 1));
+
+	// Nested searches get their own pathfields
+	std::shared_ptr<Widelands::Pathfields> nested = manager.allocate();
+	check_equal(nested.get() != first, true);
+}
+
+TESTCASE(window_grows) {
+	Widelands::PathfieldManager manager;
+	manager.set_size(1024);
+	{
+		std::shared_ptr<Widelands::Pathfields> pf = manager.allocate_window(9);
+		check_equal(pf->nrfields, 9U);
+	}
+	std::shared_ptr<Widelands::Pathfields> pf = manager.allocate_window(25);
+	check_equal(pf->nrfields, 25U);
+	check_equal(pf->cycle, static_cast<uint16_t>(1));
+	check_equal(pf->fields[24].cycle, static_cast<uint16_t>(0));
+}
+
+TESTCASE(open_list_reset) {
+	Widelands::PathfieldManager manager;
+	manager.set_size(4);
+	std::shared_ptr<Widelands::Pathfields> pf = manager.allocate();
+	pf->open.reset(Widelands::wwWARE);
+	pf->fields[0].real_cost = 3;
+	pf->fields[0].estim_cost = 0;
+	pf->fields[1].real_cost = 1;
+	pf->fields[1].estim_cost = 0;
+	pf->open.push(&pf->fields[0]);
+	pf->open.push(&pf->fields[1]);
+	check_equal(pf->open.top(), &pf->fields[1]);
+
+	pf->open.reset(Widelands::wwWORKER);
+	check_equal(pf->open.empty(), true);
+	check_equal(pf->open.type(), Widelands::wwWORKER);
+	check_equal(pf->fields[0].heap_cookie.is_active(), false);
+	check_equal(pf->fields[1].heap_cookie.is_active(), false);
+}
+
+TESTSUITE_END()
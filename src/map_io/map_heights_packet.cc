@@ -44,7 +44,7 @@ void MapHeightsPacket::read(FileSystem& fs,
 			   (packet_version < 2) ? kDefaultMaxFieldHeightDiff : fr.unsigned_8();
 			MapIndex const max_index = map.max_index();
 			for (MapIndex i = 0; i < max_index; ++i) {
-				map[i].set_height(fr.unsigned_8());
+				map.set_field_height(map[i], fr.unsigned_8());
 			}
 		} else {
 			throw UnhandledVersionError("MapHeightsPacket", packet_version, kCurrentPacketVersion);
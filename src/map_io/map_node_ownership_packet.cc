@@ -50,10 +50,10 @@ void MapNodeOwnershipPacket::read(FileSystem& fs,
 	try {
 		uint16_t const packet_version = fr.unsigned_16();
 		if (packet_version == kCurrentPacketVersion) {
-			const Map& map = egbase.map();
+			Map& map = *egbase.mutable_map();
 			MapIndex const max_index = map.max_index();
 			for (MapIndex i = 0; i < max_index; ++i) {
-				map[i].set_owned_by(fr.unsigned_8());
+				map.set_field_owner(map[i], fr.unsigned_8());
 			}
 		} else {
 			throw UnhandledVersionError(
@@ -117,6 +117,7 @@ void MapPlayersViewPacket::read(FileSystem& fs, EditorGameBase& egbase) {
 					} else if (saved_vision == SavedVisionState::kRevealed) {
 						f.vision.set_revealed(true);
 						assert(f.vision.is_revealed());
+						player->update_seeing_bit(m);
 					} else if (saved_vision == SavedVisionState::kHidden) {
 						f.vision.set_hidden(true);
 						assert(f.vision.is_hidden());
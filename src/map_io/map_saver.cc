@@ -24,6 +24,7 @@
 #include "base/multithreading.h"
 #include "base/scoped_timer.h"
 #include "base/wexception.h"
+#include "graphic/image_cache.h"
 #include "graphic/image_io.h"
 #include "graphic/minimap_renderer.h"
 #include "graphic/texture.h"
@@ -313,7 +314,10 @@ void MapSaver::save() {
 	}
 #endif
 
-	// Write minimap
+	// Write minimap. Without an OpenGL context, it can't be rendered.
+	if (g_image_cache != nullptr && g_image_cache->is_headless()) {
+		return;
+	}
 	set_progress_message(_("Minimap"), 22);
 	NoteThreadSafeFunction::instantiate(
 	   [this]() {
@@ -35,7 +35,7 @@ void MapTerrainPacket::read(FileSystem& fs, EditorGameBase& egbase) {
 	FileRead fr;
 	fr.open(fs, "binary/terrain");
 
-	const Map& map = egbase.map();
+	Map& map = *egbase.mutable_map();
 	try {
 		uint16_t const packet_version = fr.unsigned_16();
 		if (packet_version == 1) {
@@ -56,8 +56,8 @@ void MapTerrainPacket::read(FileSystem& fs, EditorGameBase& egbase) {
 			MapIndex const max_index = map.max_index();
 			for (MapIndex i = 0; i < max_index; ++i) {
 				Field& f = map[i];
-				f.set_terrain_r(smap[fr.unsigned_8()]);
-				f.set_terrain_d(smap[fr.unsigned_8()]);
+				map.set_field_terrain(f, TriangleIndex::R, smap[fr.unsigned_8()]);
+				map.set_field_terrain(f, TriangleIndex::D, smap[fr.unsigned_8()]);
 			}
 		} else if (packet_version == kCurrentPacketVersion) {
 			std::map<DescriptionIndex /* index in binary */, DescriptionIndex /* actual index */>
@@ -74,7 +74,7 @@ void MapTerrainPacket::read(FileSystem& fs, EditorGameBase& egbase) {
 					      .emplace(saved_index, egbase.mutable_descriptions()->load_terrain(fr.string()))
 					      .first;
 				}
-				f.set_terrain_r(lookup->second);
+				map.set_field_terrain(f, TriangleIndex::R, lookup->second);
 
 				saved_index = fr.unsigned_16();
 				lookup = mappings.find(saved_index);
@@ -84,7 +84,7 @@ void MapTerrainPacket::read(FileSystem& fs, EditorGameBase& egbase) {
 					      .emplace(saved_index, egbase.mutable_descriptions()->load_terrain(fr.string()))
 					      .first;
 				}
-				f.set_terrain_d(lookup->second);
+				map.set_field_terrain(f, TriangleIndex::D, lookup->second);
 			}
 		} else {
 			throw UnhandledVersionError("MapTerrainPacket", packet_version, kCurrentPacketVersion);
@@ -98,7 +98,7 @@ void MapTerrainPacket::write(FileSystem& fs, EditorGameBase& egbase) {
 	FileWrite fw;
 	fw.unsigned_16(kCurrentPacketVersion);
 
-	const Map& map = egbase.map();
+	Map& map = *egbase.mutable_map();
 	std::set<DescriptionIndex> written_terrains;
 	const MapIndex max_index = map.max_index();
 
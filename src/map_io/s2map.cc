@@ -490,7 +490,7 @@ void S2MapLoader::load_s2mf(Widelands::EditorGameBase& egbase) {
 	pc = section.get();
 	for (int16_t y = 0; y < mapheight; ++y) {
 		for (int16_t x = 0; x < mapwidth; ++x, ++f, ++pc) {
-			f->set_height(*pc);
+			map_.set_field_height(*f, *pc);
 		}
 	}
 
@@ -514,7 +514,8 @@ void S2MapLoader::load_s2mf(Widelands::EditorGameBase& egbase) {
 			if ((c & 0x40) != 0) {
 				port_spaces_to_set_.insert(Widelands::Coords(x, y));
 			}
-			f->set_terrain_d(terrain_converter.lookup(worldtype_, c & 0x1f));
+			map_.set_field_terrain(*f, Widelands::TriangleIndex::D,
+			                       terrain_converter.lookup(worldtype_, c & 0x1f));
 		}
 	}
 
@@ -534,7 +535,8 @@ void S2MapLoader::load_s2mf(Widelands::EditorGameBase& egbase) {
 			if ((c & 0x40) != 0) {
 				port_spaces_to_set_.insert(Widelands::Coords(x, y));
 			}
-			f->set_terrain_r(terrain_converter.lookup(worldtype_, c & 0x1f));
+			map_.set_field_terrain(*f, Widelands::TriangleIndex::R,
+			                       terrain_converter.lookup(worldtype_, c & 0x1f));
 		}
 	}
 
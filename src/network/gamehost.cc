@@ -316,6 +316,8 @@ struct GameHostImpl {
 	/// All currently running computer players, *NOT* in one-one correspondence
 	/// with \ref Player objects
 	std::vector<AI::ComputerPlayer*> computerplayers;
+	/// Whether the computer players think on several threads
+	bool concurrent_ai{false};
 
 	/// \c true if a syncreport is currently in flight
 	bool syncreport_pending{false};
@@ -545,6 +547,7 @@ void GameHost::run_callback() {
 	game_->logic_rand_seed(rng_seed);
 	game_->set_ai_training_mode(get_config_bool("ai_training", false));
 	game_->set_auto_speed(get_config_bool("auto_speed", false));
+	d->concurrent_ai = get_config_bool("concurrent_ai", false);
 	game_->set_write_syncstream(g_write_syncstreams);
 
 	if (capsule_ != nullptr) {
@@ -678,9 +681,7 @@ void GameHost::think() {
 			}
 		}
 
-		for (AI::ComputerPlayer* cp : d->computerplayers) {
-			cp->think();
-		}
+		AI::ComputerPlayer::think_all(d->computerplayers, d->concurrent_ai);
 	}
 }
 
@@ -471,7 +471,9 @@ static int L_play_sound(lua_State* L) {
 	const bool allow_multiple = nargs < 3 || luaL_checkboolean(L, 3);
 
 	if (nargs < 4 || lua_isnil(L, 4)) {
-		g_sh->play_fx(SoundType::kAmbient, fx, priority, allow_multiple);
+		if (g_sh != nullptr) {
+			g_sh->play_fx(SoundType::kAmbient, fx, priority, allow_multiple);
+		}
 	} else {
 		LuaMaps::LuaField* coords = *get_user_class<LuaMaps::LuaField>(L, 4);
 		Notifications::publish(
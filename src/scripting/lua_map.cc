@@ -8201,7 +8201,7 @@ int LuaField::set_raw_height(lua_State* L) {
 		report_error(L, "height must be <= %i", MAX_FIELD_HEIGHT);
 	}
 
-	f.field->set_height(height);
+	get_egbase(L).mutable_map()->set_field_height(*f.field, height);
 
 	return 0;
 }
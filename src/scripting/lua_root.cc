@@ -1299,6 +1299,7 @@ void LuaDescriptions::do_modify_productionsite(lua_State* L,
 			std::unique_ptr<LuaTable> tbl(new LuaTable(L));
 			psdescr.mutable_programs()[prog_name] = std::unique_ptr<Widelands::ProductionProgram>(
 			   new Widelands::ProductionProgram(prog_name, *tbl, descrs, &psdescr));
+			psdescr.resolve_program_calls();
 		} else {
 			report_error(
 			   L, "modify_unit - productionsite - programs: invalid command '%s'", cmd.c_str());
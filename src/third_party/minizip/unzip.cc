@@ -829,6 +829,25 @@ extern int32_t ZEXPORT unzOpenCurrentFile(unzFile file) {
 	return unzOpenCurrentFile3(file, nullptr, nullptr, 0, nullptr);
 }
 
+extern int32_t ZEXPORT unzGetCurrentFileDataOffset(unzFile file, uLong* const offset) {
+	uInt iSizeVar;
+	uLong offset_local_extrafield;
+	uInt size_local_extrafield;
+	if (not file or not offset)
+		return UNZ_PARAMERROR;
+	unz_s* const s = static_cast<unz_s*>(file);
+	if (!s->current_file_ok)
+		return UNZ_PARAMERROR;
+
+	if (unzlocal_CheckCurrentFileCoherencyHeader(
+	       s, &iSizeVar, &offset_local_extrafield, &size_local_extrafield) != UNZ_OK)
+		return UNZ_BADZIPFILE;
+
+	*offset = s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar +
+	          s->byte_before_the_zipfile;
+	return UNZ_OK;
+}
+
 /*
   Read bytes from the current file.
   buf contain buffer where data must be copied
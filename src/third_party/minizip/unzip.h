@@ -197,6 +197,14 @@ OF((unzFile file, int32_t* method, int32_t* level, int32_t raw, char const* pass
          but you CANNOT set method parameter as nullptr
 */
 
+extern int32_t ZEXPORT unzGetCurrentFileDataOffset OF((unzFile file, uLong* offset));
+/*
+  Get the position of the (possibly compressed) data of the current file,
+    counted in bytes from the start of the zip file. Reading the data directly
+    from there is only useful if it is not encrypted.
+  return UNZ_OK if there is no problem
+*/
+
 extern int32_t ZEXPORT unzCloseCurrentFile OF((unzFile file));
 /*
   Close the file in zip opened with unzOpenCurrentFile
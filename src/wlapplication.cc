@@ -59,6 +59,7 @@
 #include "io/filesystem/disk_filesystem.h"
 #include "io/filesystem/filesystem_exceptions.h"
 #include "io/filesystem/layered_filesystem.h"
+#include "io/filesystem/zip_filesystem.h"
 #include "logic/addons.h"
 #include "logic/filesystem_constants.h"
 #include "logic/game.h"
@@ -1200,6 +1201,7 @@ bool WLApplication::init_settings() {
 	handle_commandline_parameters();
 
 	set_mouse_swap(get_config_bool("swapmouse", false));
+	ZipFilesystem::set_compression_level(get_config_int("zip_compression_level", 9));
 
 	// Without this the config options get dropped by check_used().
 	for (const std::string& conf : get_all_parameters()) {
@@ -1635,6 +1637,8 @@ void WLApplication::handle_commandline_parameters() {
 
 	set_config_bool("auto_speed", check_commandline_flag("auto_speed"));
 
+	set_config_bool("concurrent_ai", check_commandline_flag("concurrent_ai"));
+
 	if (check_commandline_flag("enable_development_testing_tools")) {
 		g_allow_script_console = true;
 	}
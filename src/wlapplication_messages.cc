@@ -126,6 +126,10 @@ void fill_parameter_vector() {
 		_("Constantly adjust the game speed automatically depending on AI delay. "
 		  "Only to be used for AI testing or training (in conjunction with --ai_training)."),
 		true},
+	  {"", "concurrent_ai", "",
+		_("Let the computer players think on separate threads at the same time. This uses more "
+		  "processor cores in games with many computer players."),
+		true},
 	  /* This is deliberately so long to discourage overusage */
 	  {"", "enable_development_testing_tools", "", _("Enable the Script Console and Cheating Mode."),
 		true},
@@ -148,6 +152,11 @@ void fill_parameter_vector() {
 		true},
 	  {"", "nozip", "", _("Do not save files as binary zip archives."), false},
 	  {"", "zip", "", _("Save files as binary zip archives."), false},
+	  {"", "zip_compression_level", _("n"),
+		/** TRANSLATORS: `n` references a numerical placeholder */
+		_("Compress zip archives with level `n`, from 0 (fastest, largest files) to 9 (default, "
+		  "smallest files)."),
+		true},
 	  // The below comment is duplicated from above for the other case, when false is the default.
 	  /** TRANSLATORS: You may translate true/false, also as on/off or yes/no, but */
 	  /** TRANSLATORS: it HAS TO BE CONSISTENT with the translation in the widelands textdomain. */